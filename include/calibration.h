@@ -16,6 +16,10 @@
 #define NUMBER_OF_VOLTAGE_CAL_POINTS                            5
 #define NUMBER_OF_CURRENT_CAL_POINTS                            11
 #define MAX_NUMBER_OF_GAINS_AND_OFFSETS_FOR_AN_OUTPUT           NUMBER_OF_CURRENT_CAL_POINTS     
+#define NUMBER_OF_FREQUENCY_RESPONSE_POINTS                     13      //half decades, 0.1Hz to 100kHz
+#define FREQUENCY_RESPONSE_FIRST_POINT_HZ                       0.1f
+#define FREQUENCY_RESPONSE_POINTS_PER_DECADE                    2
+#define NUMBER_OF_INL_CORRECTION_POINTS                         33      //AD5791 INL at 32 equal segments of the 20-bit code space, -0x80000 to +0x80000
 
 
 
@@ -35,6 +39,8 @@ typedef struct
     const char *due_date;                   //TODO: define as writeable char array
     calibration_set_type current;
     calibration_set_type voltage;
+    float INL_corrections[NUMBER_OF_INL_CORRECTION_POINTS];     //DAC error at each point, in LSBs. Linear in between.
+    float frequency_response[NUMBER_OF_FREQUENCY_RESPONSE_POINTS];  //sine gain error left after the sinc droop correction, measured / setting - 1. Linear in log frequency in between.
     
 }calibration_data_type;
 
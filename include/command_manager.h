@@ -17,6 +17,7 @@
 #define COMMAND_MANAGER_H_
 
 #include "sam.h"
+#include "profiler.h"
 
 /**
  * @brief executes an incoming request to read a byte of the local EEPROM
@@ -51,6 +52,20 @@ uint8_t execute_ReadEEPROM_command(uint32_t address);
  */
 const char **execute_VersionInfo_command(void);
 
+/**
+ * @brief executes an incoming request to read one profiler probe's counters
+ * 
+ * this function is invoked by the LSCP local command and associated response message callback
+ * when a remote client (the android board) wants the timing of one of the profiled sections of code.
+ * 
+ * @param probe probe number, 0 to NUMBER_OF_PROFILE_PROBES - 1
+ * @param reset true = clear the probe's counters once they've been read
+ * @param probe_data where the counters are copied to. All zero for an unknown probe.
+ * 
+ * @return const char * probe name, "" for an unknown probe
+ */
+const char *execute_Profile_command(uint32_t probe, bool reset, profile_probe_data_type *probe_data);
+
 /**
  * @brief called by application when it wants to request the status from an input micro
  * 
@@ -22,6 +22,51 @@
 
 typedef enum{OUTSTG_SEL_BOTH, OUTSTG_SEL_LOW_VOLTAGE, OUTSTG_SEL_HIGH_VOLTAGE}output_stage_selection_type;
 
+#define OUTPUT_SAMPLING_RATE_MAX_SHIFT          5       //slowest adaptive sample rate is OUTPUT_SAMPLING_FREQUENCY >> 5 = 18.75kHz
+#define OUTPUT_MINIMUM_SAMPLES_PER_CYCLE        64      //a slower sample rate is only used while it still gives at least this many samples per output cycle
+//Board configuration: where the reconstruction filter's stopband starts, Hz. A slower sample rate can be used while its first
+//image, at fs - f, still lands in the stopband. 500kHz is all a 100kHz output at 600kHz relies on, so it's safe for any board.
+//Lower it once the filter's real stopband is known, so mid frequencies drop their rate too.
+#ifndef OUTPUT_FILTER_STOPBAND_FREQUENCY
+#define OUTPUT_FILTER_STOPBAND_FREQUENCY        500000.0f
+#endif
+#define OUTPUT_MINIMUM_IMAGE_REJECTION          1000.0f //...or while the zero-order hold alone holds the first image to 1/1000 (-60dBc) of the output, whatever the filter
+#define SYNC_IN_PROPORTIONAL_PERIODS            4.0f    //phase lock loop takes out 1/4 of the phase error per reference edge...
+#define SYNC_IN_INTEGRAL_PERIODS                64.0f   //...and 1/64 of it per edge goes into the frequency trim
+#define SYNC_IN_MAXIMUM_TRIM                    1e-3f   //the loop won't pull the frequency more than 1000ppm
+#define SYNC_IN_LOCK_WINDOW                     ((int32_t)(PERIOD_COUNTS / 3600))   //0.1 degree
+#define SYNC_IN_LOCK_EDGES                      16      //consecutive edges inside the lock window before reporting locked
+#define NUMBER_OF_DAC_CALIBRATION_POINTS        (NUMBER_OF_VOLTAGE_CAL_POINTS + NUMBER_OF_CURRENT_CAL_POINTS)    //voltage points, then current points
+#define DAC_CALIBRATION_GAIN_FRACTION_BITS      29      //Q29 gain, so calibration gains up to 4 fit
+#define DAC_CALIBRATION_MAXIMUM_GAIN            4.0f
+#define DAC_INL_SEGMENT_BITS                    5       //2^5 segments between the NUMBER_OF_INL_CORRECTION_POINTS
+#define DAC_INL_MAXIMUM_CORRECTION              8.0f    //LSBs. Well past the AD5791's INL, and keeps the segment interpolation in 32 bits.
+#define FREQUENCY_RESPONSE_MAXIMUM_RESIDUAL     0.5f    //CalData frequency response points are limited to +/-50%
+#define AMPLITUDE_COMPENSATION_UPDATE_THRESHOLD 1e-5f   //relative change in the frequency compensation worth regenerating the sine table for
+#define DC_RAMP_FRACTION_BITS                   11      //sub-LSB bits on DC ramp and dithered levels. A 20-bit code << 11 stays clear of int32 overflow.
+#define DC_RAMP_MAXIMUM_STEP                    (1 << 29)   //a quarter of full scale per sample, i.e. as good as a step
+#define FREQUENCY_SWEEP_PROGRESS_REPORT_TICKS   100     //waveform control timer ticks between sweep progress reports (10 per second)
+#define ARB_WAVEFORM_POINTS         SINE_TABLE_SIZE         //one user point per DDS table point
+//With DAC_BLOCK_STREAMING_ENABLED (HAL.h) the PDC sends the frames back to back, and only their DLYBCS padding keeps them one
+//sample period apart (see get_DAC_SPI_frame_idle_clocks()). The first DAC_STREAM_CADENCE_CHECK_BLOCKS blocks of every stream
+//are timed against the sample timer, and a mismatch is reported in SampleOverrunStatus. Streaming also does without:
+// - the adaptive sample rate. Every frequency runs at OUTPUT_SAMPLING_FREQUENCY, as DLYBCS can't pad out the slower periods.
+// - DC ramps and dithered DC levels. The slew rate and dither settings are ignored and a DC level is written straight away.
+// - sync out, which is driven from the sample ISR
+#define DAC_STREAM_BLOCK_SAMPLES    64          //samples per half of the DAC stream ping-pong buffer when DAC_BLOCK_STREAMING_ENABLED. At 600kHz, the SPI ISR fires every ~107uS instead of every 1.66uS.
+#define DAC_STREAM_CADENCE_CHECK_BLOCKS     8   //blocks timed at the start of each stream. Over 512 frames, up to 256 cycles of SPI ISR latency jitter rounds away.
+#define SAMPLE_OVERRUN_DETECTION_ENABLED    1   //1 = the sample ISR checks on entry that it's in time for its frame to make LDAC. Costs ~10 cycles a sample.
+
+//What the sample ISR (or the SPI ISR when streaming) has seen since the count was last cleared
+typedef struct
+{
+	uint32_t late_samples;                      //ISR started too late for its frame to be shifted out before LDAC, so the DAC repeated a sample
+	uint32_t overlapped_samples;                //the previous frame was still waiting on the PDC. When streaming, both halves of the buffer ran dry.
+	float worst_latency;                        //seconds, from the sample timer compare (or the end of a stream block) to the ISR starting
+	float latency_budget;                       //seconds, the latest the ISR can start at the present sample rate without being late
+	float stream_frame_error;                   //seconds each streamed frame ran over (+) or under (-) the sample period, timed as the stream last started. Always 0 unless streaming.
+}sample_overrun_status_type;
+
 //------------------------- General Output Control Function Prototypes ------------------------- 
 void initialize_output_control_parameters(void);
 
@@ -47,11 +92,88 @@ void init_AD5791_DAC(void);
  *  150mS to calculate a 4096 point DAC code table. However, using a const normalized sine wave table, it only would take 7mS to execute.
  *  Therefore, for the sake of responsiveness, as this function is inherently called every time the output frequency, amplitude, or offset
  *  is changed, it was decided to move forward with the const sine wave table.
+ *  
+ *  The table is now built by a fixed-point kernel from a Q31 normalized quarter sine table, with one scale and bias per call and
+ *  one multiply per four points, rather than a float multiply/divide per point. The parameters of the active table are also cached:
+ *  when only the offset changes on the same range, the new table is simply the active one plus a constant code delta.
  * 
  * \return void
  */
 void generate_DAC_code_table(float amplitude, float offset, float full_scale_divisor);
 
+/**
+ * \brief Starts a non-blocking DAC code table fill. Same parameters as generate_DAC_code_table().
+ * 
+ * The inactive half of the table is filled a slice at a time by service_DAC_code_table_generation() from the main loop,
+ * so a level change never holds off the LSCP packet handling or the watchdog for more than one slice. The ISR keeps
+ * playing the active half until the fill completes, then adopts the new table when the output next reaches the swap phase
+ * (see set_DAC_table_swap_phase()), so the level changes without a mid-cycle step. A new request abandons any fill already
+ * in progress.
+ * 
+ * With DDS_ON_THE_FLY_SCALING_ENABLED there's no table to fill: the new scale and offset are written for the sample path
+ * to apply from the next sample (next stream block when streaming), along with the shape, and the generation goes live
+ * straight away. The sample path looks the shape up itself, sine from the quarter table and ARB from the live ARB table.
+ * 
+ * \return uint32_t generation number of the requested table. get_live_DAC_table_generation() returns this once it's being output.
+ */
+uint32_t request_DAC_code_table_generation(float amplitude, float offset, float full_scale_divisor);
+
+/**
+ * \brief Writes the next DAC_TABLE_GENERATION_POINTS_PER_SLICE points of a requested table fill. When the fill completes,
+ * the swap to the new table is armed. Once the output has adopted it, settings manager is told via execute_DAC_code_table_update_complete_sequence().
+ * Does nothing if no fill is pending. Called every pass of the main loop.
+ * 
+ * \return void
+ */
+void service_DAC_code_table_generation(void);
+
+/**
+ * \brief Indicates if a requested DAC code table has yet to be adopted by the output.
+ * 
+ * \return bool true if a fill or its swap is in progress
+ */
+bool is_DAC_code_table_generation_pending(void);
+
+/**
+ * \brief Gets the generation number of the DAC code table presently being output.
+ * 
+ * \return uint32_t generation number, as returned by request_DAC_code_table_generation()
+ */
+uint32_t get_live_DAC_table_generation(void);
+
+/**
+ * \brief Sets the output phase at which a newly generated DAC code table is adopted. The default of 0 swaps tables
+ * as the phase accumulator wraps, i.e. at the sine's rising zero crossing.
+ * 
+ * \param phase_degrees phase point, 0 to 360
+ * 
+ * \return void
+ */
+void set_DAC_table_swap_phase(float phase_degrees);
+
+/**
+ * \brief Selects the calibration the DAC code tables and DC levels are generated with. The point's gain and offset from
+ * calibration_data are folded into an integer scale and bias the first time it's selected, and reused from then on
+ * until invalidate_DAC_calibration(). The output is gain * level + offset, in the range's units.
+ * 
+ * \param calibration_point 0 to NUMBER_OF_VOLTAGE_CAL_POINTS - 1 for voltage ranges, then the current ranges
+ * \param full_scale_divisor FS divisor of the range
+ * 
+ * \return void
+ */
+void select_DAC_calibration(uint32_t calibration_point, float full_scale_divisor);
+
+/**
+ * \brief Drops the cached calibration coefficients and reloads the INL correction curve. Call when the calibration data
+ * changes. Gain and offset take effect on the next select_DAC_calibration(), INL on the next table or DC level.
+ * 
+ * With any non zero INL point, every code the tables and DC levels produce is predistorted by the DAC's error at that code,
+ * interpolated between the points, so the DAC's output lands where the uncorrected code should have put it.
+ * 
+ * \return void
+ */
+void invalidate_DAC_calibration(void);
+
 /**
  * \brief Brings the DAC output to zero.
  * 
@@ -74,6 +196,36 @@ void bring_DAC_output_to_zero(output_shape_type output_shape);
  */
 void update_DAC_output_while_in_DC_mode(float desired_output_amplitude, float full_scale_divisor);
 
+/**
+ * \brief Sets how fast update_DAC_output_while_in_DC_mode() moves the output. With a slew rate set, the sample timer steps
+ * the DAC from the present level to the new one a sample at a time, and service_DC_ramp() reports when it gets there.
+ * Not available with DAC block streaming. bring_DAC_output_to_zero() always jumps straight to zero.
+ * 
+ * \param slew_rate V/s or A/s, in the units of the levels passed to update_DAC_output_while_in_DC_mode(). 0 = step straight to the new level.
+ * 
+ * \return void
+ */
+void set_DC_slew_rate(float slew_rate);
+
+/**
+ * \brief Turns on high resolution DC. Rather than writing one code and stopping, the sample timer keeps running and a second order
+ * noise shaper toggles the DAC between the codes either side of the level, so after the output filter the level can sit between codes,
+ * to 1/2^DC_RAMP_FRACTION_BITS of an LSB. Costs the ISR load of a running waveform. Takes effect on the next
+ * update_DAC_output_while_in_DC_mode(). Not available with DAC block streaming.
+ * 
+ * \return void
+ */
+void set_DC_dither_enabled(bool enable_dither);
+
+bool is_DC_ramp_running(void);
+
+/**
+ * \brief Sends the DC ramp complete notification once a ramp reaches its target. Call from the main loop.
+ * 
+ * \return void
+ */
+void service_DC_ramp(void);
+
 
 //------------------------- Output Stage Hardware Manipulation Function Prototypes ------------------------- 
 /**
@@ -211,16 +363,45 @@ void select_front_or_rear_output_terminals(terminal_selection_type terminal_sele
  * Phase increment eventually translates into the sine_table delta (i.e. how many indices to increment 
  * by with every firing of the ISR).
  * 
+ * The sample rate is picked along with it: the slowest of OUTPUT_SAMPLING_FREQUENCY >> 0..OUTPUT_SAMPLING_RATE_MAX_SHIFT
+ * that still gives OUTPUT_MINIMUM_SAMPLES_PER_CYCLE samples per cycle and keeps the first zero-order hold image, at fs - f,
+ * out of the output: either above OUTPUT_FILTER_STOPBAND_FREQUENCY, or OUTPUT_MINIMUM_IMAGE_REJECTION below the output
+ * without help from the reconstruction filter. With the default stopband that's the second test, so the rate drops below
+ * ~300Hz and reaches 18.75kHz below ~18Hz, and low frequencies don't cost the CPU load of 100kHz.
+ * A rate change is handed to the ISR, which retunes the timer and the increment together at a sample boundary. The phase
+ * accumulator is left alone, so there's no phase jump. Not used with DAC_BLOCK_STREAMING_ENABLED, whose frame padding
+ * can't stretch to the slower rates.
+ * 
+ * Sine amplitudes are corrected for the droop at the new frequency: the zero-order hold's sinc at the chosen sample rate,
+ * times the CalData frequency response in between. If that moves the correction, the sine table is regenerated and swapped
+ * in at the swap phase. Sweeps track it from service_frequency_sweep(), a table at a time.
+ * 
  * \param desired_output_frequency desired user output frequency
  * 
  * \return void
  */
 void set_output_frequency(float desired_output_frequency);
 
+/**
+ * \brief Gets the frequency the output actually produces for the last set_output_frequency(). The phase increment is rational
+ * (see rational_phase_increment_type), so this is the requested frequency exactly, as the float it was set with, held relative to
+ * the sample clock with no long term phase drift.
+ * 
+ * \return double achieved output frequency, Hz
+ */
+double get_achieved_output_frequency(void);
+
+/**
+ * \brief Gets the sample rate the output is presently running at
+ * 
+ * \return float sample rate, Hz
+ */
+float get_output_sampling_frequency(void);
+
 /**
  * \brief Executes sequence needed to update timers/firmware to output either AC or DC signal
  *  * 
- * \param desired_output_shape DC or SINE
+ * \param desired_output_shape DC, or one of the DDS shapes (sine, square, triangle, ramp, ARB)
  * \param amplitude user amplitude setting
  * \param offset user offset setting
  * \param full_scale_divisor full scale current or voltage range of active stage
@@ -229,4 +410,173 @@ void set_output_frequency(float desired_output_frequency);
  */
 void set_output_shape(output_shape_type desired_output_shape, float amplitude, float offset, float full_scale_divisor);
 
+/**
+ * \brief Copies user ARB waveform points into the ARB upload table. The live ARB table is left alone until the chunk
+ * ending at ARB_WAVEFORM_POINTS arrives, then the two are swapped, so a table generated mid upload still sees one whole waveform.
+ * The new waveform only reaches the output the next time a DAC code table is generated with the ARB shape. With
+ * DDS_ON_THE_FLY_SCALING_ENABLED the sample path reads the live table itself, so it goes out from the next sample.
+ * 
+ * \param first_point first ARB table point to write
+ * \param points normalized waveform points, Q15 (+/-32767 = +/-1)
+ * \param number_of_points points to write. Ignored if the write would run past ARB_WAVEFORM_POINTS.
+ * 
+ * \return void
+ */
+void load_ARB_waveform_points(uint32_t first_point, const int16_t *points, uint32_t number_of_points);
+
+//------------------------- Phase Function Prototypes ------------------------- 
+/**
+ * \brief Sets the output phase offset. The accumulator is stepped by the change in offset between two samples, so the output
+ * jumps straight to the new phase with no samples lost or repeated. Ignored by the output in burst mode, which starts each burst
+ * at the burst start phase. A phase lock holds lock phase + this offset at the reference edge.
+ * 
+ * \param phase_degrees 0 to 360
+ * \param reset_phase_on_frequency_change false = frequency changes are phase continuous,
+ * true = the output restarts at phase_degrees on the sample the new frequency takes effect
+ * 
+ * \return void
+ */
+void set_output_phase(float phase_degrees, bool reset_phase_on_frequency_change);
+
+float get_output_phase(void);
+
+//------------------------- Burst Function Prototypes ------------------------- 
+/**
+ * \brief Switches between continuous output and burst mode, without touching the output relays.
+ * 
+ * In burst mode the output parks at start_phase_degrees of the waveform, which is the level it holds between bursts.
+ * Each trigger then plays exactly cycles whole cycles from that phase and parks again. The cycle count is turned into
+ * an exact sample count from the rational phase increment, so the burst ends on the sample that completes the last cycle.
+ * A frequency change while a burst is playing takes effect on the next burst.
+ * 
+ * \param enable_burst_mode true = burst mode, false = continuous output (carries on from the present phase)
+ * \param cycles whole cycles per burst
+ * \param start_phase_degrees phase each burst starts at, and parks at
+ * \param trigger_source BURST_TRIGGER_EXTERNAL enables the trigger input. trigger_burst() works with either source.
+ * 
+ * \return void
+ */
+void set_burst_mode(bool enable_burst_mode, uint32_t cycles, float start_phase_degrees, burst_trigger_source_type trigger_source);
+
+/**
+ * \brief Starts a burst on the next sample. Ignored unless in burst mode and parked. Safe to call from an ISR.
+ * 
+ * \return void
+ */
+void trigger_burst(void);
+
+bool is_burst_running(void);
+
+//------------------------- Sync Function Prototypes ------------------------- 
+/**
+ * \brief Sets how the output follows a reference on the sync in (TIOA5) input, expected at the output frequency.
+ * 
+ * SYNC_IN_PHASE_LOCK trims the phase increment on every reference edge so the output's lock_phase_degrees point lines up with the
+ * reference's rising edge, and holds it there against the drift between the two clocks. SYNC_IN_RESET instead knocks the
+ * accumulator straight onto lock_phase_degrees at every edge: instant, but it steps the output if the clocks differ.
+ * 
+ * \param mode SYNC_IN_OFF, SYNC_IN_PHASE_LOCK or SYNC_IN_RESET
+ * \param lock_phase_degrees output phase to line up with the reference edge
+ * 
+ * \return void
+ */
+void set_sync_in_mode(sync_in_mode_type mode, float lock_phase_degrees);
+
+/**
+ * \brief Turns the sync out pulse on or off. It goes high for one sample period each time the phase accumulator wraps,
+ * one sample ahead of the matching point on the output. Only driven by the sample ISR, not in block streaming.
+ * 
+ * \return void
+ */
+void set_sync_out_enabled(bool enable_sync_out);
+
+bool is_sync_in_locked(void);
+
+/**
+ * \brief Gets the phase error measured at the last reference edge
+ * 
+ * \return float degrees, output relative to the reference
+ */
+float get_sync_in_phase_error(void);
+
+/**
+ * \brief Sends the SyncStatus notification when the phase lock is gained or lost. Call from the main loop.
+ * 
+ * \return void
+ */
+void service_sync_in(void);
+
+//------------------------- Sample Overrun Detection Function Prototypes ------------------------- 
+/**
+ * \brief Clears the overrun counts and the worst latency, and sets whether the next overrun raises a SampleOverrunStatus
+ * notification. Only the first overrun after this is notified, the rest are just counted, so a sample rate the ISR
+ * can't keep up with doesn't flood the link.
+ * 
+ * \param notify_enabled true = notify on the next overrun
+ * 
+ * \return void
+ */
+void set_sample_overrun_notify_enabled(bool notify_enabled);
+
+/**
+ * \brief Takes a consistent copy of the overrun counts and latencies
+ * 
+ * \param status destination for the copy
+ * 
+ * \return void
+ */
+void get_sample_overrun_status(sample_overrun_status_type *status);
+
+/**
+ * \brief Sends the SampleOverrunStatus notification once an overrun has been seen. Call from the main loop.
+ * 
+ * \return void
+ */
+void service_sample_overrun(void);
+
+//------------------------- Frequency Sweep Function Prototypes ------------------------- 
+/**
+ * \brief Starts a frequency sweep, stepped by the waveform control timer instead of the host sending one Frequency setting per step.
+ * 
+ * \param start_frequency first output frequency, Hz
+ * \param stop_frequency last output frequency, Hz. May be below start_frequency for a downward sweep.
+ * \param duration total sweep time, seconds
+ * \param law linear or logarithmic spacing of the steps
+ * \param number_of_steps number of equal (lin) or equal ratio (log) steps, each held for duration/number_of_steps.
+ *                        0 = continuous chirp, updated every WAVEFORM_CONTROL_TIMER_FREQUENCY tick.
+ * 
+ * \return void
+ */
+void start_frequency_sweep(float start_frequency, float stop_frequency, float duration, sweep_law_type law, uint32_t number_of_steps);
+
+/**
+ * \brief Aborts a running frequency sweep, leaving the output at whatever frequency it had reached.
+ * 
+ * \return void
+ */
+void stop_frequency_sweep(void);
+
+bool is_frequency_sweep_running(void);
+
+/**
+ * \brief Gets how far the present (or last) sweep has got.
+ * 
+ * \return float 0.0 to 1.0
+ */
+float get_frequency_sweep_progress(void);
+
+/**
+ * \brief Gets the frequency the output is presently at, as worked out from the phase increment.
+ * 
+ * \return float frequency, Hz
+ */
+float get_frequency_sweep_present_frequency(void);
+
+/**
+ * \brief Hands sweep progress and completion over to settings manager for reporting to the android. Called every pass of the main loop.
+ * 
+ * \return void
+ */
+void service_frequency_sweep(void);
+
 #endif /* OUTPUT_CONTROL_H_ */
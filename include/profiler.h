@@ -0,0 +1,102 @@
+/** @file profiler.h
+ *  @brief interface definition for the cycle counting profiler
+ *
+ *  Named probes time sections of code with the Cortex-M4 DWT cycle counter. Each probe keeps a count, min, max and total
+ *  of the cycles its section took, plus a log2 histogram, so an ISR's worst case and its spread can be read back over
+ *  LSCP (see the Profile command) rather than caught on a scope.
+ *
+ *  Probes are placed with PROFILE_BEGIN() and PROFILE_END(), or PROFILE_END_IF() where the same code also runs from a
+ *  context whose passes shouldn't be recorded. With PROFILER_ENABLED at 0 they compile to nothing.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "sam.h"
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED                0       //1 = probes time their sections. The sample ISR probe alone costs ~30 cycles a sample, so leave at 0 for release.
+#endif
+#define PROFILE_HISTOGRAM_BINS          24      //bin n counts sections that took 2^n to 2^(n+1) - 1 cycles. The last bin also takes everything longer.
+
+typedef enum
+{
+	PROFILE_PROBE_SAMPLE_ISR = 0,               //OUTPUT_UPDATE_TIMER_ISR
+	PROFILE_PROBE_STREAM_BLOCK_ISR,             //SPI_ISR, one DAC stream block refill
+	PROFILE_PROBE_SYNC_IN_ISR,                  //SYNC_IN_CAPTURE_ISR
+	PROFILE_PROBE_SWEEP_ISR,                    //WAVEFORM_CONTROL_TIMER_ISR
+	PROFILE_PROBE_DAC_TABLE_GENERATION,         //generate_DAC_code_table(), a whole blocking table fill
+	PROFILE_PROBE_LSCP_PROCESSING,              //one pass of the LSCP packet reception state machine
+	PROFILE_PROBE_RANGE_CHANGE,                 //voltage or current range change, relays and all
+	PROFILE_PROBE_OUTPUT_ENABLE,                //execute_enable_output_sequence()
+	NUMBER_OF_PROFILE_PROBES
+}profile_probe_type;
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t minimum_cycles;
+	uint32_t maximum_cycles;
+	uint64_t total_cycles;
+	uint32_t histogram[PROFILE_HISTOGRAM_BINS];
+}profile_probe_data_type;
+
+#if PROFILER_ENABLED
+#define PROFILE_BEGIN(probe)    uint32_t profile_start_cycles_##probe = get_profile_cycle_count()
+#define PROFILE_END(probe)      record_profile_sample(probe, get_profile_cycle_count() - profile_start_cycles_##probe)
+#define PROFILE_END_IF(probe, is_recorded)  do { if(is_recorded) { PROFILE_END(probe); } } while(0)
+#else
+#define PROFILE_BEGIN(probe)
+#define PROFILE_END(probe)
+#define PROFILE_END_IF(probe, is_recorded)
+#endif
+
+/**
+ * \brief Starts the DWT cycle counter and clears every probe. Called once at start up.
+ *
+ * \return void
+ */
+void init_profiler(void);
+
+/**
+ * \brief Gets the DWT cycle count. Use PROFILE_BEGIN() and PROFILE_END() rather than calling this directly.
+ *
+ * \return uint32_t core clock cycles, wraps every ~36s at 120MHz
+ */
+uint32_t get_profile_cycle_count(void);
+
+/**
+ * \brief Adds one timed section to a probe. Safe from any interrupt priority, as long as each probe is only ever
+ * recorded from one context.
+ *
+ * \param probe which probe
+ * \param cycles core clock cycles the section took, including the probe's own overhead, which is taken off here
+ *
+ * \return void
+ */
+void record_profile_sample(profile_probe_type probe, uint32_t cycles);
+
+/**
+ * \brief Takes a consistent copy of one probe's counters, optionally clearing them as it does.
+ *
+ * \param probe which probe
+ * \param probe_data destination for the copy
+ * \param reset true = start the probe over once it's copied
+ *
+ * \return void
+ */
+void get_profile_probe_data(profile_probe_type probe, profile_probe_data_type *probe_data, bool reset);
+
+/**
+ * \brief Gets a probe's name, as reported over LSCP.
+ *
+ * \param probe which probe
+ *
+ * \return const char* name, e.g. "SampleIsr"
+ */
+const char *get_profile_probe_name(profile_probe_type probe);
+
+#endif /* PROFILER_H_ */
@@ -30,7 +30,10 @@
 typedef enum {VRANGE_10mV = 1, VRANGE_100mV, VRANGE_1V, VRANGE_10V, VRANGE_100V} voltage_range_type;
 typedef enum {IRANGE_1uA = 1, IRANGE_10uA, IRANGE_100uA, IRANGE_1mA, IRANGE_10mA, IRANGE_100mA, IRANGE_HV_AC_BYPASS} current_range_type;
 typedef enum {VOLTAGE_MODE = 0, CURRENT_MODE} output_mode_type;
-typedef enum {SHAPE_DC = 0, SHAPE_SINE} output_shape_type;
+typedef enum {SHAPE_DC = 0, SHAPE_SINE, SHAPE_SQUARE, SHAPE_TRIANGLE, SHAPE_RAMP, SHAPE_ARB} output_shape_type;
+typedef enum {SWEEP_LAW_LINEAR = 0, SWEEP_LAW_LOGARITHMIC} sweep_law_type;
+typedef enum {BURST_TRIGGER_SOFTWARE = 0, BURST_TRIGGER_EXTERNAL} burst_trigger_source_type;
+typedef enum {SYNC_IN_OFF = 0, SYNC_IN_PHASE_LOCK, SYNC_IN_RESET} sync_in_mode_type;
 typedef enum {I_COMPLIANCE_10V = 1, I_COMPLIANCE_100V} current_compliance_range_type;
 typedef enum {TERMINALS_FRONT = 0, TERMINALS_REAR} terminal_selection_type;
 
@@ -40,6 +43,43 @@ typedef struct
     float offset;    
 }output_level_type;
 
+typedef struct
+{
+    float voltage;                  //V/s in voltage mode, 0 = DC level changes step straight to the new level
+    float current;                  //A/s in current mode
+}DC_slew_rate_type;
+
+typedef struct
+{
+    float start_frequency;
+    float stop_frequency;
+    float duration;                 //seconds
+    sweep_law_type law;
+    uint32_t steps;                 //0 = continuous chirp
+    bool enabled;                   //true while the sweep is running
+}frequency_sweep_type;
+
+typedef struct
+{
+    float phase;                    //degrees
+    bool reset_on_frequency_change; //false = phase continuous frequency changes
+}phase_type;
+
+typedef struct
+{
+    bool enabled;                   //false = continuous output
+    uint32_t cycles;                //whole cycles per burst
+    float start_phase;              //degrees. Bursts start here and the output parks here between them.
+    burst_trigger_source_type trigger_source;
+}burst_type;
+
+typedef struct
+{
+    sync_in_mode_type sync_in_mode;
+    float lock_phase;               //degrees. Output phase lined up with the reference's rising edge.
+    bool sync_out_enabled;
+}sync_type;
+
 typedef struct
 {
     const char *model_number;		// Human readable string for displaying the instrument model number
@@ -55,11 +95,18 @@ typedef struct
     bool output_state_enabled;
     bool calibration_locked;
     float output_frequency;
+    phase_type phase;
+    frequency_sweep_type frequency_sweep;
+    burst_type burst;
+    sync_type sync;
     output_shape_type output_shape;
     voltage_range_type voltage_range;
     bool voltage_autorange_enabled;
     output_level_type output_voltage_level;
     output_level_type output_current_level;
+    DC_slew_rate_type DC_slew_rate;
+    bool DC_high_resolution_enabled;
+    bool sample_overrun_notify_enabled;
     current_range_type current_range;
     bool current_autorange_enabled;
     current_compliance_range_type current_compliance_range;
@@ -86,6 +133,9 @@ void execute_disable_output_sequence(void);
 void execute_enable_output_sequence(void);
 float get_full_scale_voltage_range_value(voltage_range_type voltage_range);
 float get_full_scale_current_range_value(current_range_type current_range);
+void execute_DAC_code_table_update_complete_sequence(void);
+void execute_trigger_command(void);
+void execute_DAC_calibration_selection_sequence(void);
 
 //------------------------- mode setting function prototypes ------------------------- 
 void set_mode_setting(output_mode_type validated_mode, setting_android_notify_type notify_android);
@@ -113,11 +163,90 @@ bool validate_frequency_setting(float pending_frequency);
 void set_frequency_setting(float validated_frequency, setting_android_notify_type notify_android);
 float get_working_frequency_setting(void);
 
+//------------------------- phase setting function prototypes ------------------------- 
+/**
+ * @brief validates the requested phase setting from the remote interface
+ * 
+ * @param pending_phase the desired phase setting
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_phase_setting(phase_type pending_phase);
+void set_phase_setting(phase_type validated_phase, setting_android_notify_type notify_android);
+phase_type get_working_phase_setting(void);
+
+//------------------------- frequency sweep setting function prototypes ------------------------- 
+#define MINIMUM_FREQUENCY_SWEEP_DURATION_IN_S   0.010       //10 ticks of the waveform control timer
+#define MAXIMUM_FREQUENCY_SWEEP_DURATION_IN_S   86400.0     //a day
+/**
+ * @brief validates the requested frequency sweep setting from the remote interface. Start and stop must both be valid
+ * frequency settings, but either can be the larger one.
+ * 
+ * @param pending_frequency_sweep the desired frequency sweep
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_frequency_sweep_setting(frequency_sweep_type pending_frequency_sweep);
+void set_frequency_sweep_setting(frequency_sweep_type validated_frequency_sweep, setting_android_notify_type notify_android);
+frequency_sweep_type get_working_frequency_sweep_setting(void);
+void execute_frequency_sweep_progress_sequence(void);
+void execute_frequency_sweep_complete_sequence(void);
+
+//------------------------- burst setting function prototypes ------------------------- 
+#define MAXIMUM_BURST_CYCLES            10000       //keeps the burst sample count inside 32 bits at the slowest frequency and sample rate
+/**
+ * @brief validates the requested burst setting from the remote interface
+ * 
+ * @param pending_burst the desired burst setting
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_burst_setting(burst_type pending_burst);
+void set_burst_setting(burst_type validated_burst, setting_android_notify_type notify_android);
+burst_type get_working_burst_setting(void);
+
+//------------------------- sync setting function prototypes ------------------------- 
+/**
+ * @brief validates the requested sync in/out setting from the remote interface
+ * 
+ * @param pending_sync the desired sync setting
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_sync_setting(sync_type pending_sync);
+void set_sync_setting(sync_type validated_sync, setting_android_notify_type notify_android);
+sync_type get_working_sync_setting(void);
+void execute_sync_lock_change_sequence(void);
+
 //------------------------- shape setting function prototypes ------------------------- 
+/**
+ * @brief validates the requested shape setting from the remote interface. ARB is only valid once a complete ARB waveform has been loaded.
+ * 
+ * @param pending_shape the desired output shape
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_shape_setting(int32_t pending_shape);
 void execute_output_shape_change_sequence(void);
 void set_shape_setting(output_shape_type validated_shape, setting_android_notify_type notify_android);
 output_shape_type get_working_shape_setting(void);
 
+//------------------------- ARB data setting function prototypes ------------------------- 
+#define ARB_DATA_MAX_POINTS_PER_CHUNK           128         //points per ArbData setting message. Keeps each LSCP packet to a couple KB of JSON.
+/**
+ * @brief validates an incoming chunk of ARB waveform points. Chunks must arrive in order, starting at point 0.
+ * A chunk starting at point 0 always restarts the upload.
+ * 
+ * @param first_point waveform point the chunk starts at
+ * @param number_of_points points in the chunk
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_ARB_data_setting(uint32_t first_point, uint32_t number_of_points);
+void set_ARB_data_setting(uint32_t first_point, const int16_t *points, uint32_t number_of_points, setting_android_notify_type notify_android);
+uint32_t get_ARB_data_points_loaded(void);
+bool is_ARB_data_loaded(void);
+
 //------------------------- voltage range setting function prototypes ------------------------- 
 void set_voltage_range_setting(voltage_range_type validated_voltage_range, setting_android_notify_type notify_android);
 voltage_range_type get_working_voltage_range_setting(void);
@@ -162,6 +291,30 @@ bool validate_current_level_setting(output_level_type pending_current_level);
 void set_current_level_setting(output_level_type validated_current_level, setting_android_notify_type notify_android);
 output_level_type get_working_current_level_setting(void);
 
+//------------------------- DC slew rate setting function prototypes ------------------------- 
+#define MAXIMUM_DC_VOLTAGE_SLEW_RATE            1000000.0   //V/s. Faster than the output stages can follow anyway.
+#define MAXIMUM_DC_CURRENT_SLEW_RATE            1000.0      //A/s
+/**
+ * @brief validates the requested DC slew rate setting from the remote interface
+ * 
+ * @param pending_DC_slew_rate the desired voltage and current mode slew rates
+ * 
+ * @return bool false = validation failed, true = validation passed
+ */
+bool validate_DC_slew_rate_setting(DC_slew_rate_type pending_DC_slew_rate);
+void set_DC_slew_rate_setting(DC_slew_rate_type validated_DC_slew_rate, setting_android_notify_type notify_android);
+DC_slew_rate_type get_working_DC_slew_rate_setting(void);
+void execute_DC_ramp_complete_sequence(void);
+
+//------------------------- DC high resolution enabled setting function prototypes ------------------------- 
+void set_DC_high_resolution_enabled_setting(bool DC_high_resolution_enabled, setting_android_notify_type notify_android);
+bool is_DC_high_resolution_enabled(void);
+
+//------------------------- sample overrun setting function prototypes ------------------------- 
+void set_sample_overrun_notify_enabled_setting(bool sample_overrun_notify_enabled, setting_android_notify_type notify_android);
+bool is_sample_overrun_notify_enabled(void);
+void execute_sample_overrun_sequence(void);
+
 //------------------------- current range setting function prototypes ------------------------- 
 /**
  * @brief validates the requested current range from the remote interface
@@ -11,11 +11,27 @@
 #ifndef SINE_WAVE_H_
 #define SINE_WAVE_H_
 
-#define SINE_TABLE_BITS 12				//2^SINE_TABLE_BITS = the number of 32-bit floating point values that comprise the normalized sine wave table (SINE_TABLE_SIZE)	
+#include <stdint.h>
+
+//The engine configuration below can be overridden from the compiler command line (-D), e.g. to benchmark it on the host.
+#ifndef SINE_TABLE_BITS
+#define SINE_TABLE_BITS 12				//2^SINE_TABLE_BITS = the number of points in one full period of the normalized sine wave (SINE_TABLE_SIZE). Only a quarter of them are stored.
+										//Raising this requires regenerating quarter_sine_table with sine_table_generator.m.
+#endif
+#ifndef SINE_TABLE_OVERSIZE_BITS
 #define SINE_TABLE_OVERSIZE_BITS 16		//These upper 16-bits of the accumulator are used to determine which point, at a particular instance in time of the timer ISR firing, will be fetched from the sine table.
 										//Because the sampling frequency is fixed, the time delay required to reach a given table index is controlled by the resolution of the accumulator.
+#endif
+#ifndef DDS_LINEAR_INTERPOLATION_ENABLED
+#define DDS_LINEAR_INTERPOLATION_ENABLED 0	//1 = blend adjacent table points using the accumulator bits below TABLE_INDEX, 0 = nearest point lookup (phase truncation)
+#endif
+#ifndef DDS_ON_THE_FLY_SCALING_ENABLED
+#define DDS_ON_THE_FLY_SCALING_ENABLED 0	//1 = the sample path scales the normalized Q31 waveform by the amplitude and offset every sample, so level changes go out on the next sample
+										//and the double buffered DAC code tables aren't needed (no INL predistortion though), 0 = play pre-scaled DAC code tables
+#endif
 
 #define SINE_TABLE_SIZE (1 << SINE_TABLE_BITS)
+#define SINE_QUARTER_TABLE_SIZE (SINE_TABLE_SIZE >> 2)										//the number of 32-bit floating point values actually stored (first quadrant only)
 #define PERIOD_COUNTS (1 << (SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS))			//the total number of counts representing 1 full cycle of the normalized sine table
 
 /**
@@ -27,16 +43,74 @@
  */
 #define TABLE_INDEX(accumulator) (((accumulator) >> SINE_TABLE_OVERSIZE_BITS) & (SINE_TABLE_SIZE - 1))
 
-extern const float sine_table[SINE_TABLE_SIZE];
+/**
+ * @brief Computes the fractional position between TABLE_INDEX and the next table point from the accumulator bits
+ * that TABLE_INDEX throws away. Returned as Q15 so it fits the signed bottom halfword of the M4 SMLAWB instruction.
+ * 
+ * @param accumulator Oversized phase accumulator
+ * 
+ * @return unsigned int Fraction from 0 (on TABLE_INDEX) to 0x7FFF (just short of the next point)
+ */
+#define TABLE_FRACTION_Q15(accumulator) (((accumulator) >> (SINE_TABLE_OVERSIZE_BITS - 15)) & 0x7FFF)
+
+extern const float quarter_sine_table[SINE_QUARTER_TABLE_SIZE];
+
+/**
+ * @brief Looks up one point of the full normalized sine period from the quarter-wave table.
+ * The table points sit at half-index offsets (index + 0.5), so the 2nd and 4th quadrants are an exact mirror of the
+ * 1st and the 3rd and 4th quadrants are its negation.
+ * 
+ * @param index Full period table index as produced by TABLE_INDEX (0 to SINE_TABLE_SIZE - 1)
+ * 
+ * @return float Normalized sine value at that index
+ */
+static inline float get_sine_table_value(unsigned int index)
+{
+	unsigned int quadrant = (index >> (SINE_TABLE_BITS - 2)) & 0x3;
+	unsigned int quarter_index = index & (SINE_QUARTER_TABLE_SIZE - 1);
+	
+	if(quadrant & 0x1)
+	{
+		quarter_index = (SINE_QUARTER_TABLE_SIZE - 1) - quarter_index;				//falling half of each lobe is the rising half played backwards
+	}
+	
+	return ((quadrant & 0x2) ? -quarter_sine_table[quarter_index] : quarter_sine_table[quarter_index]);
+}
+
+/**
+ * @brief A phase increment of integer + remainder/modulus accumulator counts per sample. The accumulator takes the integer part
+ * every sample, and a separate fraction counter carries the remainder, adding one count whenever it reaches the modulus.
+ * Over modulus samples the accumulator then advances by exactly integer*modulus + remainder counts, without drift.
+ */
+typedef struct
+{
+	unsigned int integer;
+	uint32_t remainder;
+	uint32_t modulus;					//always >= 1. remainder < modulus.
+}rational_phase_increment_type;
+
+/**
+ * @brief Determines the rational phase increment that produces the desired frequency exactly, as a ratio of the sampling
+ * frequency. Both are floats, i.e. an odd integer times a power of 2, so PERIOD_COUNTS * frequency / sampling_frequency is
+ * taken as the ratio of those integers, with no rounding. The modulus is the sampling frequency's odd part, times whatever
+ * power of 2 the ratio still needs, e.g. 9375 * 2^5 for 0.1Hz at 600kHz. Should that ever pass 32 bits, the frequency's
+ * low mantissa bits are rounded off until it fits, which is still far inside a float's own precision.
+ * 
+ * @param frequency The desired frequency of the output sine wave, > 0
+ * @param sampling_frequency The frequency with which the phase accumulator is updated with this increment, > 0
+ * 
+ * @return rational_phase_increment_type Phase increment
+ */
+rational_phase_increment_type get_rational_phase_increment(float frequency, float sampling_frequency);
 
 /**
- * @brief Determines the phase increment required to move through the sine table at the desired output frequency.
+ * @brief Works out the frequency a rational phase increment actually produces
  * 
- * @param frequency The desired frequency of the output sine wave
+ * @param phase_increment Phase increment
  * @param sampling_frequency The frequency with which the phase accumulator is updated with this increment
  * 
- * @return unsigned int Phase increment The increment count value used to traverse through the sine table from sample to sample
+ * @return double Output frequency, Hz
  */
-unsigned int get_phase_increment(float frequency, float sampling_frequency);
+double get_rational_phase_increment_frequency(rational_phase_increment_type phase_increment, float sampling_frequency);
 
 #endif // Guard block
\ No newline at end of file
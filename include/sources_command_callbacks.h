@@ -19,7 +19,7 @@
 
 extern const command_message_callback_keys_type command_callback_keys[];
 
-#define NUM_COMMAND_KEYS		10		//the number of unique commands, remote and local, this application implements
+#define NUM_COMMAND_KEYS		12		//the number of unique commands, remote and local, this application implements
 
 //#defines for Command String Names used throughout the application code
 //The "COMMAND_STRING" prefix is used so they will show up grouped in the auto-complete dropdown
@@ -33,6 +33,8 @@ extern const command_message_callback_keys_type command_callback_keys[];
 #define COMMAND_STRING_READMEM              "ReadMem"
 #define COMMAND_STRING_SETTINGS_POWERON     "SettingsPowerOn"
 #define COMMAND_QUERY_INSTRUMENT_INFO		"QueryInstrumentInfo"
+#define COMMAND_STRING_TRIGGER              "Trigger"
+#define COMMAND_STRING_PROFILE              "Profile"
 
 /*
  *The following are function prototypes needed by the application to specifically handle remote command responses.
@@ -22,7 +22,7 @@ cJSON* generate_data_field_for_info_setting_msg_cb(void);			//needed by queryinf
 
 extern const setting_message_callback_keys_type setting_callback_keys[];	
 
-#define NUM_SETTING_KEYS		18			//the number of unique settings, remote and local, this application implements
+#define NUM_SETTING_KEYS		30			//the number of unique settings, remote and local, this application implements
 
 //#defines for Setting String Names used throughout the application code
 //The "SETTING_STRING" prefix used so they will show up grouped in the auto-complete dropdown
@@ -30,11 +30,22 @@ extern const setting_message_callback_keys_type setting_callback_keys[];
 #define SETTING_STRING_OUTPUT_STATE                 "OutputState"
 #define SETTING_STRING_CALLOCKED                    "CalLocked"
 #define SETTING_STRING_FREQUENCY			        "Frequency"
+#define SETTING_STRING_PHASE                        "Phase"
+#define SETTING_STRING_FREQUENCY_SWEEP              "FrequencySweep"
+#define SETTING_STRING_FREQUENCY_SWEEP_STATUS       "FrequencySweepStatus"
+#define SETTING_STRING_BURST                        "Burst"
+#define SETTING_STRING_SYNC                         "Sync"
+#define SETTING_STRING_SYNC_STATUS                  "SyncStatus"
 #define SETTING_STRING_SHAPE                        "Shape"
 #define SETTING_STRING_VOLTAGE_RANGE		        "VoltageRange"
 #define SETTING_STRING_VOLTAGE_AUTORANGE_ENABLED    "VoltageAutorangeEnabled"
 #define SETTING_STRING_VOLTAGE_OUTPUT_LEVEL         "VoltageOutputLevel"
 #define SETTING_STRING_CURRENT_OUTPUT_LEVEL		    "CurrentOutputLevel"
+#define SETTING_STRING_DC_SLEW_RATE                 "DCSlewRate"
+#define SETTING_STRING_DC_RAMP_STATUS               "DCRampStatus"
+#define SETTING_STRING_DC_HIGH_RESOLUTION_ENABLED   "DCHighResolutionEnabled"
+#define SETTING_STRING_SAMPLE_OVERRUN_NOTIFY_ENABLED "SampleOverrunNotifyEnabled"
+#define SETTING_STRING_SAMPLE_OVERRUN_STATUS        "SampleOverrunStatus"
 #define SETTING_STRING_CURRENT_RANGE		        "CurrentRange"
 #define SETTING_STRING_CURRENT_AUTORANGE_ENABLED    "CurrentAutoRangeEnabled"
 #define SETTING_STRING_CURRENT_COMPLIANCE_RANGE     "CurrentComplianceRange"
@@ -44,6 +55,7 @@ extern const setting_message_callback_keys_type setting_callback_keys[];
 #define SETTING_STRING_INFO                         "Info"
 #define SETTING_INPUT_READINGS                      "InputReadings"     //TODO: Remove. This is being implemented to run a throughput/timing/execution test
 #define SETTING_STRING_CALDATA                      "CalData"
+#define SETTING_STRING_ARB_DATA                     "ArbData"
 
 
 #endif /* SOURCES_SETTINGS_CALLBACKS_H_ */
\ No newline at end of file
@@ -34,18 +34,39 @@ void init_timers() {
                                 TC_CMR_ACPA_CLEAR;                      // Waveform mode with reset on register C, register C sets output, register A clears output
     TC1->TC_CHANNEL[0].TC_EMR = TC_EMR_NODIVCLK;                        // Use peripheral clock with no divisor
     UPDATE_SAMPLE_TIMER_FREQUENCY(OUTPUT_SAMPLING_FREQUENCY);           // Set sampling frequency. The frequency represents the rate the DAC is updated with a new output waveform value.
-    UPDATE_SAMPLE_TIMER_DUTY(OUTPUT_SAMPLING_FREQUENCY, 0.98);          // Set duty cycle. Used to determine the amount of time LDAC line is low. Example: 600kHz sample f with 98% dty cycle = LDAC low for ~33.33nS.
+    UPDATE_SAMPLE_TIMER_DUTY(OUTPUT_SAMPLING_FREQUENCY, OUTPUT_SAMPLING_LDAC_DUTY);   // Set duty cycle. Used to determine the amount of time LDAC line is low. Example: 600kHz sample f with 98% dty cycle = LDAC low for ~33.33nS.
     NVIC_EnableIRQ(TC3_IRQn);                                           // Enable the corresponding interrupt line in NVIC
     NVIC_SetPriority(TC3_IRQn, 0);                                      // Set priority of interrupt
     DISABLE_TIMER_INTERRUPT();                                          // Disable Interrupt on RC compare until needed by AC mode
     DISABLE_TIMER_CLOCK();                                              // Keep clock disabled until needed for DC mode
+    
+    TC1->TC_CHANNEL[1].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK4 |
+                                TC_CMR_WAVSEL_UP_RC |
+                                TC_CMR_WAVE;                            // Waveform control tick. Waveform mode with reset on register C, no output pins used.
+    TC1->TC_CHANNEL[1].TC_RC = TC_RC_RC((uint32_t)(SystemCoreClock/(WAVEFORM_CONTROL_TIMER_PRESCALER*WAVEFORM_CONTROL_TIMER_FREQUENCY)));
+    TC1->TC_CHANNEL[1].TC_IER = TC_IER_CPCS;
+    NVIC_EnableIRQ(TC4_IRQn);
+    NVIC_SetPriority(TC4_IRQn, 2);                                      // Below the sample ISR, which must never be held off
+    STOP_WAVEFORM_CONTROL_TIMER();                                      // Only runs while something (e.g. a frequency sweep) needs it
+    
+    TC1->TC_CHANNEL[2].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 |
+                                TC_CMR_LDRA_RISING;                     // Sync in. Capture mode, free running 16 bits, RA loaded on the reference's rising edge.
+    NVIC_EnableIRQ(TC5_IRQn);
+    NVIC_SetPriority(TC5_IRQn, 1);                                      // Below the sample ISR, above the waveform control tick
+    STOP_SYNC_IN_CAPTURE();                                             // Only runs while sync in is on
 }
 
 void init_SPI() {
     // Hall SPI
     SPI->SPI_CR = SPI_CR_SPIEN;                                   // Enable SPI Module
+#if DAC_BLOCK_STREAMING_ENABLED
+    SPI->SPI_MR = SPI_MR_MODFDIS | SPI_MR_MSTR | SPI_MR_PS |      // Select master mode, variable peripheral select so each PDC word carries its own chip select and LASTXFER.
+                  SPI_MR_DLYBCS(get_DAC_SPI_frame_idle_clocks(OUTPUT_SAMPLING_FREQUENCY));   // SYNC high time pads every frame out to exactly one sample period
+#else
     SPI->SPI_MR = SPI_MR_MODFDIS | SPI_MR_MSTR | SPI_MR_PCS(0);   // Select master mode, use configuration from chip select 0.
-    SPI->SPI_CSR[0] = SPI_CSR_BITS_8_BIT;                         // Capture on rising edges, 8 bits
+#endif
+    SPI->SPI_CSR[0] = SPI_CSR_BITS_8_BIT | SPI_CSR_DLYBS(DAC_SPI_CS_SETUP_CLOCKS) |          // Capture on rising edges, 8 bits
+                      SPI_CSR_DLYBCT(DAC_SPI_BYTE_DELAY_DLYBCT);                              // get_DAC_SPI_frame_busy_clocks() works from these delays
     SET_SPI_BAUD(DAC_SPI_BAUD_RATE);
     PIOA->PIO_PDR = PIO_PDR_P11;                                  // Enable MISO pin to function as peripheral
     PIOA->PIO_ABCDSR[0] &= ~PIO_ABCDSR_P11;                       // Connect peripheral to pin (NPCS0 is peripheral A for pin 11 on port A)
@@ -64,11 +85,81 @@ void init_SPI() {
     ENABLE_SPI_PDC();
     PDC_SPI->PERIPH_TNCR = 0;
     
+#if DAC_BLOCK_STREAMING_ENABLED
+    DISABLE_SPI_END_OF_TX_INTERRUPT();                            // Enabled only while a waveform is being streamed
+    NVIC_EnableIRQ(SPI_IRQn);
+    NVIC_SetPriority(SPI_IRQn, 0);
+    ENABLE_CYCLE_COUNTER();                                       // The stream's start up cadence check times blocks with it
+#endif
+    
     // Enable write protection
     SPI->SPI_WPMR = SPI_WPMR_WPKEY(SPI_WPMR_WPKEY_PASSWD) | SPI_WPMR_WPEN;
     USART0->US_WPMR = US_WPMR_WPKEY(US_WPMR_WPKEY_PASSWD) | US_WPMR_WPEN;
 }
 
+/*
+ * When streaming DAC frames in blocks, nothing paces the SPI except its own timing. Because the SPI and the sample timer
+ * both run off MCK, padding each frame with SYNC high time so it lasts exactly one sample period locks the frame cadence
+ * to the LDAC pulses generated by TC1 channel 0. The AD5791 latches the last complete frame on LDAC, so the phase between
+ * the two only needs to stay away from SYNC rising, which it will since neither one drifts. This is open loop, so
+ * start_DAC_block_streaming() has the first blocks of every stream timed against the sample timer to make sure.
+ * The SPI never holds SYNC high for less than DAC_SPI_CS_MINIMUM_IDLE_CLOCKS, so a frame only pads out exactly when there
+ * are at least that many idle clocks to spare.
+ */
+uint32_t get_DAC_SPI_frame_idle_clocks(float sample_frequency)
+{
+    uint32_t frame_period_clocks = (uint32_t)(SystemCoreClock/sample_frequency);
+    uint32_t frame_busy_clocks = get_DAC_SPI_frame_busy_clocks();
+    uint32_t idle_clocks = 0;
+    
+    if(frame_period_clocks > frame_busy_clocks)
+    {
+        idle_clocks = frame_period_clocks - frame_busy_clocks;
+    }
+    
+    if(idle_clocks > 255)                                               // DLYBCS is an 8-bit field
+    {
+        idle_clocks = 255;
+    }
+    
+    return(idle_clocks);
+}
+
+/*
+ * MCK cycles from one streamed frame's SYNC falling to the next one's, once init_SPI() has padded the frames for sample_frequency.
+ * Only equals GET_SAMPLE_TIMER_PERIOD_COUNTS(sample_frequency) when the padding fits DLYBCS.
+ */
+uint32_t get_DAC_SPI_frame_period_clocks(float sample_frequency)
+{
+    uint32_t idle_clocks = get_DAC_SPI_frame_idle_clocks(sample_frequency);
+    
+    if(idle_clocks < DAC_SPI_CS_MINIMUM_IDLE_CLOCKS)
+    {
+        idle_clocks = DAC_SPI_CS_MINIMUM_IDLE_CLOCKS;
+    }
+    
+    return(get_DAC_SPI_frame_busy_clocks() + idle_clocks);
+}
+
+/*
+ * MCK cycles one AD5791 frame keeps the SPI busy, from SYNC low to the last data bit. The sample ISR has to hand the PDC
+ * its frame at least this long before LDAC falls for the DAC to take it. Worked out from what init_SPI() programs:
+ * DLYBS ahead of the first bit, SCBR per bit, and DLYBCT between bytes. SCBR truncates the same way SET_SPI_BAUD does.
+ */
+uint32_t get_DAC_SPI_frame_busy_clocks(void)
+{
+    uint32_t setup_clocks = DAC_SPI_CS_SETUP_CLOCKS;
+    uint32_t byte_gap_clocks = 32 * DAC_SPI_BYTE_DELAY_DLYBCT;
+    uint32_t clocks_per_bit = (uint32_t)(SystemCoreClock/DAC_SPI_BAUD_RATE);
+    
+    if(setup_clocks == 0)                                               // DLYBS = 0 inserts half an SPCK period
+    {
+        setup_clocks = clocks_per_bit / 2;
+    }
+    
+    return(setup_clocks + DAC_SPI_FRAME_BITS*clocks_per_bit + ((DAC_SPI_FRAME_BITS / 8) - 1)*byte_gap_clocks);
+}
+
 /*
  * Initialize only the PIO controlled GPIO lines.
  * IO lines that are tied to peripherals are configured in the respective peripherals init function.
@@ -114,7 +205,9 @@ void init_gpio()
                         BOARD_REV_IO_BIT2               |
                         DEBUG1_IO_BIT                   |
                         DEBUG2_IO_BIT                   |
-                        EEPROM_WP_BIT;
+                        EEPROM_WP_BIT                   |
+                        EXT_TRIGGER_BIT                 |
+                        SYNC_OUT_BIT;
                     
     //set initial state of these OUTPUT pins to high - grouped by PIO blocks
     PIOC->PIO_SODR =    DIAG_MON_MUX_0_BIT              |
@@ -216,13 +309,29 @@ void init_gpio()
                         OUTSTG_SEL_HV_BIT               |
                         FRONT_REAR_TERM_BIT;
                         
+    PIOE->PIO_OWER =    SYNC_OUT_BIT;                                   //so the sample ISR can write the sync out line in one store
+    
     PIOE->PIO_OER =     DEBUG1_IO_BIT                   |
-                        DEBUG2_IO_BIT;
+                        DEBUG2_IO_BIT                   |
+                        SYNC_OUT_BIT;
                         
     PIOC->PIO_PDR = PIO_PDR_P23;                                        // Enable output pin to function as peripheral
     PIOC->PIO_ABCDSR[0] |= PIO_ABCDSR_P23;                              // Connect peripheral to pin (TIOA3 is peripheral B for pin 23 on port C)
     PIOC->PIO_ABCDSR[1] &= ~PIO_ABCDSR_P23;
     
+    PIOC->PIO_PDR = PIO_PDR_P29;                                        // Enable sync in pin to function as peripheral
+    PIOC->PIO_ABCDSR[0] |= PIO_ABCDSR_P29;                              // Connect peripheral to pin (TIOA5 is peripheral B for pin 29 on port C)
+    PIOC->PIO_ABCDSR[1] &= ~PIO_ABCDSR_P29;
+    
+    //trigger input interrupts on its rising edge only. Left disabled until burst mode asks for it.
+    EXT_TRIGGER_IO_PORT->PIO_AIMER =    EXT_TRIGGER_BIT;
+    EXT_TRIGGER_IO_PORT->PIO_ESR =      EXT_TRIGGER_BIT;
+    EXT_TRIGGER_IO_PORT->PIO_REHLSR =   EXT_TRIGGER_BIT;
+    DISABLE_EXT_TRIGGER_INTERRUPT();
+    CLEAR_EXT_TRIGGER_FLAG();
+    NVIC_EnableIRQ(EXT_TRIGGER_IRQn);
+    NVIC_SetPriority(EXT_TRIGGER_IRQn, 1);                              // Below the sample ISR, above the waveform control tick
+    
     //enable write protection so the PIO config won't get corrupted during runtime
     PIOC->PIO_WPMR = PIO_WPMR_WPKEY(PIO_WPMR_WPKEY_PASSWD) | PIO_WPMR_WPEN;
     PIOD->PIO_WPMR = PIO_WPMR_WPKEY(PIO_WPMR_WPKEY_PASSWD) | PIO_WPMR_WPEN;
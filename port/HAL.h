@@ -14,8 +14,16 @@
 //typedef Uart* uart_t;
 typedef Pio*  pio_t;
 
-#define OUTPUT_SAMPLING_FREQUENCY   600e3			//Hz
+#define OUTPUT_SAMPLING_FREQUENCY   600e3			//Hz, the fastest sample rate. Lower output frequencies may run at this divided by a power of 2.
+#define OUTPUT_SAMPLING_LDAC_DUTY   0.98			//at OUTPUT_SAMPLING_FREQUENCY. The LDAC low time is kept the same at the slower rates.
 #define DAC_SPI_BAUD_RATE           25e6			//Hz
+#ifndef DAC_BLOCK_STREAMING_ENABLED                                     //may be set from the compiler command line
+#define DAC_BLOCK_STREAMING_ENABLED 0				//1 = SPI PDC streams blocks of DAC frames at the LDAC cadence, 0 = TC3 ISR kicks off one frame per sample. See output_control.h for what streaming gives up.
+#endif
+#define DAC_SPI_FRAME_BITS          24				//AD5791 frame length
+#define DAC_SPI_CS_SETUP_CLOCKS     2				//DLYBS, MCK cycles from SYNC low to first SCLK edge
+#define DAC_SPI_BYTE_DELAY_DLYBCT   0				//DLYBCT, 0 = each frame byte follows the last with no gap, otherwise 32 x DLYBCT MCK cycles between them
+#define DAC_SPI_CS_MINIMUM_IDLE_CLOCKS 6			//SYNC high time between frames when DLYBCS is programmed to this or less
 
 // System
 #define SET_WATCHDOG_TIME(milliseconds) (WDT->WDT_MR = WDT_MR_WDV((32768*(milliseconds))/(1000*128)) | WDT_MR_WDRSTEN | WDT_MR_WDDBGHLT | WDT_MR_WDIDLEHLT)
@@ -24,6 +32,11 @@ typedef Pio*  pio_t;
 #define PET_WATCHDOG() (WDT->WDT_CR = WDT_CR_KEY(0xA5) | WDT_CR_WDRSTT)			//CMSIS w Atmel Studio 7 changed wdt.h. Key no longer hard coded in wdt.h
 #define MASK_ALL_INTERRUPTS() (__disable_irq())
 #define UNMASK_INTERRUPTS() (__enable_irq())
+#define ENABLE_CYCLE_COUNTER() (CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk, DWT->CYCCNT = 0, DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk)     //DWT counts core clocks from here on
+#define READ_CYCLE_COUNT() (DWT->CYCCNT)
+#ifndef SMLAWB                                                              //the host build's sam.h brings a portable one
+#define SMLAWB(word, halfword, accumulator) __extension__ ({ int32_t smlawb_result; __ASM ("smlawb %0, %1, %2, %3" : "=r" (smlawb_result) : "r" (word), "r" (halfword), "r" (accumulator)); smlawb_result; })   //accumulator + ((word * (int16_t)halfword) >> 16) in one cycle. Not wrapped by CMSIS.
+#endif
 void delay_ms(float ms);
 
 //Reset Controller
@@ -39,7 +52,9 @@ void delay_ms(float ms);
 #define OUTPUT_UPDATE_TIMER_ISR TC3_Handler
 #define UPDATE_SAMPLE_TIMER_FREQUENCY(frequency)    (TC1->TC_CHANNEL[0].TC_RC = TC_RC_RC((uint32_t)(SystemCoreClock/(frequency))))
 #define UPDATE_SAMPLE_TIMER_DUTY(frequency, duty)   (TC1->TC_CHANNEL[0].TC_RA = TC_RA_RA((uint32_t)((float)(duty)*(SystemCoreClock/(frequency)))))
-#define CLEAR_OUTPUT_UPDATE_TIMER_FLAG()            (TC1->TC_CHANNEL[0].TC_SR)
+#define GET_SAMPLE_TIMER_PERIOD_COUNTS(frequency)   ((uint32_t)(SystemCoreClock/(frequency)))
+#define SET_SAMPLE_TIMER_COUNTS(RA_counts, RC_counts) (TC1->TC_CHANNEL[0].TC_RA = TC_RA_RA(RA_counts), TC1->TC_CHANNEL[0].TC_RC = TC_RC_RC(RC_counts))   //only safe while the counter is below both, e.g. just after an RC compare
+#define CLEAR_OUTPUT_UPDATE_TIMER_FLAG()            ((uint32_t)TC1->TC_CHANNEL[0].TC_SR)
 #define ENABLE_TIMER_CLOCK()                        (TC1->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKEN)
 #define DISABLE_TIMER_CLOCK()                       (TC1->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKDIS)
 #define ENABLE_TIMER_INTERRUPT()                    (TC1->TC_CHANNEL[0].TC_IER = TC_IER_CPCS)
@@ -49,16 +64,49 @@ void delay_ms(float ms);
 #define ISSUE_TIMER_SW_TRIGGER()                    (TC1->TC_CHANNEL[0].TC_CCR = TC_CCR_SWTRG)
 #define HAS_RC_COMPARED_SINCE_LAST_STAUS_REG_READ() (TC1->TC_CHANNEL[0].TC_SR & TC_SR_CPCS)
 
+#define WAVEFORM_CONTROL_TIMER_ISR TC4_Handler                                                        //slow tick for things that steer the waveform over time (frequency sweeps)
+#define WAVEFORM_CONTROL_TIMER_FREQUENCY            1000                                                //Hz
+#define WAVEFORM_CONTROL_TIMER_PRESCALER            128                                                 //TIMER_CLOCK4 = MCK/128
+#define CLEAR_WAVEFORM_CONTROL_TIMER_FLAG()         ((uint32_t)TC1->TC_CHANNEL[1].TC_SR)
+#define START_WAVEFORM_CONTROL_TIMER()              (TC1->TC_CHANNEL[1].TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG)
+#define STOP_WAVEFORM_CONTROL_TIMER()               (TC1->TC_CHANNEL[1].TC_CCR = TC_CCR_CLKDIS)
+
+#define SYNC_IN_CAPTURE_ISR TC5_Handler                                                                //TC1 channel 2 in capture mode, reference edges on TIOA5
+#define SYNC_IN_CAPTURE_PRESCALER                   2                                                   //TIMER_CLOCK1 = MCK/2
+#define READ_SYNC_IN_CAPTURE_STATUS()               ((uint32_t)TC1->TC_CHANNEL[2].TC_SR)
+#define READ_SYNC_IN_CAPTURE()                      (TC1->TC_CHANNEL[2].TC_RA)
+#define READ_SYNC_IN_TIMER_COUNT()                  (TC1->TC_CHANNEL[2].TC_CV)
+#define START_SYNC_IN_CAPTURE()                     (TC1->TC_CHANNEL[2].TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG, TC1->TC_CHANNEL[2].TC_IER = TC_IER_LDRAS)
+#define STOP_SYNC_IN_CAPTURE()                      (TC1->TC_CHANNEL[2].TC_IDR = TC_IDR_LDRAS, TC1->TC_CHANNEL[2].TC_CCR = TC_CCR_CLKDIS)
+#define READ_SAMPLE_TIMER_COUNT()                   (TC1->TC_CHANNEL[0].TC_CV)
+#define READ_SAMPLE_TIMER_PERIOD()                  (TC1->TC_CHANNEL[0].TC_RC)
+#define IS_OUTPUT_UPDATE_TIMER_ISR_PENDING()        (NVIC_GetPendingIRQ(TC3_IRQn) != 0)                 //RC compared, but the sample ISR hasn't run for it yet
+
 // SPI
 #define SPI_ISR SPI_Handler
 #define SET_SPI_BAUD(frequency) (SPI->SPI_CSR[0] |= SPI_CSR_SCBR((uint32_t)(SystemCoreClock/(frequency))))
 #define SPI_WPMR_WPKEY_PASSWD 0x535049u                                         //CMSIS w Atmel Studio 7 changed spi.h. Key no longer hard coded in spi.h
 
+#ifndef PDC_BUS_ADDRESS
+#define PDC_BUS_ADDRESS(address) ((uint32_t)(address))                        //what the PDC is handed for a buffer. The host build maps its 64-bit pointers.
+#endif
+
 #define ENABLE_SPI_PDC() (PDC_SPI->PERIPH_PTCR = PERIPH_PTCR_TXTEN)
 #define DISABLE_SPI_PDC() (PDC_SPI->PERIPH_PTCR = PERIPH_PTCR_TXTDIS)
-#define SET_SPI_PDC_TX_POINTER(address) (PDC_SPI->PERIPH_TPR = (uint32_t)(address))
+#define SET_SPI_PDC_TX_POINTER(address) (PDC_SPI->PERIPH_TPR = PDC_BUS_ADDRESS(address))
 #define SET_SPI_PDC_TX_COUNT(count) (PDC_SPI->PERIPH_TCR = (count))
 #define IS_SPI_PDC_TXBUFFER_EMPTY() (SPI->SPI_SR & SPI_SR_TXBUFE)
+#define IS_SPI_TX_COMPLETE() (SPI->SPI_SR & SPI_SR_TXEMPTY)                        //last bit shifted out and SYNC back high, unlike TXBUFE which only says the PDC is done
+#define READ_SPI_PDC_TX_COUNT() (PDC_SPI->PERIPH_TCR)                           //transfers left in the current buffer
+
+// SPI - block streaming (variable peripheral select, one 32-bit PDC word per byte so SYNC can be raised at the end of every frame)
+#define SET_SPI_PDC_TX_NEXT_POINTER(address) (PDC_SPI->PERIPH_TNPR = PDC_BUS_ADDRESS(address))
+#define SET_SPI_PDC_TX_NEXT_COUNT(count) (PDC_SPI->PERIPH_TNCR = (count))
+#define ENABLE_SPI_END_OF_TX_INTERRUPT() (SPI->SPI_IER = SPI_IER_ENDTX)
+#define DISABLE_SPI_END_OF_TX_INTERRUPT() (SPI->SPI_IDR = SPI_IDR_ENDTX)
+#define DAC_SPI_NPCS0_PCS 0x0Eu                                                 //PCS field value selecting NPCS0 when PCSDEC = 0
+#define SPI_STREAM_WORD(data_byte) (SPI_TDR_TD(data_byte) | SPI_TDR_PCS(DAC_SPI_NPCS0_PCS))
+#define SPI_STREAM_LAST_WORD(data_byte) (SPI_STREAM_WORD(data_byte) | SPI_TDR_LASTXFER)
 
 //USART
 #define US_WPMR_WPKEY_PASSWD 0x555341u
@@ -259,8 +307,38 @@ void delay_ms(float ms);
 #define HV_INTERLOCK_MON_MASK       ((uint32_t) HV_INTERLOCK_MON_BIT)
 #define READ_HV_INTERLOCK_MONITOR   (((PIOD->PDSR) & HV_INTERLOCK_MON_MASK) >> HV_INTERLOCK_MON_BIT_SHIFT)
 
+//External Trigger - Input. A rising edge starts a burst.
+//Board configuration: the PIOE line the trigger input is wired to. PE0 to PE5 are the board revision, debug and EEPROM lines,
+//so it defaults to the next one, PE6. A board that routes it elsewhere on PIOE defines EXT_TRIGGER_BIT_SHIFT.
+#ifndef EXT_TRIGGER_BIT_SHIFT
+#define EXT_TRIGGER_BIT_SHIFT       6
+#endif
+#define EXT_TRIGGER_IO_PORT         PIOE
+#define EXT_TRIGGER_BIT             ((uint32_t) (1u << EXT_TRIGGER_BIT_SHIFT))
+#define EXT_TRIGGER_IRQn            PIOE_IRQn
+#define EXT_TRIGGER_ISR             PIOE_Handler
+#define ENABLE_EXT_TRIGGER_INTERRUPT()  (EXT_TRIGGER_IO_PORT->PIO_IER = EXT_TRIGGER_BIT)
+#define DISABLE_EXT_TRIGGER_INTERRUPT() (EXT_TRIGGER_IO_PORT->PIO_IDR = EXT_TRIGGER_BIT)
+#define CLEAR_EXT_TRIGGER_FLAG()        ((uint32_t)EXT_TRIGGER_IO_PORT->PIO_ISR)          //reading ISR clears it, and returns which lines fired
+
+//Sync Out - Output. Pulses high for one sample as the phase accumulator wraps.
+//Board configuration: the PIOE line sync out drives. It defaults to PE7, the line after the trigger input. A board that routes
+//it elsewhere on PIOE defines SYNC_OUT_BIT_SHIFT, no higher than SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS - 1 (see the sample ISR).
+#ifndef SYNC_OUT_BIT_SHIFT
+#define SYNC_OUT_BIT_SHIFT          7
+#endif
+#if SYNC_OUT_BIT_SHIFT == EXT_TRIGGER_BIT_SHIFT
+#error "Sync out and the external trigger can't share a PIOE line"
+#endif
+#define SYNC_OUT_IO_PORT            PIOE
+#define SYNC_OUT_BIT                ((uint32_t) (1u << SYNC_OUT_BIT_SHIFT))
+#define WRITE_SYNC_OUT_OUTPUT(level_bit) (SYNC_OUT_IO_PORT->PIO_ODSR = (level_bit))   //sync out is the only line on this port with ODSR writes enabled
+
 void init_timers();
 void init_SPI();
+uint32_t get_DAC_SPI_frame_idle_clocks(float sample_frequency);
+uint32_t get_DAC_SPI_frame_period_clocks(float sample_frequency);
+uint32_t get_DAC_SPI_frame_busy_clocks(void);
 void init_gpio();
 void init_processor();
 
@@ -0,0 +1,289 @@
+/** @file dds_benchmark.cpp
+ *  @brief host tool measuring the sine output's spectral quality across a frequency sweep
+ *
+ *  Runs the firmware on the simulated SAM4E, so what's measured is the real engine: set_frequency_setting() picks the
+ *  sample rate and phase increment, generate_DAC_code_table() (or the on the fly scaling) builds the codes, the TC3 ISR
+ *  steps TABLE_INDEX through them, and the AD5791 model records each code as LDAC latches it. At each frequency the
+ *  code stream is captured once the output has settled and handed to measure_sine_spectrum().
+ *
+ *  Usage: dds_benchmark [start Hz] [stop Hz] [frequencies] [record samples]
+ *  - Frequencies are log spaced from start to stop, 13 from 10Hz to 100kHz by default.
+ *  - Records are 65536 samples by default, lengthened by powers of 2 where needed to hold BENCHMARK_MINIMUM_CYCLES.
+ *  - Output is CSV on stdout, one row per frequency, with '#' lines giving the build configuration and the worst cases.
+ *    Anything odd about a capture (a skipped frequency, samples not evenly spaced) goes to stderr.
+ *
+ *  The engine configuration is compile time, so build once per configuration and diff the outputs. The DDS flags in
+ *  sine_wave.h and DAC_BLOCK_STREAMING_ENABLED in HAL.h may be set through the Makefile's DEFINES, e.g.
+ *  -DDDS_LINEAR_INTERPOLATION_ENABLED=1 or -DSINE_TABLE_OVERSIZE_BITS=18. Other SINE_TABLE_BITS need quarter_sine_table
+ *  regenerated with sine_table_generator.m first.
+ *
+ *  Build with port/host/Makefile, which needs nothing from outside this repository for this program.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "sam4e_sim.h"
+#include "host_firmware.h"
+#include "spectral_analysis.h"
+#include "HAL.h"
+#include "sine_wave.h"
+#include "output_control.h"
+#include "settings_manager.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCHMARK_DEFAULT_START_FREQUENCY       10.0
+#define BENCHMARK_DEFAULT_STOP_FREQUENCY        MAXIMUM_FREQUENCY_IN_HZ
+#define BENCHMARK_DEFAULT_FREQUENCIES           13
+#define BENCHMARK_DEFAULT_RECORD_SAMPLES        65536
+#define BENCHMARK_MAXIMUM_RECORD_SAMPLES        (1u << 21)
+#define BENCHMARK_MINIMUM_CYCLES                64          //per record, twice what measure_sine_spectrum() needs
+#define BENCHMARK_AMPLITUDE_DBFS                -1.0        //of the 10V range. Leaves room for the sinc and filter droop compensation.
+#define BENCHMARK_SETTLE_CYCLES                 2           //output periods run after a new table is live, so the sample rate change and table swap are behind us
+#define BENCHMARK_SETTLE_SAMPLES                1024        //then this many more at the new sample rate
+#define BENCHMARK_TABLE_GENERATION_TIMEOUT      1.0         //seconds of simulated time
+
+typedef struct
+{
+	float requested_frequency;
+	double achieved_frequency;
+	double sampling_frequency;
+	uint32_t number_of_samples;
+	spectral_metrics_type metrics;
+}benchmark_result_type;
+
+void start_benchmark_sine(void);
+bool run_benchmark_frequency(float frequency, uint32_t minimum_record_samples, benchmark_result_type *result);
+bool capture_DAC_codes(uint32_t number_of_samples, double sampling_frequency, int32_t *codes);
+
+int main(int argc, char *argv[])
+{
+	double start_frequency = (argc > 1) ? atof(argv[1]) : BENCHMARK_DEFAULT_START_FREQUENCY;
+	double stop_frequency = (argc > 2) ? atof(argv[2]) : BENCHMARK_DEFAULT_STOP_FREQUENCY;
+	uint32_t number_of_frequencies = (argc > 3) ? (uint32_t)atoi(argv[3]) : BENCHMARK_DEFAULT_FREQUENCIES;
+	uint32_t record_samples = (argc > 4) ? (uint32_t)atoi(argv[4]) : BENCHMARK_DEFAULT_RECORD_SAMPLES;
+	benchmark_result_type result;
+	double worst_SFDR = INFINITY, worst_SFDR_frequency = 0;
+	double worst_THD = -INFINITY, worst_THD_frequency = 0;
+	double worst_frequency_error = 0, worst_frequency_error_frequency = 0;
+	double frequency_error;
+	float frequency;
+	uint32_t i;
+
+	if((number_of_frequencies == 0) || (start_frequency <= 0) || (stop_frequency < start_frequency) ||
+	   (record_samples == 0) || (record_samples & (record_samples - 1)) || (record_samples > BENCHMARK_MAXIMUM_RECORD_SAMPLES))
+	{
+		fprintf(stderr, "usage: dds_benchmark [start Hz] [stop Hz] [frequencies] [record samples, a power of 2 up to %u]\n", BENCHMARK_MAXIMUM_RECORD_SAMPLES);
+		return(1);
+	}
+
+	sim_reset();
+	init_all();
+	test_init_function();   //TODO: REMOVE. Needed so cal values get non-garbage data. Mirrors main.cpp.
+	start_benchmark_sine();
+
+	printf("# SINE_TABLE_BITS=%d SINE_TABLE_OVERSIZE_BITS=%d DDS_LINEAR_INTERPOLATION_ENABLED=%d DDS_ON_THE_FLY_SCALING_ENABLED=%d DAC_BLOCK_STREAMING_ENABLED=%d\n",
+	       SINE_TABLE_BITS, SINE_TABLE_OVERSIZE_BITS, DDS_LINEAR_INTERPOLATION_ENABLED, DDS_ON_THE_FLY_SCALING_ENABLED, DAC_BLOCK_STREAMING_ENABLED);
+	printf("# amplitude %.1fdBFS of the 10V range, 7-term Blackman-Harris window, THD over harmonics 2 to %d\n", BENCHMARK_AMPLITUDE_DBFS, SPECTRAL_HARMONICS);
+	printf("requested_Hz,achieved_Hz,sampling_Hz,samples,measured_Hz,frequency_error_ppm,amplitude_codes,SFDR_dBc,spur_Hz,THD_dBc,SINAD_dB\n");
+
+	for(i = 0; i < number_of_frequencies; i++)
+	{
+		frequency = (number_of_frequencies > 1) ? (float)(start_frequency * pow(stop_frequency / start_frequency, (double)i / (number_of_frequencies - 1))) : (float)start_frequency;
+
+		if(!run_benchmark_frequency(frequency, record_samples, &result))
+		{
+			continue;
+		}
+
+		frequency_error = 1e6 * (result.metrics.measured_frequency - result.requested_frequency) / result.requested_frequency;
+
+		printf("%.6f,%.6f,%.1f,%u,%.6f,%.4f,%.1f,%.2f,%.3f,%.2f,%.2f\n",
+		       result.requested_frequency, result.achieved_frequency, result.sampling_frequency, (unsigned int)result.number_of_samples,
+		       result.metrics.measured_frequency, frequency_error, result.metrics.fundamental_amplitude,
+		       result.metrics.SFDR, result.metrics.spur_frequency, result.metrics.THD, result.metrics.SINAD);
+		fflush(stdout);
+
+		if(result.metrics.SFDR < worst_SFDR)
+		{
+			worst_SFDR = result.metrics.SFDR;
+			worst_SFDR_frequency = result.requested_frequency;
+		}
+
+		if(result.metrics.THD > worst_THD)
+		{
+			worst_THD = result.metrics.THD;
+			worst_THD_frequency = result.requested_frequency;
+		}
+
+		if(fabs(frequency_error) >= fabs(worst_frequency_error))
+		{
+			worst_frequency_error = frequency_error;
+			worst_frequency_error_frequency = result.requested_frequency;
+		}
+	}
+
+	printf("# worst SFDR %.2fdBc at %.3fHz, worst THD %.2fdBc at %.3fHz, worst frequency error %.4fppm at %.3fHz\n",
+	       worst_SFDR, worst_SFDR_frequency, worst_THD, worst_THD_frequency, worst_frequency_error, worst_frequency_error_frequency);
+
+	return(0);
+}
+
+/**
+ * \brief Turns a sine on in the 10V range through settings_manager, as the LSCP callbacks would
+ *
+ * \return void
+ */
+void start_benchmark_sine(void)
+{
+	output_level_type level;
+
+	level.amplitude = get_full_scale_voltage_range_value(VRANGE_10V) * (float)pow(10.0, BENCHMARK_AMPLITUDE_DBFS / 20.0);
+	level.offset = 0;
+
+	set_voltage_range_setting(VRANGE_10V, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+	set_voltage_level_setting(level, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+	set_frequency_setting((float)BENCHMARK_DEFAULT_START_FREQUENCY, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+	set_shape_setting(SHAPE_SINE, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+	set_output_state_enabled_setting(true, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+	execute_start_command();
+}
+
+/**
+ * \brief Retunes the output, lets it settle, captures a record and measures it
+ *
+ * \param frequency Hz
+ * \param minimum_record_samples record length, lengthened if it wouldn't hold BENCHMARK_MINIMUM_CYCLES
+ * \param result what was measured
+ *
+ * \return bool false if the frequency was skipped, with the reason on stderr
+ */
+bool run_benchmark_frequency(float frequency, uint32_t minimum_record_samples, benchmark_result_type *result)
+{
+	uint64_t timeout_cycle = sim_get_cycle_count() + (uint64_t)(BENCHMARK_TABLE_GENERATION_TIMEOUT * SIM_CORE_CLOCK_FREQUENCY);
+	int32_t *codes;
+	bool is_measured;
+
+	if(!validate_frequency_setting(frequency))
+	{
+		fprintf(stderr, "dds_benchmark: %.3fHz skipped, outside %g to %gHz\n", frequency, MINIMUM_FREQUENCY_IN_HZ, MAXIMUM_FREQUENCY_IN_HZ);
+		return(false);
+	}
+
+	set_frequency_setting(frequency, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+
+	while(is_DAC_code_table_generation_pending() && (sim_get_cycle_count() < timeout_cycle))
+	{
+		run_main_loop_for_cycles(HOST_MAIN_LOOP_PASS_CYCLES);
+	}
+
+	if(is_DAC_code_table_generation_pending())
+	{
+		fprintf(stderr, "dds_benchmark: %.3fHz skipped, DAC code table never went live\n", frequency);
+		return(false);
+	}
+
+	result->requested_frequency = frequency;
+	result->achieved_frequency = get_achieved_output_frequency();
+
+	run_main_loop_for_cycles((uint64_t)((BENCHMARK_SETTLE_CYCLES / result->achieved_frequency) * SIM_CORE_CLOCK_FREQUENCY));
+
+	result->sampling_frequency = get_output_sampling_frequency();          //only read once the ISR has taken up the new rate
+	run_main_loop_for_cycles((uint64_t)((BENCHMARK_SETTLE_SAMPLES / result->sampling_frequency) * SIM_CORE_CLOCK_FREQUENCY));
+
+	result->number_of_samples = minimum_record_samples;
+	while((result->number_of_samples * result->achieved_frequency / result->sampling_frequency) < BENCHMARK_MINIMUM_CYCLES)
+	{
+		result->number_of_samples <<= 1;
+	}
+
+	if(result->number_of_samples > BENCHMARK_MAXIMUM_RECORD_SAMPLES)
+	{
+		fprintf(stderr, "dds_benchmark: %.3fHz skipped, %d cycles need more than %u samples at %.1fHz\n",
+		        frequency, BENCHMARK_MINIMUM_CYCLES, BENCHMARK_MAXIMUM_RECORD_SAMPLES, result->sampling_frequency);
+		return(false);
+	}
+
+	codes = (int32_t *)malloc(result->number_of_samples * sizeof(int32_t));
+
+	if(codes == NULL)
+	{
+		fprintf(stderr, "dds_benchmark: %.3fHz skipped, no room for %u samples\n", frequency, (unsigned int)result->number_of_samples);
+		return(false);
+	}
+
+	is_measured = capture_DAC_codes(result->number_of_samples, result->sampling_frequency, codes) &&
+	              measure_sine_spectrum(codes, result->number_of_samples, result->sampling_frequency, result->achieved_frequency, &result->metrics);
+
+	if(!is_measured)
+	{
+		fprintf(stderr, "dds_benchmark: %.3fHz skipped, capture or analysis failed\n", frequency);
+	}
+
+	free(codes);
+
+	return(is_measured);
+}
+
+/**
+ * \brief Records the next DAC register updates, checking they came evenly spaced at the sample rate. Uneven spacing
+ * is reported but the record is still returned, since it's the output as it went out.
+ *
+ * \param number_of_samples how many
+ * \param sampling_frequency Hz, what the spacing should be
+ * \param codes the DAC codes, in order
+ *
+ * \return bool false if the output stopped updating
+ */
+bool capture_DAC_codes(uint32_t number_of_samples, double sampling_frequency, int32_t *codes)
+{
+	sim_DAC_sample_type *capture = (sim_DAC_sample_type *)malloc(number_of_samples * sizeof(sim_DAC_sample_type));
+	uint64_t sample_period_cycles = (uint64_t)((SIM_CORE_CLOCK_FREQUENCY / sampling_frequency) + 0.5);
+	uint64_t timeout_cycle = sim_get_cycle_count() + 2 * number_of_samples * sample_period_cycles + SIM_CORE_CLOCK_FREQUENCY / 1000;
+	uint32_t captured_samples;
+	uint32_t uneven_samples = 0;
+	uint32_t i;
+
+	if(capture == NULL)
+	{
+		return(false);
+	}
+
+	sim_set_DAC_capture_buffer(capture, number_of_samples);
+
+	while((sim_get_DAC_capture_count() < number_of_samples) && (sim_get_cycle_count() < timeout_cycle))
+	{
+		run_main_loop_for_cycles(HOST_MAIN_LOOP_PASS_CYCLES);
+	}
+
+	captured_samples = sim_get_DAC_capture_count();
+	sim_set_DAC_capture_buffer(NULL, 0);
+
+	if(captured_samples < number_of_samples)
+	{
+		free(capture);
+		return(false);
+	}
+
+	for(i = 0; i < number_of_samples; i++)
+	{
+		codes[i] = capture[i].code;
+
+		if((i > 0) && ((capture[i].cycle - capture[i - 1].cycle) != sample_period_cycles))
+		{
+			uneven_samples++;
+		}
+	}
+
+	if(uneven_samples != 0)
+	{
+		fprintf(stderr, "dds_benchmark: %u of %u samples not %llu cycles after the one before\n",
+		        (unsigned int)uneven_samples, (unsigned int)number_of_samples, (unsigned long long)sample_period_cycles);
+	}
+
+	free(capture);
+
+	return(true);
+}
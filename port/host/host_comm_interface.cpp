@@ -0,0 +1,61 @@
+/** @file host_comm_interface.cpp
+ *  @brief host build stand in for android_comm_interface_manager.cpp, for when the LSCP library and cJSON sources aren't to hand
+ *
+ *  Implements android_comm_interface_manager.h on the loopback without the LSCP service, so the firmware core builds from
+ *  this repository alone (see the Makefile). Nothing decodes LSCP, so the LSCP callbacks and command_manager.cpp are left
+ *  out of such a build, bytes written in by the far end are read and dropped, and each setting message goes out as just
+ *  the setting's name and a newline. That's enough for a harness to see which settings the firmware reported, and when.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "android_comm_interface_manager.h"
+#include "serial_circular_buffer_service.h"
+#include "profiler.h"
+#include <string.h>
+
+#define ANDROID_TX_UART_BUFFER_SIZE			2048
+#define ANDROID_RX_UART_BUFFER_SIZE			2048
+
+char android_uart_Rx_buffer[ANDROID_RX_UART_BUFFER_SIZE];
+char android_uart_Tx_buffer[ANDROID_TX_UART_BUFFER_SIZE];
+
+serial_circular_buffer mySerialCircularBuffer;
+
+void init_android_comm_interface(void)
+{
+	mySerialCircularBuffer.init(UART_PORT_0,
+								android_uart_Rx_buffer,
+								ANDROID_RX_UART_BUFFER_SIZE,
+								android_uart_Tx_buffer,
+								ANDROID_TX_UART_BUFFER_SIZE,
+								115200,
+								UART_PARITY_NONE);
+}
+
+void execute_android_comm_packet_reception_state_machine(void)
+{
+	PROFILE_BEGIN(PROFILE_PROBE_LSCP_PROCESSING);
+	while(mySerialCircularBuffer.get_number_of_unread_bytes() > 0)
+	{
+		mySerialCircularBuffer.get_latest_byte();
+	}
+	PROFILE_END(PROFILE_PROBE_LSCP_PROCESSING);
+}
+
+void generate_local_setting_message(const char *setting_name)
+{
+	char newline = '\n';
+
+	mySerialCircularBuffer.copy_packet_into_Tx_buffer_and_transmit((char *)setting_name, strlen(setting_name));
+	mySerialCircularBuffer.copy_packet_into_Tx_buffer_and_transmit(&newline, 1);
+}
+
+uint32_t generate_remote_command_message_and_wait_for_response(const char *command_name, void *command_data_param)
+{
+	(void)command_name;
+	(void)command_data_param;
+
+	return(1);                                  //nothing at the far end can answer, so it always times out
+}
@@ -0,0 +1,62 @@
+/** @file host_firmware.cpp
+ *  @brief Implementation file for the functions declared in host_firmware.h
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "sam4e_sim.h"
+#include "host_firmware.h"
+#include "HAL.h"
+#include "android_comm_interface_manager.h"
+#include "output_control.h"
+#include "settings_manager.h"
+#include "profiler.h"
+
+void init_all(void)
+{
+	MASK_ALL_INTERRUPTS();
+
+	init_processor();
+	init_profiler();
+
+	delay_ms(200);
+
+	init_gpio();
+	init_timers();
+	init_SPI();
+	init_android_comm_interface();
+	initialize_output_control_parameters();
+	load_settings_struct_with_default_values();
+	init_AD5791_DAC();
+
+	UNMASK_INTERRUPTS();
+}
+
+void run_main_loop_pass(void)
+{
+	PET_WATCHDOG();
+
+	execute_android_comm_packet_reception_state_machine();
+
+	service_DAC_code_table_generation();
+
+	service_frequency_sweep();
+
+	service_sync_in();
+
+	service_DC_ramp();
+
+	service_sample_overrun();
+}
+
+void run_main_loop_for_cycles(uint64_t cycles)
+{
+	uint64_t end_cycle = sim_get_cycle_count() + cycles;
+
+	while(sim_get_cycle_count() < end_cycle)
+	{
+		run_main_loop_pass();
+		sim_run_cycles(HOST_MAIN_LOOP_PASS_CYCLES);
+	}
+}
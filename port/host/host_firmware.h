@@ -0,0 +1,42 @@
+/** @file host_firmware.h
+ *  @brief the firmware's start up and main loop, for host programs running it on the simulated SAM4E
+ *
+ *  The same calls main.cpp makes, split so a host program can run simulated time between main loop passes and poke
+ *  settings in through settings_manager as the LSCP callbacks would.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+
+#ifndef HOST_FIRMWARE_H_
+#define HOST_FIRMWARE_H_
+
+#include <stdint.h>
+
+#define HOST_MAIN_LOOP_PASS_CYCLES      1200        //10uS of simulated time per pass of the main loop
+
+/**
+ * \brief Same start up as main.cpp's init_all(). Call sim_reset() first.
+ *
+ * \return void
+ */
+void init_all(void);
+
+/**
+ * \brief One pass of main.cpp's while(1) loop, less the debug LED ticker
+ *
+ * \return void
+ */
+void run_main_loop_pass(void);
+
+/**
+ * \brief Runs main loop passes, HOST_MAIN_LOOP_PASS_CYCLES of simulated time apart, for at least the time given
+ *
+ * \param cycles core clock cycles to run
+ *
+ * \return void
+ */
+void run_main_loop_for_cycles(uint64_t cycles);
+
+#endif /* HOST_FIRMWARE_H_ */
@@ -0,0 +1,169 @@
+/** @file host_main.cpp
+ *  @brief entry point for the host build, which runs the firmware on simulated SAM4E peripherals
+ *
+ *  Stands in for source/main.cpp: the same start up, then the same main loop passes, with sim_run_cycles() letting
+ *  simulated time move on between them. output_control, settings_manager and the LSCP callbacks are built unchanged
+ *  on top of port/HAL.h, which sees the host sam.h rather than the device header.
+ *
+ *  Usage: host_sources [seconds] [capture.csv]
+ *  - LSCP bytes read from stdin are fed to the loopback circular buffer, as if they'd arrived over the UART. stdin is
+ *    read to its end before the run starts, so redirect it from a file, or from /dev/null for none.
+ *  - Bytes the LSCP service transmits are written to stdout.
+ *  - Every AD5791 DAC register update is written to capture.csv, if given, as cycle,seconds,code.
+ *  - The run ends after [seconds] of simulated time (1 by default), or when the firmware resets the micro.
+ *
+ *  Commands that peek at raw target addresses (ReadMem, and the memory read in VersionInfo) have nothing to read here.
+ *
+ *  Build with port/host/Makefile. Without the LSCP library sources, host_comm_interface.cpp takes the LSCP service's place:
+ *  stdin is read and dropped, and stdout gets the name of each setting the firmware reports, one per line.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "sam4e_sim.h"
+#include "host_firmware.h"
+#include "HAL.h"
+#include "serial_circular_buffer_service.h"
+#include "android_comm_interface_manager.h"
+#include "output_control.h"
+#include "settings_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_DEFAULT_RUN_SECONDS        1.0
+#define HOST_TX_CHUNK_BYTES             256
+
+extern serial_circular_buffer mySerialCircularBuffer;
+
+char *read_all_of_stdin(uint32_t *number_of_bytes);
+void write_DAC_capture(const char *file_name, const sim_DAC_sample_type *capture, uint32_t count);
+
+int main(int argc, char *argv[])
+{
+	double run_seconds = (argc > 1) ? atof(argv[1]) : HOST_DEFAULT_RUN_SECONDS;
+	const char *capture_file_name = (argc > 2) ? argv[2] : NULL;
+	uint64_t run_cycles = (uint64_t)(run_seconds * SIM_CORE_CLOCK_FREQUENCY);
+	uint32_t capture_size = (uint32_t)(run_seconds * OUTPUT_SAMPLING_FREQUENCY) + 1024;     //at most one update per sample, plus one shots
+	sim_DAC_sample_type *capture = NULL;
+	char *Rx_bytes;
+	uint32_t Rx_bytes_total;
+	uint32_t Rx_bytes_fed = 0;
+	char Tx_chunk[HOST_TX_CHUNK_BYTES];
+	uint32_t Tx_chunk_bytes;
+
+	if(capture_file_name != NULL)
+	{
+		capture = (sim_DAC_sample_type *)malloc(capture_size * sizeof(sim_DAC_sample_type));
+
+		if(capture == NULL)
+		{
+			fprintf(stderr, "host: no room for %u DAC captures\n", (unsigned int)capture_size);
+			return(1);
+		}
+	}
+
+	Rx_bytes = read_all_of_stdin(&Rx_bytes_total);
+
+	sim_reset();
+	sim_set_DAC_capture_buffer(capture, capture_size);
+
+	init_all();
+	test_init_function();   //TODO: REMOVE. Needed so cal values get non-garbage data. Mirrors main.cpp.
+
+	while((sim_get_cycle_count() < run_cycles) && (sim_get_reset_count() == 0))
+	{
+		Rx_bytes_fed += mySerialCircularBuffer.write_Rx_bytes(&Rx_bytes[Rx_bytes_fed], Rx_bytes_total - Rx_bytes_fed);
+
+		run_main_loop_pass();
+
+		while((Tx_chunk_bytes = mySerialCircularBuffer.read_Tx_bytes(Tx_chunk, HOST_TX_CHUNK_BYTES)) > 0)
+		{
+			fwrite(Tx_chunk, 1, Tx_chunk_bytes, stdout);
+		}
+
+		sim_run_cycles(HOST_MAIN_LOOP_PASS_CYCLES);
+	}
+
+	fflush(stdout);
+
+	if(sim_get_DAC_frame_error_count() != 0)
+	{
+		fprintf(stderr, "host: %u malformed AD5791 frames\n", (unsigned int)sim_get_DAC_frame_error_count());
+	}
+
+	if(capture_file_name != NULL)
+	{
+		write_DAC_capture(capture_file_name, capture, sim_get_DAC_capture_count());
+	}
+
+	free(capture);
+	free(Rx_bytes);
+
+	return(0);
+}
+
+/**
+ * \brief Slurps stdin, so a file of LSCP packets can be piped in and fed to the loopback as it makes room
+ *
+ * \param number_of_bytes how many were read
+ *
+ * \return char* the bytes, to be freed by the caller. Never NULL.
+ */
+char *read_all_of_stdin(uint32_t *number_of_bytes)
+{
+	uint32_t size = 4096;
+	uint32_t used = 0;
+	size_t bytes_read;
+	char *bytes = (char *)malloc(size);
+
+	while((bytes != NULL) && ((bytes_read = fread(&bytes[used], 1, size - used, stdin)) > 0))
+	{
+		used += (uint32_t)bytes_read;
+
+		if(used == size)
+		{
+			size *= 2;
+			bytes = (char *)realloc(bytes, size);
+		}
+	}
+
+	if(bytes == NULL)
+	{
+		fprintf(stderr, "host: out of memory reading stdin\n");
+		exit(1);
+	}
+
+	*number_of_bytes = used;
+	return(bytes);
+}
+
+/**
+ * \brief Writes the DAC register updates out as CSV
+ *
+ * \param file_name where to
+ * \param capture the updates
+ * \param count how many
+ *
+ * \return void
+ */
+void write_DAC_capture(const char *file_name, const sim_DAC_sample_type *capture, uint32_t count)
+{
+	FILE *file = fopen(file_name, "w");
+	uint32_t i;
+
+	if(file == NULL)
+	{
+		fprintf(stderr, "host: can't write %s\n", file_name);
+		return;
+	}
+
+	fprintf(file, "cycle,seconds,code\n");
+
+	for(i = 0; i < count; i++)
+	{
+		fprintf(file, "%llu,%.9f,%d\n", (unsigned long long)capture[i].cycle, (double)capture[i].cycle / SIM_CORE_CLOCK_FREQUENCY, (int)capture[i].code);
+	}
+
+	fclose(file);
+}
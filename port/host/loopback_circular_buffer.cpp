@@ -0,0 +1,96 @@
+/** @file loopback_circular_buffer.cpp
+ *  @brief Implementation file for the class declared in loopback_circular_buffer.h
+ *
+ *  Each buffer keeps one slot free, so head == tail always means empty.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "loopback_circular_buffer.h"
+
+void loopback_circular_buffer::init(char *Rx_buffer_ptr, uint32_t Rx_buffer_size_in_bytes, char *Tx_buffer_ptr, uint32_t Tx_buffer_size_in_bytes)
+{
+	rx_buffer = Rx_buffer_ptr;
+	rx_buffer_size = Rx_buffer_size_in_bytes;
+	rx_buffer_head_index = 0;
+	rx_buffer_tail_index = 0;
+
+	tx_buffer = Tx_buffer_ptr;
+	tx_buffer_size = Tx_buffer_size_in_bytes;
+	tx_buffer_head_index = 0;
+	tx_buffer_tail_index = 0;
+}
+
+char loopback_circular_buffer::get_latest_byte()
+{
+	char latest_byte;
+
+	if(rx_buffer_tail_index == rx_buffer_head_index)
+	{
+		return(0);
+	}
+
+	latest_byte = rx_buffer[rx_buffer_tail_index];
+	rx_buffer_tail_index = (rx_buffer_tail_index + 1) % rx_buffer_size;
+
+	return(latest_byte);
+}
+
+uint32_t loopback_circular_buffer::get_number_of_unread_bytes()
+{
+	return((rx_buffer_head_index + rx_buffer_size - rx_buffer_tail_index) % rx_buffer_size);
+}
+
+void loopback_circular_buffer::copy_packet_into_Tx_buffer_and_transmit(char* serialized_data_to_transmit, uint32_t number_of_bytes_to_transmit)
+{
+	uint32_t i;
+	uint32_t next_head_index;
+
+	for(i = 0; i < number_of_bytes_to_transmit; i++)
+	{
+		next_head_index = (tx_buffer_head_index + 1) % tx_buffer_size;
+
+		if(next_head_index == tx_buffer_tail_index)
+		{
+			break;                                  //far end isn't keeping up. A UART would have dropped them too.
+		}
+
+		tx_buffer[tx_buffer_head_index] = serialized_data_to_transmit[i];
+		tx_buffer_head_index = next_head_index;
+	}
+}
+
+uint32_t loopback_circular_buffer::write_Rx_bytes(const char *data, uint32_t number_of_bytes)
+{
+	uint32_t i;
+	uint32_t next_head_index;
+
+	for(i = 0; i < number_of_bytes; i++)
+	{
+		next_head_index = (rx_buffer_head_index + 1) % rx_buffer_size;
+
+		if(next_head_index == rx_buffer_tail_index)
+		{
+			break;
+		}
+
+		rx_buffer[rx_buffer_head_index] = data[i];
+		rx_buffer_head_index = next_head_index;
+	}
+
+	return(i);
+}
+
+uint32_t loopback_circular_buffer::read_Tx_bytes(char *data, uint32_t maximum_number_of_bytes)
+{
+	uint32_t i = 0;
+
+	while((i < maximum_number_of_bytes) && (tx_buffer_tail_index != tx_buffer_head_index))
+	{
+		data[i++] = tx_buffer[tx_buffer_tail_index];
+		tx_buffer_tail_index = (tx_buffer_tail_index + 1) % tx_buffer_size;
+	}
+
+	return(i);
+}
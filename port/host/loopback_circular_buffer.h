@@ -0,0 +1,76 @@
+/** @file loopback_circular_buffer.h
+ *  @brief class definition for the host build's loopback circular buffer
+ *
+ *  Stands in for serial_circular_buffer in the host build (see the host serial_circular_buffer_service.h), where there is
+ *  no UART PDC to feed it. The LSCP service reads and writes it through the same Icomms_circular_buffer interface, while
+ *  the far end (host_main.cpp, a test harness...) pushes incoming bytes in with write_Rx_bytes() and drains what was transmitted with read_Tx_bytes().
+ *
+ *  Both ends run on the one host thread, so nothing here is locked.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+
+#ifndef LOOPBACK_CIRCULAR_BUFFER_H_
+#define LOOPBACK_CIRCULAR_BUFFER_H_
+
+#include "sam.h"
+#include "Icomms_circular_buffer.h"
+
+class loopback_circular_buffer : public Icomms_circular_buffer
+{
+	public:
+		/**
+		 * @brief initialization routine, in place of a constructor to match serial_circular_buffer
+		 *
+		 * @param Rx_buffer_ptr pointer to the buffer that will hold bytes written in by the far end
+		 * @param Rx_buffer_size_in_bytes size of the Rx buffer, in bytes
+		 * @param Tx_buffer_ptr pointer to the buffer that will hold transmitted bytes until the far end reads them
+		 * @param Tx_buffer_size_in_bytes size of the Tx buffer, in bytes
+		 *
+		 * @return void
+		 */
+		void init(char *Rx_buffer_ptr,
+				  uint32_t Rx_buffer_size_in_bytes,
+				  char *Tx_buffer_ptr,
+				  uint32_t Tx_buffer_size_in_bytes);
+
+		char		get_latest_byte();
+		uint32_t	get_number_of_unread_bytes();
+		void		copy_packet_into_Tx_buffer_and_transmit(char* serialized_data_to_transmit, uint32_t number_of_bytes_to_transmit);
+
+		/**
+		 * @brief far end: queues bytes as if they had arrived over the UART
+		 *
+		 * @param data bytes to queue
+		 * @param number_of_bytes how many
+		 *
+		 * @return uint32_t bytes actually queued, fewer than asked when the Rx buffer fills
+		 */
+		uint32_t	write_Rx_bytes(const char *data, uint32_t number_of_bytes);
+
+		/**
+		 * @brief far end: takes bytes the LSCP service has transmitted
+		 *
+		 * @param data destination
+		 * @param maximum_number_of_bytes room in the destination
+		 *
+		 * @return uint32_t bytes copied out
+		 */
+		uint32_t	read_Tx_bytes(char *data, uint32_t maximum_number_of_bytes);
+
+	private:
+		char		*rx_buffer;
+		uint32_t	rx_buffer_size;
+		uint32_t	rx_buffer_head_index;
+		uint32_t	rx_buffer_tail_index;
+
+		char		*tx_buffer;
+		uint32_t	tx_buffer_size;
+		uint32_t	tx_buffer_head_index;
+		uint32_t	tx_buffer_tail_index;
+};
+
+
+#endif /* LOOPBACK_CIRCULAR_BUFFER_H_ */
@@ -0,0 +1,712 @@
+/** @file sam.h
+ *  @brief host stand-in for the Atmel SAM4E device header
+ *
+ *  Only used by the host build (see host_main.cpp). It declares the peripherals the firmware touches, with the same register
+ *  and bit names as the CMSIS device header, so port/HAL.h and everything above it compiles unchanged. Each register is a
+ *  sim_register rather than a volatile uint32_t, so reads and writes land in sam4e_sim.cpp, which gives them the
+ *  side effects the real peripheral would: TC_SR clears on read, PIO_SODR sets ODSR bits, writing PERIPH_TCR starts the PDC...
+ *
+ *  Register layouts don't follow the real offsets. Nothing in the firmware depends on them.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#ifndef SAM_H_
+#define SAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SAM4E_HOST_SIMULATION                   //code that can't run off target checks for this
+
+#define __I
+#define __O
+#define __IO
+
+class sim_register;
+
+//------------------------- Simulator hooks, implemented in sam4e_sim.cpp -------------------------
+uint32_t sim_read_register(sim_register *reg);
+void sim_write_register(sim_register *reg, uint32_t value);
+uint32_t sim_get_bus_address(const void *address);
+
+/**
+ * \brief One 32-bit peripheral register. Reads and writes go through the simulator so it can act on them.
+ */
+class sim_register
+{
+	public:
+		uint32_t value;                         //what the register holds, for registers with no read side effects
+
+		operator uint32_t() { return(sim_read_register(this)); }
+		sim_register &operator=(uint32_t new_value) { sim_write_register(this, new_value); return(*this); }
+		sim_register &operator|=(uint32_t bits) { sim_write_register(this, sim_read_register(this) | bits); return(*this); }
+		sim_register &operator&=(uint32_t bits) { sim_write_register(this, sim_read_register(this) & bits); return(*this); }
+};
+
+//The PDC is handed 32-bit addresses, which a 64-bit host pointer won't fit in. The simulator maps them, see sim_get_bus_address().
+#define PDC_BUS_ADDRESS(address)    sim_get_bus_address(address)
+
+//------------------------- Interrupts -------------------------
+typedef enum
+{
+	WDT_IRQn            = 4,
+	EFC_IRQn            = 6,
+	UART0_IRQn          = 7,
+	PIOA_IRQn           = 9,
+	PIOB_IRQn           = 10,
+	PIOC_IRQn           = 11,
+	PIOD_IRQn           = 12,
+	PIOE_IRQn           = 13,
+	SPI_IRQn            = 19,
+	TC0_IRQn            = 21,
+	TC1_IRQn            = 22,
+	TC2_IRQn            = 23,
+	TC3_IRQn            = 24,
+	TC4_IRQn            = 25,
+	TC5_IRQn            = 26,
+	TC6_IRQn            = 27,
+	TC7_IRQn            = 28,
+	TC8_IRQn            = 29,
+	UART1_IRQn          = 45,
+	PERIPH_COUNT_IRQn   = 47
+}IRQn_Type;
+
+extern "C"
+{
+	void PIOA_Handler(void);
+	void PIOB_Handler(void);
+	void PIOC_Handler(void);
+	void PIOD_Handler(void);
+	void PIOE_Handler(void);
+	void SPI_Handler(void);
+	void TC0_Handler(void);
+	void TC1_Handler(void);
+	void TC2_Handler(void);
+	void TC3_Handler(void);
+	void TC4_Handler(void);
+	void TC5_Handler(void);
+	void TC6_Handler(void);
+	void TC7_Handler(void);
+	void TC8_Handler(void);
+	void UART0_Handler(void);
+	void UART1_Handler(void);
+	void SystemInit(void);
+}
+
+extern uint32_t SystemCoreClock;
+
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+
+//------------------------- Core intrinsics -------------------------
+static inline int32_t __SSAT(int32_t value, uint32_t bits)
+{
+	int32_t maximum = (int32_t)((1u << (bits - 1)) - 1);
+	int32_t minimum = -maximum - 1;
+
+	return((value > maximum) ? maximum : ((value < minimum) ? minimum : value));
+}
+
+static inline uint32_t __CLZ(uint32_t value)
+{
+	return((value == 0) ? 32 : (uint32_t)__builtin_clz(value));
+}
+
+//accumulator + ((word * (int16_t)halfword) >> 16), as the target's one cycle SMLAWB does it
+#define SMLAWB(word, halfword, accumulator) ((int32_t)(accumulator) + (int32_t)(((int64_t)(int32_t)(word) * (int16_t)(halfword)) >> 16))
+
+//------------------------- Peripheral register blocks -------------------------
+typedef struct
+{
+	sim_register PIO_PER;
+	sim_register PIO_PDR;
+	sim_register PIO_PSR;
+	sim_register PIO_OER;
+	sim_register PIO_ODR;
+	sim_register PIO_OSR;
+	sim_register PIO_SODR;
+	sim_register PIO_CODR;
+	sim_register PIO_ODSR;
+	sim_register PIO_PDSR;
+	sim_register PIO_IER;
+	sim_register PIO_IDR;
+	sim_register PIO_IMR;
+	sim_register PIO_ISR;
+	sim_register PIO_PUDR;
+	sim_register PIO_PUER;
+	sim_register PIO_PUSR;
+	sim_register PIO_ABCDSR[2];
+	sim_register PIO_PPDDR;
+	sim_register PIO_PPDER;
+	sim_register PIO_PPDSR;
+	sim_register PIO_OWER;
+	sim_register PIO_OWDR;
+	sim_register PIO_OWSR;
+	sim_register PIO_AIMER;
+	sim_register PIO_AIMDR;
+	sim_register PIO_AIMMR;
+	sim_register PIO_ESR;
+	sim_register PIO_LSR;
+	sim_register PIO_ELSR;
+	sim_register PIO_FELLSR;
+	sim_register PIO_REHLSR;
+	sim_register PIO_FRLHSR;
+	sim_register PIO_WPMR;
+	sim_register PIO_WPSR;
+}Pio;
+
+typedef struct
+{
+	sim_register TC_CCR;
+	sim_register TC_CMR;
+	sim_register TC_SMMR;
+	sim_register TC_CV;
+	sim_register TC_RA;
+	sim_register TC_RB;
+	sim_register TC_RC;
+	sim_register TC_SR;
+	sim_register TC_IER;
+	sim_register TC_IDR;
+	sim_register TC_IMR;
+	sim_register TC_EMR;
+}TcChannel;
+
+typedef struct
+{
+	TcChannel TC_CHANNEL[3];
+	sim_register TC_BCR;
+	sim_register TC_BMR;
+	sim_register TC_WPMR;
+}Tc;
+
+typedef struct
+{
+	sim_register SPI_CR;
+	sim_register SPI_MR;
+	sim_register SPI_RDR;
+	sim_register SPI_TDR;
+	sim_register SPI_SR;
+	sim_register SPI_IER;
+	sim_register SPI_IDR;
+	sim_register SPI_IMR;
+	sim_register SPI_CSR[4];
+	sim_register SPI_WPMR;
+	sim_register SPI_WPSR;
+}Spi;
+
+typedef struct
+{
+	sim_register PERIPH_RPR;
+	sim_register PERIPH_RCR;
+	sim_register PERIPH_TPR;
+	sim_register PERIPH_TCR;
+	sim_register PERIPH_RNPR;
+	sim_register PERIPH_RNCR;
+	sim_register PERIPH_TNPR;
+	sim_register PERIPH_TNCR;
+	sim_register PERIPH_PTCR;
+	sim_register PERIPH_PTSR;
+}Pdc;
+
+typedef struct
+{
+	sim_register UART_CR;
+	sim_register UART_MR;
+	sim_register UART_IER;
+	sim_register UART_IDR;
+	sim_register UART_IMR;
+	sim_register UART_SR;
+	sim_register UART_RHR;
+	sim_register UART_THR;
+	sim_register UART_BRGR;
+}Uart;
+
+typedef struct
+{
+	sim_register US_CR;
+	sim_register US_MR;
+	sim_register US_WPMR;
+}Usart;
+
+typedef struct
+{
+	sim_register WDT_CR;
+	sim_register WDT_MR;
+	sim_register WDT_SR;
+}Wdt;
+
+typedef struct
+{
+	sim_register RSTC_CR;
+	sim_register RSTC_SR;
+	sim_register RSTC_MR;
+}Rstc;
+
+typedef struct
+{
+	sim_register EEFC_FMR;
+	sim_register EEFC_FCR;
+	sim_register EEFC_FSR;
+	sim_register EEFC_FRR;
+}Efc;
+
+typedef struct
+{
+	sim_register PMC_PCER0;
+	sim_register PMC_PCER1;
+}Pmc;
+
+typedef struct
+{
+	sim_register CPACR;
+}SCB_Type;
+
+typedef struct
+{
+	sim_register CTRL;
+	sim_register CYCCNT;
+}DWT_Type;
+
+typedef struct
+{
+	sim_register DEMCR;
+}CoreDebug_Type;
+
+extern Pio sim_PIOA, sim_PIOB, sim_PIOC, sim_PIOD, sim_PIOE;
+extern Tc sim_TC0, sim_TC1, sim_TC2;
+extern Spi sim_SPI;
+extern Pdc sim_PDC_SPI, sim_PDC_UART0, sim_PDC_UART1;
+extern Uart sim_UART0, sim_UART1;
+extern Usart sim_USART0, sim_USART1;
+extern Wdt sim_WDT;
+extern Rstc sim_RSTC;
+extern Efc sim_EFC;
+extern Pmc sim_PMC;
+extern SCB_Type sim_SCB;
+extern DWT_Type sim_DWT;
+extern CoreDebug_Type sim_CoreDebug;
+
+#define PIOA            (&sim_PIOA)
+#define PIOB            (&sim_PIOB)
+#define PIOC            (&sim_PIOC)
+#define PIOD            (&sim_PIOD)
+#define PIOE            (&sim_PIOE)
+#define TC0             (&sim_TC0)
+#define TC1             (&sim_TC1)
+#define TC2             (&sim_TC2)
+#define SPI             (&sim_SPI)
+#define PDC_SPI         (&sim_PDC_SPI)
+#define UART0           (&sim_UART0)
+#define UART1           (&sim_UART1)
+#define PDC_UART0       (&sim_PDC_UART0)
+#define PDC_UART1       (&sim_PDC_UART1)
+#define USART0          (&sim_USART0)
+#define USART1          (&sim_USART1)
+#define WDT             (&sim_WDT)
+#define RSTC            (&sim_RSTC)
+#define EFC             (&sim_EFC)
+#define PMC             (&sim_PMC)
+#define SCB             (&sim_SCB)
+#define DWT             (&sim_DWT)
+#define CoreDebug       (&sim_CoreDebug)
+
+//------------------------- PIO bits -------------------------
+#define PIO_PER_P0          (0x1u << 0)
+#define PIO_PER_P1          (0x1u << 1)
+#define PIO_PER_P2          (0x1u << 2)
+#define PIO_PER_P3          (0x1u << 3)
+#define PIO_PER_P4          (0x1u << 4)
+#define PIO_PER_P5          (0x1u << 5)
+#define PIO_PER_P6          (0x1u << 6)
+#define PIO_PER_P7          (0x1u << 7)
+#define PIO_PER_P8          (0x1u << 8)
+#define PIO_PER_P9          (0x1u << 9)
+#define PIO_PER_P10         (0x1u << 10)
+#define PIO_PER_P11         (0x1u << 11)
+#define PIO_PER_P12         (0x1u << 12)
+#define PIO_PER_P13         (0x1u << 13)
+#define PIO_PER_P14         (0x1u << 14)
+#define PIO_PER_P15         (0x1u << 15)
+#define PIO_PER_P16         (0x1u << 16)
+#define PIO_PER_P17         (0x1u << 17)
+#define PIO_PER_P18         (0x1u << 18)
+#define PIO_PER_P19         (0x1u << 19)
+#define PIO_PER_P20         (0x1u << 20)
+#define PIO_PER_P21         (0x1u << 21)
+#define PIO_PER_P22         (0x1u << 22)
+#define PIO_PER_P23         (0x1u << 23)
+#define PIO_PER_P24         (0x1u << 24)
+#define PIO_PER_P25         (0x1u << 25)
+#define PIO_PER_P26         (0x1u << 26)
+#define PIO_PER_P27         (0x1u << 27)
+#define PIO_PER_P28         (0x1u << 28)
+#define PIO_PER_P29         (0x1u << 29)
+#define PIO_PER_P30         (0x1u << 30)
+#define PIO_PER_P31         (0x1u << 31)
+
+#define PIO_PDR_P0          (0x1u << 0)
+#define PIO_PDR_P1          (0x1u << 1)
+#define PIO_PDR_P2          (0x1u << 2)
+#define PIO_PDR_P3          (0x1u << 3)
+#define PIO_PDR_P4          (0x1u << 4)
+#define PIO_PDR_P5          (0x1u << 5)
+#define PIO_PDR_P6          (0x1u << 6)
+#define PIO_PDR_P7          (0x1u << 7)
+#define PIO_PDR_P8          (0x1u << 8)
+#define PIO_PDR_P9          (0x1u << 9)
+#define PIO_PDR_P10         (0x1u << 10)
+#define PIO_PDR_P11         (0x1u << 11)
+#define PIO_PDR_P12         (0x1u << 12)
+#define PIO_PDR_P13         (0x1u << 13)
+#define PIO_PDR_P14         (0x1u << 14)
+#define PIO_PDR_P15         (0x1u << 15)
+#define PIO_PDR_P16         (0x1u << 16)
+#define PIO_PDR_P17         (0x1u << 17)
+#define PIO_PDR_P18         (0x1u << 18)
+#define PIO_PDR_P19         (0x1u << 19)
+#define PIO_PDR_P20         (0x1u << 20)
+#define PIO_PDR_P21         (0x1u << 21)
+#define PIO_PDR_P22         (0x1u << 22)
+#define PIO_PDR_P23         (0x1u << 23)
+#define PIO_PDR_P24         (0x1u << 24)
+#define PIO_PDR_P25         (0x1u << 25)
+#define PIO_PDR_P26         (0x1u << 26)
+#define PIO_PDR_P27         (0x1u << 27)
+#define PIO_PDR_P28         (0x1u << 28)
+#define PIO_PDR_P29         (0x1u << 29)
+#define PIO_PDR_P30         (0x1u << 30)
+#define PIO_PDR_P31         (0x1u << 31)
+
+#define PIO_SODR_P0         (0x1u << 0)
+#define PIO_SODR_P1         (0x1u << 1)
+#define PIO_SODR_P2         (0x1u << 2)
+#define PIO_SODR_P3         (0x1u << 3)
+#define PIO_SODR_P4         (0x1u << 4)
+#define PIO_SODR_P5         (0x1u << 5)
+#define PIO_SODR_P6         (0x1u << 6)
+#define PIO_SODR_P7         (0x1u << 7)
+#define PIO_SODR_P8         (0x1u << 8)
+#define PIO_SODR_P9         (0x1u << 9)
+#define PIO_SODR_P10        (0x1u << 10)
+#define PIO_SODR_P11        (0x1u << 11)
+#define PIO_SODR_P12        (0x1u << 12)
+#define PIO_SODR_P13        (0x1u << 13)
+#define PIO_SODR_P14        (0x1u << 14)
+#define PIO_SODR_P15        (0x1u << 15)
+#define PIO_SODR_P16        (0x1u << 16)
+#define PIO_SODR_P17        (0x1u << 17)
+#define PIO_SODR_P18        (0x1u << 18)
+#define PIO_SODR_P19        (0x1u << 19)
+#define PIO_SODR_P20        (0x1u << 20)
+#define PIO_SODR_P21        (0x1u << 21)
+#define PIO_SODR_P22        (0x1u << 22)
+#define PIO_SODR_P23        (0x1u << 23)
+#define PIO_SODR_P24        (0x1u << 24)
+#define PIO_SODR_P25        (0x1u << 25)
+#define PIO_SODR_P26        (0x1u << 26)
+#define PIO_SODR_P27        (0x1u << 27)
+#define PIO_SODR_P28        (0x1u << 28)
+#define PIO_SODR_P29        (0x1u << 29)
+#define PIO_SODR_P30        (0x1u << 30)
+#define PIO_SODR_P31        (0x1u << 31)
+
+#define PIO_CODR_P0         (0x1u << 0)
+#define PIO_CODR_P1         (0x1u << 1)
+#define PIO_CODR_P2         (0x1u << 2)
+#define PIO_CODR_P3         (0x1u << 3)
+#define PIO_CODR_P4         (0x1u << 4)
+#define PIO_CODR_P5         (0x1u << 5)
+#define PIO_CODR_P6         (0x1u << 6)
+#define PIO_CODR_P7         (0x1u << 7)
+#define PIO_CODR_P8         (0x1u << 8)
+#define PIO_CODR_P9         (0x1u << 9)
+#define PIO_CODR_P10        (0x1u << 10)
+#define PIO_CODR_P11        (0x1u << 11)
+#define PIO_CODR_P12        (0x1u << 12)
+#define PIO_CODR_P13        (0x1u << 13)
+#define PIO_CODR_P14        (0x1u << 14)
+#define PIO_CODR_P15        (0x1u << 15)
+#define PIO_CODR_P16        (0x1u << 16)
+#define PIO_CODR_P17        (0x1u << 17)
+#define PIO_CODR_P18        (0x1u << 18)
+#define PIO_CODR_P19        (0x1u << 19)
+#define PIO_CODR_P20        (0x1u << 20)
+#define PIO_CODR_P21        (0x1u << 21)
+#define PIO_CODR_P22        (0x1u << 22)
+#define PIO_CODR_P23        (0x1u << 23)
+#define PIO_CODR_P24        (0x1u << 24)
+#define PIO_CODR_P25        (0x1u << 25)
+#define PIO_CODR_P26        (0x1u << 26)
+#define PIO_CODR_P27        (0x1u << 27)
+#define PIO_CODR_P28        (0x1u << 28)
+#define PIO_CODR_P29        (0x1u << 29)
+#define PIO_CODR_P30        (0x1u << 30)
+#define PIO_CODR_P31        (0x1u << 31)
+
+#define PIO_ODSR_P0         (0x1u << 0)
+#define PIO_ODSR_P1         (0x1u << 1)
+#define PIO_ODSR_P2         (0x1u << 2)
+#define PIO_ODSR_P3         (0x1u << 3)
+#define PIO_ODSR_P4         (0x1u << 4)
+#define PIO_ODSR_P5         (0x1u << 5)
+#define PIO_ODSR_P6         (0x1u << 6)
+#define PIO_ODSR_P7         (0x1u << 7)
+#define PIO_ODSR_P8         (0x1u << 8)
+#define PIO_ODSR_P9         (0x1u << 9)
+#define PIO_ODSR_P10        (0x1u << 10)
+#define PIO_ODSR_P11        (0x1u << 11)
+#define PIO_ODSR_P12        (0x1u << 12)
+#define PIO_ODSR_P13        (0x1u << 13)
+#define PIO_ODSR_P14        (0x1u << 14)
+#define PIO_ODSR_P15        (0x1u << 15)
+#define PIO_ODSR_P16        (0x1u << 16)
+#define PIO_ODSR_P17        (0x1u << 17)
+#define PIO_ODSR_P18        (0x1u << 18)
+#define PIO_ODSR_P19        (0x1u << 19)
+#define PIO_ODSR_P20        (0x1u << 20)
+#define PIO_ODSR_P21        (0x1u << 21)
+#define PIO_ODSR_P22        (0x1u << 22)
+#define PIO_ODSR_P23        (0x1u << 23)
+#define PIO_ODSR_P24        (0x1u << 24)
+#define PIO_ODSR_P25        (0x1u << 25)
+#define PIO_ODSR_P26        (0x1u << 26)
+#define PIO_ODSR_P27        (0x1u << 27)
+#define PIO_ODSR_P28        (0x1u << 28)
+#define PIO_ODSR_P29        (0x1u << 29)
+#define PIO_ODSR_P30        (0x1u << 30)
+#define PIO_ODSR_P31        (0x1u << 31)
+
+#define PIO_PDSR_P0         (0x1u << 0)
+#define PIO_PDSR_P1         (0x1u << 1)
+#define PIO_PDSR_P2         (0x1u << 2)
+#define PIO_PDSR_P3         (0x1u << 3)
+#define PIO_PDSR_P4         (0x1u << 4)
+#define PIO_PDSR_P5         (0x1u << 5)
+#define PIO_PDSR_P6         (0x1u << 6)
+#define PIO_PDSR_P7         (0x1u << 7)
+#define PIO_PDSR_P8         (0x1u << 8)
+#define PIO_PDSR_P9         (0x1u << 9)
+#define PIO_PDSR_P10        (0x1u << 10)
+#define PIO_PDSR_P11        (0x1u << 11)
+#define PIO_PDSR_P12        (0x1u << 12)
+#define PIO_PDSR_P13        (0x1u << 13)
+#define PIO_PDSR_P14        (0x1u << 14)
+#define PIO_PDSR_P15        (0x1u << 15)
+#define PIO_PDSR_P16        (0x1u << 16)
+#define PIO_PDSR_P17        (0x1u << 17)
+#define PIO_PDSR_P18        (0x1u << 18)
+#define PIO_PDSR_P19        (0x1u << 19)
+#define PIO_PDSR_P20        (0x1u << 20)
+#define PIO_PDSR_P21        (0x1u << 21)
+#define PIO_PDSR_P22        (0x1u << 22)
+#define PIO_PDSR_P23        (0x1u << 23)
+#define PIO_PDSR_P24        (0x1u << 24)
+#define PIO_PDSR_P25        (0x1u << 25)
+#define PIO_PDSR_P26        (0x1u << 26)
+#define PIO_PDSR_P27        (0x1u << 27)
+#define PIO_PDSR_P28        (0x1u << 28)
+#define PIO_PDSR_P29        (0x1u << 29)
+#define PIO_PDSR_P30        (0x1u << 30)
+#define PIO_PDSR_P31        (0x1u << 31)
+
+#define PIO_ABCDSR_P0       (0x1u << 0)
+#define PIO_ABCDSR_P1       (0x1u << 1)
+#define PIO_ABCDSR_P2       (0x1u << 2)
+#define PIO_ABCDSR_P3       (0x1u << 3)
+#define PIO_ABCDSR_P4       (0x1u << 4)
+#define PIO_ABCDSR_P5       (0x1u << 5)
+#define PIO_ABCDSR_P6       (0x1u << 6)
+#define PIO_ABCDSR_P7       (0x1u << 7)
+#define PIO_ABCDSR_P8       (0x1u << 8)
+#define PIO_ABCDSR_P9       (0x1u << 9)
+#define PIO_ABCDSR_P10      (0x1u << 10)
+#define PIO_ABCDSR_P11      (0x1u << 11)
+#define PIO_ABCDSR_P12      (0x1u << 12)
+#define PIO_ABCDSR_P13      (0x1u << 13)
+#define PIO_ABCDSR_P14      (0x1u << 14)
+#define PIO_ABCDSR_P15      (0x1u << 15)
+#define PIO_ABCDSR_P16      (0x1u << 16)
+#define PIO_ABCDSR_P17      (0x1u << 17)
+#define PIO_ABCDSR_P18      (0x1u << 18)
+#define PIO_ABCDSR_P19      (0x1u << 19)
+#define PIO_ABCDSR_P20      (0x1u << 20)
+#define PIO_ABCDSR_P21      (0x1u << 21)
+#define PIO_ABCDSR_P22      (0x1u << 22)
+#define PIO_ABCDSR_P23      (0x1u << 23)
+#define PIO_ABCDSR_P24      (0x1u << 24)
+#define PIO_ABCDSR_P25      (0x1u << 25)
+#define PIO_ABCDSR_P26      (0x1u << 26)
+#define PIO_ABCDSR_P27      (0x1u << 27)
+#define PIO_ABCDSR_P28      (0x1u << 28)
+#define PIO_ABCDSR_P29      (0x1u << 29)
+#define PIO_ABCDSR_P30      (0x1u << 30)
+#define PIO_ABCDSR_P31      (0x1u << 31)
+#define PIO_WPMR_WPEN               (0x1u << 0)
+#define PIO_WPMR_WPKEY(value)       ((0xFFFFFFu & (value)) << 8)
+
+//------------------------- TC bits -------------------------
+#define TC_CCR_CLKEN                (0x1u << 0)
+#define TC_CCR_CLKDIS               (0x1u << 1)
+#define TC_CCR_SWTRG                (0x1u << 2)
+
+#define TC_CMR_TCCLKS_Msk           (0x7u << 0)
+#define TC_CMR_TCCLKS_TIMER_CLOCK1  (0x0u << 0)         //MCK/2
+#define TC_CMR_TCCLKS_TIMER_CLOCK2  (0x1u << 0)         //MCK/8
+#define TC_CMR_TCCLKS_TIMER_CLOCK3  (0x2u << 0)         //MCK/32
+#define TC_CMR_TCCLKS_TIMER_CLOCK4  (0x3u << 0)         //MCK/128
+#define TC_CMR_TCCLKS_TIMER_CLOCK5  (0x4u << 0)         //SLCK
+#define TC_CMR_CPCSTOP              (0x1u << 6)
+#define TC_CMR_CPCDIS               (0x1u << 7)
+#define TC_CMR_ABETRG               (0x1u << 10)
+#define TC_CMR_WAVSEL_Msk           (0x3u << 13)
+#define TC_CMR_WAVSEL_UP            (0x0u << 13)
+#define TC_CMR_WAVSEL_UP_RC         (0x2u << 13)
+#define TC_CMR_WAVE                 (0x1u << 15)
+#define TC_CMR_LDRA_Msk             (0x3u << 16)
+#define TC_CMR_LDRA_RISING          (0x1u << 16)
+#define TC_CMR_LDRA_FALLING         (0x2u << 16)
+#define TC_CMR_LDRA_EDGE            (0x3u << 16)
+#define TC_CMR_ACPA_Msk             (0x3u << 16)
+#define TC_CMR_ACPA_SET             (0x1u << 16)
+#define TC_CMR_ACPA_CLEAR           (0x2u << 16)
+#define TC_CMR_ACPA_TOGGLE          (0x3u << 16)
+#define TC_CMR_ACPC_Msk             (0x3u << 18)
+#define TC_CMR_ACPC_SET             (0x1u << 18)
+#define TC_CMR_ACPC_CLEAR           (0x2u << 18)
+#define TC_CMR_ACPC_TOGGLE          (0x3u << 18)
+
+#define TC_RA_RA(value)             (0xFFFFu & (value))
+#define TC_RC_RC(value)             (0xFFFFu & (value))
+
+#define TC_SR_COVFS                 (0x1u << 0)
+#define TC_SR_LOVRS                 (0x1u << 1)
+#define TC_SR_CPAS                  (0x1u << 2)
+#define TC_SR_CPBS                  (0x1u << 3)
+#define TC_SR_CPCS                  (0x1u << 4)
+#define TC_SR_LDRAS                 (0x1u << 5)
+#define TC_SR_LDRBS                 (0x1u << 6)
+#define TC_SR_ETRGS                 (0x1u << 7)
+#define TC_SR_CLKSTA                (0x1u << 16)
+#define TC_SR_MTIOA                 (0x1u << 17)
+
+#define TC_IER_COVFS                TC_SR_COVFS
+#define TC_IER_CPCS                 TC_SR_CPCS
+#define TC_IER_LDRAS                TC_SR_LDRAS
+#define TC_IDR_COVFS                TC_SR_COVFS
+#define TC_IDR_CPCS                 TC_SR_CPCS
+#define TC_IDR_LDRAS                TC_SR_LDRAS
+
+#define TC_EMR_NODIVCLK             (0x1u << 8)
+
+//------------------------- SPI bits -------------------------
+#define SPI_CR_SPIEN                (0x1u << 0)
+#define SPI_CR_SPIDIS               (0x1u << 1)
+#define SPI_CR_SWRST                (0x1u << 7)
+
+#define SPI_MR_MSTR                 (0x1u << 0)
+#define SPI_MR_PS                   (0x1u << 1)
+#define SPI_MR_MODFDIS              (0x1u << 4)
+#define SPI_MR_PCS(value)           ((0xFu & (value)) << 16)
+#define SPI_MR_DLYBCS_Pos           24
+#define SPI_MR_DLYBCS(value)        ((0xFFu & (value)) << SPI_MR_DLYBCS_Pos)
+
+#define SPI_TDR_TD(value)           (0xFFFFu & (value))
+#define SPI_TDR_PCS_Pos             16
+#define SPI_TDR_PCS(value)          ((0xFu & (value)) << SPI_TDR_PCS_Pos)
+#define SPI_TDR_LASTXFER            (0x1u << 24)
+
+#define SPI_SR_TDRE                 (0x1u << 1)
+#define SPI_SR_ENDTX                (0x1u << 5)
+#define SPI_SR_TXBUFE               (0x1u << 7)
+#define SPI_SR_TXEMPTY              (0x1u << 9)
+#define SPI_SR_SPIENS               (0x1u << 16)
+
+#define SPI_IER_ENDTX               SPI_SR_ENDTX
+#define SPI_IER_TXBUFE              SPI_SR_TXBUFE
+#define SPI_IDR_ENDTX               SPI_SR_ENDTX
+#define SPI_IDR_TXBUFE              SPI_SR_TXBUFE
+
+#define SPI_CSR_CSAAT               (0x1u << 3)
+#define SPI_CSR_BITS_8_BIT          (0x0u << 4)
+#define SPI_CSR_SCBR_Pos            8
+#define SPI_CSR_SCBR(value)         ((0xFFu & (value)) << SPI_CSR_SCBR_Pos)
+#define SPI_CSR_DLYBS_Pos           16
+#define SPI_CSR_DLYBS(value)        ((0xFFu & (value)) << SPI_CSR_DLYBS_Pos)
+#define SPI_CSR_DLYBCT_Pos          24
+#define SPI_CSR_DLYBCT(value)       ((0xFFu & (value)) << SPI_CSR_DLYBCT_Pos)
+
+#define SPI_WPMR_WPEN               (0x1u << 0)
+#define SPI_WPMR_WPKEY(value)       ((0xFFFFFFu & (value)) << 8)
+
+//------------------------- PDC bits -------------------------
+#define PERIPH_PTCR_RXTEN           (0x1u << 0)
+#define PERIPH_PTCR_RXTDIS          (0x1u << 1)
+#define PERIPH_PTCR_TXTEN           (0x1u << 8)
+#define PERIPH_PTCR_TXTDIS          (0x1u << 9)
+#define PERIPH_PTSR_TXTEN           (0x1u << 8)
+
+//------------------------- UART bits -------------------------
+#define UART_CR_RSTRX               (0x1u << 2)
+#define UART_CR_RSTTX               (0x1u << 3)
+#define UART_CR_RXEN                (0x1u << 4)
+#define UART_CR_RXDIS               (0x1u << 5)
+#define UART_CR_TXEN                (0x1u << 6)
+#define UART_CR_TXDIS               (0x1u << 7)
+#define UART_CR_RSTSTA              (0x1u << 8)
+#define UART_MR_PAR_NO              (0x4u << 9)
+#define UART_SR_RXRDY               (0x1u << 0)
+#define UART_SR_TXRDY               (0x1u << 1)
+#define UART_SR_OVRE                (0x1u << 5)
+#define UART_SR_TXEMPTY             (0x1u << 9)
+#define UART_SR_TXBUFE              (0x1u << 11)
+#define UART_SR_RXBUFF              (0x1u << 12)
+#define UART_IER_RXRDY              UART_SR_RXRDY
+#define UART_IER_TXBUFE             UART_SR_TXBUFE
+#define UART_IER_RXBUFF             UART_SR_RXBUFF
+#define UART_IDR_RXRDY              UART_SR_RXRDY
+#define UART_IDR_TXBUFE             UART_SR_TXBUFE
+#define UART_IDR_RXBUFF             UART_SR_RXBUFF
+#define UART_BRGR_CD(value)         (0xFFFFu & (value))
+
+#define US_WPMR_WPEN                (0x1u << 0)
+#define US_WPMR_WPKEY(value)        ((0xFFFFFFu & (value)) << 8)
+
+//------------------------- WDT, RSTC and EFC bits -------------------------
+#define WDT_CR_WDRSTT               (0x1u << 0)
+#define WDT_CR_KEY(value)           ((0xFFu & (value)) << 24)
+#define WDT_MR_WDV_Msk              (0xFFFu << 0)
+#define WDT_MR_WDV(value)           (0xFFFu & (value))
+#define WDT_MR_WDRSTEN              (0x1u << 13)
+#define WDT_MR_WDDIS                (0x1u << 15)
+#define WDT_MR_WDDBGHLT             (0x1u << 28)
+#define WDT_MR_WDIDLEHLT            (0x1u << 29)
+#define WDT_SR_WDUNF                (0x1u << 0)
+
+#define RSTC_CR_PROCRST             (0x1u << 0)
+#define RSTC_CR_PERRST              (0x1u << 2)
+#define RSTC_CR_EXTRST              (0x1u << 3)
+
+#define EEFC_FCR_FCMD_Msk           (0xFFu << 0)
+#define EEFC_FCR_FCMD_SGPB          (0x0Bu << 0)
+#define EEFC_FCR_FCMD_CGPB          (0x0Cu << 0)
+#define EEFC_FCR_FCMD_GGPB          (0x0Du << 0)
+#define EEFC_FCR_FARG_Pos           8
+#define EEFC_FCR_FARG(value)        ((0xFFFFu & (value)) << EEFC_FCR_FARG_Pos)
+#define EEFC_FCR_FKEY_Msk           (0xFFu << 24)
+#define EEFC_FCR_FKEY_PASSWD        (0x5Au << 24)
+#define EEFC_FSR_FRDY               (0x1u << 0)
+#define EEFC_FSR_FCMDE              (0x1u << 1)
+
+//------------------------- Core debug bits -------------------------
+#define DWT_CTRL_CYCCNTENA_Msk      (0x1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (0x1u << 24)
+
+#endif /* SAM_H_ */
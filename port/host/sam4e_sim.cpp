@@ -0,0 +1,1646 @@
+/** @file sam4e_sim.cpp
+ *  @brief Implementation file for the prototypes declared in the sam4e_sim.h interface module, and for the registers,
+ *  NVIC functions and intrinsics the host sam.h declares.
+ *
+ *  Every read or write of a sim_register comes through sim_read_register() or sim_write_register(), which work out
+ *  which peripheral it belongs to from its address. Registers with no side effects simply keep their value.
+ *
+ *  Peripherals that act over time (the TC channels, the SPI shifter, the watchdog and the flash controller) each report
+ *  the cycle of their next event. run_until() steps from one event to the next, and after each step, and after any
+ *  register write, whatever interrupt has come pending is called.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "sam4e_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma region "defintions and variables restricted to the scope of this module"
+
+#define SIM_NO_EVENT                UINT64_MAX
+#define SIM_NUMBER_OF_TC_CHANNELS   9
+#define SIM_SAMPLE_TIMER_CHANNEL    3           //TC1 channel 0, whose TIOA3 is the AD5791's LDAC
+#define SIM_SYNC_IN_CHANNEL         5           //TC1 channel 2, whose TIOA5 is the sync in on PC29
+#define SIM_THREAD_PRIORITY         256         //below every NVIC priority
+#define SIM_BUS_ADDRESS_BASE        0x80000000u //where sim_bus_anchor sits on the simulated bus
+#define SIM_UART_FIFO_SIZE          256
+#define SIM_TC_COUNTER_WRAP         0x10000u    //16-bit counters
+#define SIM_TC_STATUS_CLEARED_ON_READ 0xFFu
+#define SIM_AD5791_FRAME_BITS       24
+#define SIM_SPI_MINIMUM_DLYBCS      6           //MCK cycles chip select stays high between transfers, whatever DLYBCS says
+#define SIM_AD5791_CONTROL_RESET    0x0000Eu    //RBUF, OPGND and DACTRI set
+
+#define IS_REGISTER_OF(reg, block)  (((const char *)(reg) >= (const char *)&(block)) && ((const char *)(reg) < (const char *)&(block) + sizeof(block)))
+
+Pio sim_PIOA, sim_PIOB, sim_PIOC, sim_PIOD, sim_PIOE;
+Tc sim_TC0, sim_TC1, sim_TC2;
+Spi sim_SPI;
+Pdc sim_PDC_SPI, sim_PDC_UART0, sim_PDC_UART1;
+Uart sim_UART0, sim_UART1;
+Usart sim_USART0, sim_USART1;
+Wdt sim_WDT;
+Rstc sim_RSTC;
+Efc sim_EFC;
+Pmc sim_PMC;
+SCB_Type sim_SCB;
+DWT_Type sim_DWT;
+CoreDebug_Type sim_CoreDebug;
+
+uint32_t SystemCoreClock = SIM_CORE_CLOCK_FREQUENCY;
+
+char sim_bus_anchor;                            //PDC bus addresses are offsets from here
+
+struct sim_tc_channel
+{
+	TcChannel *registers;
+	uint32_t count;                             //counter value at base_cycle
+	uint64_t base_cycle;                        //always on a counter clock edge
+	uint32_t status;                            //SR bits that clear on read
+	bool is_clock_enabled;
+	bool is_stopped;                            //CPCSTOP, until the next trigger
+	bool tioa;
+	bool tioa_input;                            //capture mode, the level on the pin
+};
+
+struct sim_spi
+{
+	bool is_enabled;
+	bool is_tdr_full;
+	uint32_t tdr_word;
+	bool is_shifter_busy;
+	uint32_t shifter_word;
+	uint64_t shifter_done_cycle;
+	bool is_chip_select_asserted;
+	uint64_t chip_select_ready_cycle;           //DLYBCS, the earliest it can assert again
+	bool is_end_of_tx_latched;
+};
+
+struct sim_AD5791
+{
+	uint32_t shift_register;
+	uint32_t bits_shifted;                      //since SYNC fell
+	uint32_t input_register;
+	int32_t DAC_register;
+	uint32_t control_register;
+	bool is_LDAC_high;
+	uint32_t frame_errors;
+	sim_DAC_sample_type *capture;
+	uint32_t capture_size;
+	uint32_t capture_count;
+};
+
+struct sim_pio
+{
+	Pio *registers;
+	uint32_t input_levels;
+};
+
+struct sim_uart_fifo
+{
+	char data[SIM_UART_FIFO_SIZE];
+	uint32_t head;
+	uint32_t tail;
+};
+
+struct sim_uart
+{
+	Uart *registers;
+	struct sim_uart_fifo rx;
+	struct sim_uart_fifo tx;
+};
+
+struct sim_wdt
+{
+	bool is_mode_written;                       //WDT_MR can only be written once
+	bool is_enabled;
+	bool is_reset_enabled;
+	uint64_t period_cycles;
+	uint64_t expiry_cycle;
+};
+
+struct sim_efc
+{
+	bool is_busy;
+	bool is_command_error;
+	uint32_t command;
+	uint64_t done_cycle;
+	uint32_t GPNVM_bits;
+};
+
+struct sim_nvic
+{
+	bool is_enabled[PERIPH_COUNT_IRQn];
+	uint32_t priority[PERIPH_COUNT_IRQn];
+	void (*handler[PERIPH_COUNT_IRQn])(void);
+	uint64_t last_dispatch_cycle[PERIPH_COUNT_IRQn];
+	uint32_t dispatches_this_cycle[PERIPH_COUNT_IRQn];
+	uint32_t active_priority;
+	bool is_primask_set;
+};
+
+struct sim_data
+{
+	uint64_t cycle;
+	struct sim_tc_channel tc[SIM_NUMBER_OF_TC_CHANNELS];
+	struct sim_pio pio[5];
+	struct sim_spi spi;
+	struct sim_AD5791 DAC;
+	struct sim_uart uart[2];
+	struct sim_wdt wdt;
+	struct sim_efc efc;
+	struct sim_nvic nvic;
+	uint32_t cycle_counter_offset;              //DWT CYCCNT = cycle + offset
+	uint32_t reset_count;
+};
+
+struct sim_data sim;
+
+static void run_until(uint64_t target_cycle);
+static void advance_for_status_poll(void);
+static void dispatch_interrupts(void);
+
+static uint32_t get_tc_divisor(struct sim_tc_channel *channel);
+static void sync_tc_counter(struct sim_tc_channel *channel);
+static uint64_t get_next_tc_event_cycle(struct sim_tc_channel *channel);
+static void process_tc_event(struct sim_tc_channel *channel);
+static void apply_tc_output_action(struct sim_tc_channel *channel, uint32_t action);
+static void set_tc_capture_input(struct sim_tc_channel *channel, bool level);
+static uint32_t read_tc_register(struct sim_tc_channel *channel, sim_register *reg);
+static void write_tc_register(struct sim_tc_channel *channel, sim_register *reg, uint32_t value);
+
+static uint32_t read_pio_register(struct sim_pio *pio, sim_register *reg);
+static void write_pio_register(struct sim_pio *pio, sim_register *reg, uint32_t value);
+static void update_pio_level_interrupts(struct sim_pio *pio);
+static struct sim_pio *get_pio(Pio *pio);
+
+static void *get_host_address(uint32_t bus_address);
+static void service_spi(void);
+static void process_spi_event(void);
+static uint32_t read_spi_register(sim_register *reg);
+static void write_spi_register(sim_register *reg, uint32_t value);
+static void write_spi_pdc_register(sim_register *reg, uint32_t value);
+
+static void shift_AD5791_byte(uint8_t data_byte);
+static void raise_AD5791_SYNC(void);
+static void set_AD5791_LDAC(bool is_high);
+static void update_AD5791_DAC_register(void);
+
+static uint32_t read_uart_register(struct sim_uart *uart, sim_register *reg);
+static void write_uart_register(struct sim_uart *uart, sim_register *reg, uint32_t value);
+static bool push_uart_fifo(struct sim_uart_fifo *fifo, char data);
+static bool pop_uart_fifo(struct sim_uart_fifo *fifo, char *data);
+static struct sim_uart *get_uart(Uart *uart);
+
+static void write_wdt_register(sim_register *reg, uint32_t value);
+static void process_wdt_event(void);
+static void write_efc_register(sim_register *reg, uint32_t value);
+static void process_efc_event(void);
+static void request_reset(const char *reason);
+
+static bool is_irq_pending(uint32_t IRQn);
+
+#pragma endregion "defintions and variables restricted to the scope of this module"
+
+#pragma region "Simulator Control Functions"
+
+void sim_reset(void)
+{
+	Tc *tc_blocks[3] = {&sim_TC0, &sim_TC1, &sim_TC2};
+	Pio *pio_blocks[5] = {&sim_PIOA, &sim_PIOB, &sim_PIOC, &sim_PIOD, &sim_PIOE};
+	sim_DAC_sample_type *capture = sim.DAC.capture;
+	uint32_t capture_size = sim.DAC.capture_size;
+	uint32_t i;
+
+	memset((void *)&sim_PIOA, 0, sizeof(Pio));
+	memset((void *)&sim_PIOB, 0, sizeof(Pio));
+	memset((void *)&sim_PIOC, 0, sizeof(Pio));
+	memset((void *)&sim_PIOD, 0, sizeof(Pio));
+	memset((void *)&sim_PIOE, 0, sizeof(Pio));
+	memset((void *)&sim_TC0, 0, sizeof(Tc));
+	memset((void *)&sim_TC1, 0, sizeof(Tc));
+	memset((void *)&sim_TC2, 0, sizeof(Tc));
+	memset((void *)&sim_SPI, 0, sizeof(Spi));
+	memset((void *)&sim_PDC_SPI, 0, sizeof(Pdc));
+	memset((void *)&sim_PDC_UART0, 0, sizeof(Pdc));
+	memset((void *)&sim_PDC_UART1, 0, sizeof(Pdc));
+	memset((void *)&sim_UART0, 0, sizeof(Uart));
+	memset((void *)&sim_UART1, 0, sizeof(Uart));
+	memset((void *)&sim_USART0, 0, sizeof(Usart));
+	memset((void *)&sim_USART1, 0, sizeof(Usart));
+	memset((void *)&sim_WDT, 0, sizeof(Wdt));
+	memset((void *)&sim_RSTC, 0, sizeof(Rstc));
+	memset((void *)&sim_EFC, 0, sizeof(Efc));
+	memset((void *)&sim_PMC, 0, sizeof(Pmc));
+	memset((void *)&sim_SCB, 0, sizeof(SCB_Type));
+	memset((void *)&sim_DWT, 0, sizeof(DWT_Type));
+	memset((void *)&sim_CoreDebug, 0, sizeof(CoreDebug_Type));
+	memset(&sim, 0, sizeof(sim));
+
+	SystemCoreClock = SIM_CORE_CLOCK_FREQUENCY;
+
+	for(i = 0; i < SIM_NUMBER_OF_TC_CHANNELS; i++)
+	{
+		sim.tc[i].registers = &tc_blocks[i / 3]->TC_CHANNEL[i % 3];
+	}
+
+	for(i = 0; i < 5; i++)
+	{
+		sim.pio[i].registers = pio_blocks[i];
+		sim.pio[i].input_levels = 0xFFFFFFFF;                   //pull-ups are on out of reset
+		pio_blocks[i]->PIO_PSR.value = 0xFFFFFFFF;              //every line starts under PIO control
+	}
+
+	sim.uart[0].registers = &sim_UART0;
+	sim.uart[1].registers = &sim_UART1;
+
+	sim.spi.is_end_of_tx_latched = true;                        //TCR is 0 out of reset
+
+	sim.DAC.control_register = SIM_AD5791_CONTROL_RESET;
+	sim.DAC.capture = capture;
+	sim.DAC.capture_size = capture_size;
+
+	//the watchdog runs out of reset, at its longest period with reset enabled
+	sim.wdt.is_enabled = true;
+	sim.wdt.is_reset_enabled = true;
+	sim.wdt.period_cycles = (uint64_t)WDT_MR_WDV_Msk * 128 * SIM_CORE_CLOCK_FREQUENCY / SIM_SLOW_CLOCK_FREQUENCY;
+	sim.wdt.expiry_cycle = sim.wdt.period_cycles;
+
+	sim.nvic.active_priority = SIM_THREAD_PRIORITY;
+	sim.nvic.handler[PIOA_IRQn] = PIOA_Handler;
+	sim.nvic.handler[PIOB_IRQn] = PIOB_Handler;
+	sim.nvic.handler[PIOC_IRQn] = PIOC_Handler;
+	sim.nvic.handler[PIOD_IRQn] = PIOD_Handler;
+	sim.nvic.handler[PIOE_IRQn] = PIOE_Handler;
+	sim.nvic.handler[SPI_IRQn] = SPI_Handler;
+	sim.nvic.handler[TC0_IRQn] = TC0_Handler;
+	sim.nvic.handler[TC1_IRQn] = TC1_Handler;
+	sim.nvic.handler[TC2_IRQn] = TC2_Handler;
+	sim.nvic.handler[TC3_IRQn] = TC3_Handler;
+	sim.nvic.handler[TC4_IRQn] = TC4_Handler;
+	sim.nvic.handler[TC5_IRQn] = TC5_Handler;
+	sim.nvic.handler[TC6_IRQn] = TC6_Handler;
+	sim.nvic.handler[TC7_IRQn] = TC7_Handler;
+	sim.nvic.handler[TC8_IRQn] = TC8_Handler;
+	sim.nvic.handler[UART0_IRQn] = UART0_Handler;
+	sim.nvic.handler[UART1_IRQn] = UART1_Handler;
+}
+
+void sim_run_cycles(uint64_t cycles)
+{
+	run_until(sim.cycle + cycles);
+}
+
+uint64_t sim_get_cycle_count(void)
+{
+	return(sim.cycle);
+}
+
+void sim_set_pin_input(Pio *pio, uint32_t mask, bool is_high)
+{
+	struct sim_pio *sim_port = get_pio(pio);
+	Pio *registers = sim_port->registers;
+	uint32_t new_levels = is_high ? (sim_port->input_levels | mask) : (sim_port->input_levels & ~mask);
+	uint32_t changed = sim_port->input_levels ^ new_levels;
+	uint32_t edge_lines = changed & ~(registers->PIO_AIMMR.value & registers->PIO_ELSR.value);
+	uint32_t rising_only = registers->PIO_AIMMR.value & registers->PIO_FRLHSR.value;
+	uint32_t falling_only = registers->PIO_AIMMR.value & ~registers->PIO_FRLHSR.value;
+
+	//with the additional modes off a line interrupts on both edges, with them on only on the one FRLHSR picks
+	if(is_high)
+	{
+		registers->PIO_ISR.value |= edge_lines & ~falling_only;
+	}
+	else
+	{
+		registers->PIO_ISR.value |= edge_lines & ~rising_only;
+	}
+
+	sim_port->input_levels = new_levels;
+	update_pio_level_interrupts(sim_port);
+
+	if((pio == &sim_PIOC) && (changed & PIO_PDSR_P29))
+	{
+		set_tc_capture_input(&sim.tc[SIM_SYNC_IN_CHANNEL], is_high);
+	}
+
+	dispatch_interrupts();
+}
+
+uint32_t sim_get_pin_levels(Pio *pio)
+{
+	struct sim_pio *sim_port = get_pio(pio);
+	uint32_t outputs = pio->PIO_OSR.value;
+
+	return((outputs & pio->PIO_ODSR.value) | (~outputs & sim_port->input_levels));
+}
+
+void sim_set_DAC_capture_buffer(sim_DAC_sample_type *buffer, uint32_t size)
+{
+	sim.DAC.capture = buffer;
+	sim.DAC.capture_size = (buffer == NULL) ? 0 : size;
+	sim.DAC.capture_count = 0;
+}
+
+uint32_t sim_get_DAC_capture_count(void)
+{
+	return(sim.DAC.capture_count);
+}
+
+void sim_get_DAC_registers(int32_t *DAC_code, uint32_t *control_register)
+{
+	if(DAC_code != NULL)
+	{
+		*DAC_code = sim.DAC.DAC_register;
+	}
+
+	if(control_register != NULL)
+	{
+		*control_register = sim.DAC.control_register;
+	}
+}
+
+uint32_t sim_get_DAC_frame_error_count(void)
+{
+	return(sim.DAC.frame_errors);
+}
+
+void sim_write_UART_Rx_bytes(Uart *uart, const char *data, uint32_t number_of_bytes)
+{
+	struct sim_uart *sim_uart = get_uart(uart);
+	uint32_t i;
+
+	for(i = 0; i < number_of_bytes; i++)
+	{
+		if(!push_uart_fifo(&sim_uart->rx, data[i]))
+		{
+			uart->UART_SR.value |= UART_SR_OVRE;
+			break;
+		}
+	}
+
+	dispatch_interrupts();
+}
+
+uint32_t sim_read_UART_Tx_bytes(Uart *uart, char *data, uint32_t maximum_number_of_bytes)
+{
+	struct sim_uart *sim_uart = get_uart(uart);
+	uint32_t i = 0;
+
+	while((i < maximum_number_of_bytes) && pop_uart_fifo(&sim_uart->tx, &data[i]))
+	{
+		i++;
+	}
+
+	return(i);
+}
+
+uint32_t sim_get_reset_count(void)
+{
+	return(sim.reset_count);
+}
+
+uint32_t sim_get_GPNVM_bits(void)
+{
+	return(sim.efc.GPNVM_bits);
+}
+
+/**
+ * @brief Steps simulated time forward one event at a time, servicing interrupts after each. Safe to re-enter from a
+ * handler that polls a status register, in which case the outer call carries on from wherever the inner one got to.
+ *
+ * @param target_cycle where to stop
+ *
+ * @return void
+ */
+static void run_until(uint64_t target_cycle)
+{
+	uint64_t event_cycle;
+	uint64_t next_event_cycle;
+	uint32_t i;
+
+	while(true)
+	{
+		next_event_cycle = SIM_NO_EVENT;
+
+		for(i = 0; i < SIM_NUMBER_OF_TC_CHANNELS; i++)
+		{
+			event_cycle = get_next_tc_event_cycle(&sim.tc[i]);
+			next_event_cycle = (event_cycle < next_event_cycle) ? event_cycle : next_event_cycle;
+		}
+
+		if(sim.spi.is_shifter_busy && (sim.spi.shifter_done_cycle < next_event_cycle))
+		{
+			next_event_cycle = sim.spi.shifter_done_cycle;
+		}
+
+		if(sim.wdt.is_enabled && (sim.wdt.expiry_cycle < next_event_cycle))
+		{
+			next_event_cycle = sim.wdt.expiry_cycle;
+		}
+
+		if(sim.efc.is_busy && (sim.efc.done_cycle < next_event_cycle))
+		{
+			next_event_cycle = sim.efc.done_cycle;
+		}
+
+		if(next_event_cycle > target_cycle)
+		{
+			break;
+		}
+
+		if(next_event_cycle > sim.cycle)
+		{
+			sim.cycle = next_event_cycle;
+		}
+
+		for(i = 0; i < SIM_NUMBER_OF_TC_CHANNELS; i++)
+		{
+			if(get_next_tc_event_cycle(&sim.tc[i]) <= sim.cycle)
+			{
+				process_tc_event(&sim.tc[i]);
+			}
+		}
+
+		if(sim.spi.is_shifter_busy && (sim.spi.shifter_done_cycle <= sim.cycle))
+		{
+			process_spi_event();
+		}
+
+		if(sim.wdt.is_enabled && (sim.wdt.expiry_cycle <= sim.cycle))
+		{
+			process_wdt_event();
+		}
+
+		if(sim.efc.is_busy && (sim.efc.done_cycle <= sim.cycle))
+		{
+			process_efc_event();
+		}
+
+		dispatch_interrupts();
+	}
+
+	if(target_cycle > sim.cycle)
+	{
+		sim.cycle = target_cycle;
+	}
+}
+
+/**
+ * @brief Charges a status register read some time, so a loop polling it sees the peripheral move on.
+ *
+ * @return void
+ */
+static void advance_for_status_poll(void)
+{
+	run_until(sim.cycle + SIM_STATUS_POLL_CYCLES);
+}
+
+#pragma endregion "Simulator Control Functions"
+
+#pragma region "Register Access Functions"
+
+uint32_t sim_read_register(sim_register *reg)
+{
+	uint32_t i;
+
+	for(i = 0; i < SIM_NUMBER_OF_TC_CHANNELS; i++)
+	{
+		if(IS_REGISTER_OF(reg, *sim.tc[i].registers))
+		{
+			return(read_tc_register(&sim.tc[i], reg));
+		}
+	}
+
+	for(i = 0; i < 5; i++)
+	{
+		if(IS_REGISTER_OF(reg, *sim.pio[i].registers))
+		{
+			return(read_pio_register(&sim.pio[i], reg));
+		}
+	}
+
+	if(IS_REGISTER_OF(reg, sim_SPI))
+	{
+		return(read_spi_register(reg));
+	}
+
+	for(i = 0; i < 2; i++)
+	{
+		if(IS_REGISTER_OF(reg, *sim.uart[i].registers))
+		{
+			return(read_uart_register(&sim.uart[i], reg));
+		}
+	}
+
+	if(reg == &sim_WDT.WDT_SR)
+	{
+		uint32_t status = sim_WDT.WDT_SR.value;
+
+		sim_WDT.WDT_SR.value = 0;
+		return(status);
+	}
+
+	if(reg == &sim_EFC.EEFC_FSR)
+	{
+		uint32_t status;
+
+		advance_for_status_poll();
+		status = (sim.efc.is_busy ? 0 : EEFC_FSR_FRDY) | (sim.efc.is_command_error ? EEFC_FSR_FCMDE : 0);
+		sim.efc.is_command_error = false;
+		return(status);
+	}
+
+	if(reg == &sim_DWT.CYCCNT)
+	{
+		if(!(sim_DWT.CTRL.value & DWT_CTRL_CYCCNTENA_Msk))
+		{
+			return(sim_DWT.CYCCNT.value);
+		}
+
+		return((uint32_t)sim.cycle + sim.cycle_counter_offset);
+	}
+
+	return(reg->value);
+}
+
+void sim_write_register(sim_register *reg, uint32_t value)
+{
+	uint32_t i;
+
+	for(i = 0; i < SIM_NUMBER_OF_TC_CHANNELS; i++)
+	{
+		if(IS_REGISTER_OF(reg, *sim.tc[i].registers))
+		{
+			write_tc_register(&sim.tc[i], reg, value);
+			dispatch_interrupts();
+			return;
+		}
+	}
+
+	for(i = 0; i < 5; i++)
+	{
+		if(IS_REGISTER_OF(reg, *sim.pio[i].registers))
+		{
+			write_pio_register(&sim.pio[i], reg, value);
+			dispatch_interrupts();
+			return;
+		}
+	}
+
+	if(IS_REGISTER_OF(reg, sim_SPI))
+	{
+		write_spi_register(reg, value);
+	}
+	else if(IS_REGISTER_OF(reg, sim_PDC_SPI))
+	{
+		write_spi_pdc_register(reg, value);
+	}
+	else if(IS_REGISTER_OF(reg, sim_UART0))
+	{
+		write_uart_register(&sim.uart[0], reg, value);
+	}
+	else if(IS_REGISTER_OF(reg, sim_UART1))
+	{
+		write_uart_register(&sim.uart[1], reg, value);
+	}
+	else if(IS_REGISTER_OF(reg, sim_WDT))
+	{
+		write_wdt_register(reg, value);
+	}
+	else if(IS_REGISTER_OF(reg, sim_EFC))
+	{
+		write_efc_register(reg, value);
+	}
+	else if(reg == &sim_RSTC.RSTC_CR)
+	{
+		if((value & 0xFF000000u) == (0xA5u << 24))
+		{
+			request_reset("RSTC_CR");
+		}
+	}
+	else if(reg == &sim_DWT.CYCCNT)
+	{
+		sim_DWT.CYCCNT.value = value;
+		sim.cycle_counter_offset = value - (uint32_t)sim.cycle;
+	}
+	else
+	{
+		reg->value = value;
+	}
+
+	dispatch_interrupts();
+}
+
+uint32_t sim_get_bus_address(const void *address)
+{
+	int64_t offset = (int64_t)((intptr_t)address - (intptr_t)&sim_bus_anchor);
+
+	if((offset < INT32_MIN) || (offset > INT32_MAX))
+	{
+		fprintf(stderr, "sim: %p is too far from the other statics to hand the PDC\n", address);
+		abort();
+	}
+
+	return(SIM_BUS_ADDRESS_BASE + (uint32_t)(int32_t)offset);
+}
+
+/**
+ * @brief Turns an address handed to a PDC back into a host pointer
+ *
+ * @param bus_address from sim_get_bus_address()
+ *
+ * @return void* host pointer
+ */
+static void *get_host_address(uint32_t bus_address)
+{
+	return(&sim_bus_anchor + (int32_t)(bus_address - SIM_BUS_ADDRESS_BASE));
+}
+
+#pragma endregion "Register Access Functions"
+
+#pragma region "Timer Counter Functions"
+
+/**
+ * @brief Gets how many core clocks make one count of the channel's counter
+ *
+ * @param channel which channel
+ *
+ * @return uint32_t core clocks per count, 0 for an external clock, which isn't modeled
+ */
+static uint32_t get_tc_divisor(struct sim_tc_channel *channel)
+{
+	if(channel->registers->TC_EMR.value & TC_EMR_NODIVCLK)
+	{
+		return(1);
+	}
+
+	switch(channel->registers->TC_CMR.value & TC_CMR_TCCLKS_Msk)
+	{
+		case TC_CMR_TCCLKS_TIMER_CLOCK1:    return(2);
+		case TC_CMR_TCCLKS_TIMER_CLOCK2:    return(8);
+		case TC_CMR_TCCLKS_TIMER_CLOCK3:    return(32);
+		case TC_CMR_TCCLKS_TIMER_CLOCK4:    return(128);
+		case TC_CMR_TCCLKS_TIMER_CLOCK5:    return(SIM_CORE_CLOCK_FREQUENCY / SIM_SLOW_CLOCK_FREQUENCY);
+		default:                            return(0);
+	}
+}
+
+/**
+ * @brief Brings count and base_cycle up to now. The counter never passes an event here, since events are processed as
+ * time reaches them.
+ *
+ * @param channel which channel
+ *
+ * @return void
+ */
+static void sync_tc_counter(struct sim_tc_channel *channel)
+{
+	uint32_t divisor = get_tc_divisor(channel);
+	uint64_t counts;
+
+	if(!channel->is_clock_enabled || channel->is_stopped || (divisor == 0))
+	{
+		channel->base_cycle = sim.cycle;
+		return;
+	}
+
+	counts = (sim.cycle - channel->base_cycle) / divisor;
+	channel->count += (uint32_t)counts;
+	channel->base_cycle += counts * divisor;
+}
+
+static uint64_t get_next_tc_event_cycle(struct sim_tc_channel *channel)
+{
+	uint32_t divisor = get_tc_divisor(channel);
+	uint32_t cmr = channel->registers->TC_CMR.value;
+	uint32_t ra = channel->registers->TC_RA.value;
+	uint32_t rc = channel->registers->TC_RC.value;
+	uint32_t target = SIM_TC_COUNTER_WRAP;
+
+	if(!channel->is_clock_enabled || channel->is_stopped || (divisor == 0))
+	{
+		return(SIM_NO_EVENT);
+	}
+
+	if((cmr & TC_CMR_WAVE) && (ra > channel->count) && (ra < target))
+	{
+		target = ra;
+	}
+
+	if((rc > channel->count) && (rc < target))
+	{
+		target = rc;
+	}
+
+	return(channel->base_cycle + (uint64_t)(target - channel->count) * divisor);
+}
+
+static void process_tc_event(struct sim_tc_channel *channel)
+{
+	uint32_t cmr = channel->registers->TC_CMR.value;
+
+	sync_tc_counter(channel);
+
+	if((cmr & TC_CMR_WAVE) && (channel->count == channel->registers->TC_RA.value))
+	{
+		channel->status |= TC_SR_CPAS;
+		apply_tc_output_action(channel, (cmr & TC_CMR_ACPA_Msk) >> 16);
+	}
+
+	if(channel->count == channel->registers->TC_RC.value)
+	{
+		channel->status |= TC_SR_CPCS;
+
+		if(cmr & TC_CMR_WAVE)
+		{
+			apply_tc_output_action(channel, (cmr & TC_CMR_ACPC_Msk) >> 18);
+
+			if((cmr & TC_CMR_WAVSEL_Msk) == TC_CMR_WAVSEL_UP_RC)
+			{
+				channel->count = 0;
+			}
+
+			if(cmr & TC_CMR_CPCSTOP)
+			{
+				channel->is_stopped = true;
+			}
+
+			if(cmr & TC_CMR_CPCDIS)
+			{
+				channel->is_clock_enabled = false;
+			}
+		}
+	}
+
+	if(channel->count >= SIM_TC_COUNTER_WRAP)
+	{
+		channel->status |= TC_SR_COVFS;
+		channel->count = 0;
+	}
+}
+
+/**
+ * @brief Applies a waveform mode ACPA/ACPC action to TIOA. TIOA3 drives the AD5791's LDAC.
+ *
+ * @param channel which channel
+ * @param action 0 none, 1 set, 2 clear, 3 toggle
+ *
+ * @return void
+ */
+static void apply_tc_output_action(struct sim_tc_channel *channel, uint32_t action)
+{
+	bool level = channel->tioa;
+
+	switch(action)
+	{
+		case 1:     level = true;               break;
+		case 2:     level = false;              break;
+		case 3:     level = !channel->tioa;     break;
+		default:                                break;
+	}
+
+	if(level == channel->tioa)
+	{
+		return;
+	}
+
+	channel->tioa = level;
+
+	if(channel == &sim.tc[SIM_SAMPLE_TIMER_CHANNEL])
+	{
+		set_AD5791_LDAC(level);
+	}
+}
+
+/**
+ * @brief Feeds a capture mode channel the level on its TIOA pin, loading RA on the edge LDRA selects
+ *
+ * @param channel which channel
+ * @param level new level
+ *
+ * @return void
+ */
+static void set_tc_capture_input(struct sim_tc_channel *channel, bool level)
+{
+	uint32_t cmr = channel->registers->TC_CMR.value;
+	uint32_t load_edge = cmr & TC_CMR_LDRA_Msk;
+	bool is_loading_edge;
+
+	if(level == channel->tioa_input)
+	{
+		return;
+	}
+
+	channel->tioa_input = level;
+
+	if((cmr & TC_CMR_WAVE) || !channel->is_clock_enabled || channel->is_stopped)
+	{
+		return;
+	}
+
+	is_loading_edge = (load_edge == TC_CMR_LDRA_EDGE) ||
+	                  ((load_edge == TC_CMR_LDRA_RISING) && level) ||
+	                  ((load_edge == TC_CMR_LDRA_FALLING) && !level);
+
+	if(is_loading_edge)
+	{
+		sync_tc_counter(channel);
+
+		if(channel->status & TC_SR_LDRAS)
+		{
+			channel->status |= TC_SR_LOVRS;
+		}
+
+		channel->registers->TC_RA.value = channel->count;
+		channel->status |= TC_SR_LDRAS;
+	}
+}
+
+static uint32_t read_tc_register(struct sim_tc_channel *channel, sim_register *reg)
+{
+	TcChannel *registers = channel->registers;
+	uint32_t status;
+
+	if(reg == &registers->TC_SR)
+	{
+		status = channel->status | (channel->is_clock_enabled ? TC_SR_CLKSTA : 0) | (channel->tioa ? TC_SR_MTIOA : 0);
+		channel->status &= ~SIM_TC_STATUS_CLEARED_ON_READ;
+		return(status);
+	}
+
+	if(reg == &registers->TC_CV)
+	{
+		sync_tc_counter(channel);
+		return(channel->count);
+	}
+
+	return(reg->value);
+}
+
+static void write_tc_register(struct sim_tc_channel *channel, sim_register *reg, uint32_t value)
+{
+	TcChannel *registers = channel->registers;
+
+	sync_tc_counter(channel);                                   //anything written from here on applies from now
+
+	if(reg == &registers->TC_CCR)
+	{
+		if(value & TC_CCR_CLKDIS)
+		{
+			channel->is_clock_enabled = false;
+		}
+		else if(value & TC_CCR_CLKEN)
+		{
+			channel->is_clock_enabled = true;
+		}
+
+		if(value & TC_CCR_SWTRG)
+		{
+			channel->count = 0;
+			channel->base_cycle = sim.cycle;
+			channel->is_stopped = false;
+		}
+	}
+	else if(reg == &registers->TC_IER)
+	{
+		registers->TC_IMR.value |= value;
+	}
+	else if(reg == &registers->TC_IDR)
+	{
+		registers->TC_IMR.value &= ~value;
+	}
+	else if((reg == &registers->TC_SR) || (reg == &registers->TC_CV) || (reg == &registers->TC_IMR))
+	{
+		//read only
+	}
+	else
+	{
+		reg->value = value;
+	}
+}
+
+#pragma endregion "Timer Counter Functions"
+
+#pragma region "PIO Functions"
+
+static uint32_t read_pio_register(struct sim_pio *pio, sim_register *reg)
+{
+	Pio *registers = pio->registers;
+	uint32_t value;
+
+	if(reg == &registers->PIO_PDSR)
+	{
+		return((registers->PIO_OSR.value & registers->PIO_ODSR.value) | (~registers->PIO_OSR.value & pio->input_levels));
+	}
+
+	if(reg == &registers->PIO_ISR)
+	{
+		value = registers->PIO_ISR.value;
+		registers->PIO_ISR.value = 0;
+		update_pio_level_interrupts(pio);                       //a level that's still there flags again straight away
+		return(value);
+	}
+
+	return(reg->value);
+}
+
+static void write_pio_register(struct sim_pio *pio, sim_register *reg, uint32_t value)
+{
+	Pio *registers = pio->registers;
+
+	if(reg == &registers->PIO_PER)          registers->PIO_PSR.value |= value;
+	else if(reg == &registers->PIO_PDR)     registers->PIO_PSR.value &= ~value;
+	else if(reg == &registers->PIO_OER)     registers->PIO_OSR.value |= value;
+	else if(reg == &registers->PIO_ODR)     registers->PIO_OSR.value &= ~value;
+	else if(reg == &registers->PIO_SODR)    registers->PIO_ODSR.value |= value;
+	else if(reg == &registers->PIO_CODR)    registers->PIO_ODSR.value &= ~value;
+	else if(reg == &registers->PIO_ODSR)    registers->PIO_ODSR.value = (registers->PIO_ODSR.value & ~registers->PIO_OWSR.value) | (value & registers->PIO_OWSR.value);
+	else if(reg == &registers->PIO_IER)     registers->PIO_IMR.value |= value;
+	else if(reg == &registers->PIO_IDR)     registers->PIO_IMR.value &= ~value;
+	else if(reg == &registers->PIO_OWER)    registers->PIO_OWSR.value |= value;
+	else if(reg == &registers->PIO_OWDR)    registers->PIO_OWSR.value &= ~value;
+	else if(reg == &registers->PIO_PUER)    registers->PIO_PUSR.value &= ~value;
+	else if(reg == &registers->PIO_PUDR)    registers->PIO_PUSR.value |= value;
+	else if(reg == &registers->PIO_PPDER)   registers->PIO_PPDSR.value &= ~value;
+	else if(reg == &registers->PIO_PPDDR)   registers->PIO_PPDSR.value |= value;
+	else if(reg == &registers->PIO_AIMER)   registers->PIO_AIMMR.value |= value;
+	else if(reg == &registers->PIO_AIMDR)   registers->PIO_AIMMR.value &= ~value;
+	else if(reg == &registers->PIO_ESR)     registers->PIO_ELSR.value &= ~value;
+	else if(reg == &registers->PIO_LSR)     registers->PIO_ELSR.value |= value;
+	else if(reg == &registers->PIO_FELLSR)  registers->PIO_FRLHSR.value &= ~value;
+	else if(reg == &registers->PIO_REHLSR)  registers->PIO_FRLHSR.value |= value;
+	else if((reg == &registers->PIO_PSR) || (reg == &registers->PIO_OSR) || (reg == &registers->PIO_PDSR) ||
+	        (reg == &registers->PIO_IMR) || (reg == &registers->PIO_ISR) || (reg == &registers->PIO_OWSR) ||
+	        (reg == &registers->PIO_AIMMR) || (reg == &registers->PIO_ELSR) || (reg == &registers->PIO_FRLHSR) ||
+	        (reg == &registers->PIO_PUSR) || (reg == &registers->PIO_PPDSR))
+	{
+		//read only
+	}
+	else
+	{
+		reg->value = value;
+	}
+
+	update_pio_level_interrupts(pio);
+}
+
+/**
+ * @brief Flags lines set up for level interrupts whose input sits at the selected level
+ *
+ * @param pio which port
+ *
+ * @return void
+ */
+static void update_pio_level_interrupts(struct sim_pio *pio)
+{
+	Pio *registers = pio->registers;
+	uint32_t level_lines = registers->PIO_AIMMR.value & registers->PIO_ELSR.value;
+
+	registers->PIO_ISR.value |= level_lines & ~(pio->input_levels ^ registers->PIO_FRLHSR.value);
+}
+
+/**
+ * @brief Finds the simulator state behind a PIO block. The blocks are separate globals, not an array, so it's looked up.
+ *
+ * @param pio PIOA to PIOE
+ *
+ * @return struct sim_pio * its state
+ */
+static struct sim_pio *get_pio(Pio *pio)
+{
+	uint32_t i;
+
+	for(i = 0; i < (sizeof(sim.pio) / sizeof(sim.pio[0])); i++)
+	{
+		if(sim.pio[i].registers == pio)
+		{
+			break;
+		}
+	}
+
+	return(&sim.pio[(i < (sizeof(sim.pio) / sizeof(sim.pio[0]))) ? i : 0]);
+}
+
+#pragma endregion "PIO Functions"
+
+#pragma region "SPI and PDC Functions"
+
+/**
+ * @brief Moves the SPI along as far as it can go right now: the PDC refills the TDR, and an idle shifter takes the TDR,
+ * asserting chip select first if it isn't already
+ *
+ * @return void
+ */
+static void service_spi(void)
+{
+	uint32_t mr = sim_SPI.SPI_MR.value;
+	uint32_t csr = sim_SPI.SPI_CSR[0].value;
+	uint32_t scbr = (csr >> SPI_CSR_SCBR_Pos) & 0xFF;
+	uint32_t dlybs = (csr >> SPI_CSR_DLYBS_Pos) & 0xFF;
+	uint32_t dlybct = (csr >> SPI_CSR_DLYBCT_Pos) & 0xFF;
+	uint32_t word_bytes = (mr & SPI_MR_PS) ? 4 : 1;             //variable peripheral select, the PDC moves whole TDR words
+	uint64_t start_cycle;
+	bool is_progressing = true;
+
+	scbr = (scbr == 0) ? 1 : scbr;
+	dlybs = (dlybs == 0) ? (scbr / 2) : dlybs;                  //0 means half an SPCK period
+
+	while(is_progressing)
+	{
+		is_progressing = false;
+
+		if(!sim.spi.is_tdr_full && (sim_PDC_SPI.PERIPH_PTSR.value & PERIPH_PTSR_TXTEN) && (sim_PDC_SPI.PERIPH_TCR.value != 0))
+		{
+			sim.spi.tdr_word = 0;
+			memcpy(&sim.spi.tdr_word, get_host_address(sim_PDC_SPI.PERIPH_TPR.value), word_bytes);
+			sim.spi.is_tdr_full = true;
+			sim_PDC_SPI.PERIPH_TPR.value += word_bytes;
+			sim_PDC_SPI.PERIPH_TCR.value--;
+
+			if(sim_PDC_SPI.PERIPH_TCR.value == 0)
+			{
+				sim.spi.is_end_of_tx_latched = true;
+
+				if(sim_PDC_SPI.PERIPH_TNCR.value != 0)
+				{
+					sim_PDC_SPI.PERIPH_TPR.value = sim_PDC_SPI.PERIPH_TNPR.value;
+					sim_PDC_SPI.PERIPH_TCR.value = sim_PDC_SPI.PERIPH_TNCR.value;
+					sim_PDC_SPI.PERIPH_TNCR.value = 0;
+				}
+			}
+
+			is_progressing = true;
+		}
+
+		if(sim.spi.is_enabled && !sim.spi.is_shifter_busy && sim.spi.is_tdr_full)
+		{
+			start_cycle = sim.cycle;
+
+			if(!sim.spi.is_chip_select_asserted)
+			{
+				start_cycle = (sim.spi.chip_select_ready_cycle > sim.cycle) ? sim.spi.chip_select_ready_cycle : sim.cycle;
+				start_cycle += dlybs;
+				sim.spi.is_chip_select_asserted = true;
+				sim.DAC.bits_shifted = 0;                       //SYNC falls
+			}
+			else
+			{
+				start_cycle += 32 * dlybct;                     //delay between consecutive transfers, chip select held
+			}
+
+			sim.spi.shifter_word = sim.spi.tdr_word;
+			sim.spi.is_tdr_full = false;
+			sim.spi.is_shifter_busy = true;
+			sim.spi.shifter_done_cycle = start_cycle + 8 * scbr;
+			is_progressing = true;
+		}
+	}
+}
+
+/**
+ * @brief A byte has finished shifting out. Chip select rises after a LASTXFER word, or when there's nothing queued to follow.
+ *
+ * @return void
+ */
+static void process_spi_event(void)
+{
+	uint32_t dlybcs = (sim_SPI.SPI_MR.value >> SPI_MR_DLYBCS_Pos) & 0xFF;
+	bool is_last_transfer;
+
+	dlybcs = (dlybcs < SIM_SPI_MINIMUM_DLYBCS) ? SIM_SPI_MINIMUM_DLYBCS : dlybcs;   //6 or less inserts 6
+
+	sim.spi.is_shifter_busy = false;
+	shift_AD5791_byte((uint8_t)sim.spi.shifter_word);
+
+	//the PDC refills the TDR as soon as the shifter takes it, so an empty TDR here means nothing follows
+	is_last_transfer = ((sim_SPI.SPI_MR.value & SPI_MR_PS) && (sim.spi.shifter_word & SPI_TDR_LASTXFER)) ||
+	                   (!sim.spi.is_tdr_full && !(sim_SPI.SPI_CSR[0].value & SPI_CSR_CSAAT));
+
+	if(is_last_transfer && sim.spi.is_chip_select_asserted)
+	{
+		sim.spi.is_chip_select_asserted = false;
+		sim.spi.chip_select_ready_cycle = sim.cycle + dlybcs;
+		raise_AD5791_SYNC();
+	}
+
+	service_spi();
+}
+
+static uint32_t read_spi_register(sim_register *reg)
+{
+	uint32_t status = 0;
+
+	if(reg == &sim_SPI.SPI_SR)
+	{
+		advance_for_status_poll();
+
+		status |= sim.spi.is_tdr_full ? 0 : SPI_SR_TDRE;
+		status |= (!sim.spi.is_tdr_full && !sim.spi.is_shifter_busy) ? SPI_SR_TXEMPTY : 0;
+		status |= sim.spi.is_end_of_tx_latched ? SPI_SR_ENDTX : 0;
+		status |= ((sim_PDC_SPI.PERIPH_TCR.value == 0) && (sim_PDC_SPI.PERIPH_TNCR.value == 0)) ? SPI_SR_TXBUFE : 0;
+		status |= sim.spi.is_enabled ? SPI_SR_SPIENS : 0;
+		return(status);
+	}
+
+	return(reg->value);
+}
+
+static void write_spi_register(sim_register *reg, uint32_t value)
+{
+	if(reg == &sim_SPI.SPI_CR)
+	{
+		if(value & SPI_CR_SWRST)
+		{
+			memset(&sim.spi, 0, sizeof(sim.spi));
+			sim.spi.is_end_of_tx_latched = true;
+		}
+
+		if(value & SPI_CR_SPIDIS)
+		{
+			sim.spi.is_enabled = false;
+		}
+		else if(value & SPI_CR_SPIEN)
+		{
+			sim.spi.is_enabled = true;
+		}
+	}
+	else if(reg == &sim_SPI.SPI_TDR)
+	{
+		if(!sim.spi.is_tdr_full)
+		{
+			sim.spi.tdr_word = value;
+			sim.spi.is_tdr_full = true;
+		}
+	}
+	else if(reg == &sim_SPI.SPI_IER)
+	{
+		sim_SPI.SPI_IMR.value |= value;
+	}
+	else if(reg == &sim_SPI.SPI_IDR)
+	{
+		sim_SPI.SPI_IMR.value &= ~value;
+	}
+	else
+	{
+		reg->value = value;
+	}
+
+	service_spi();
+}
+
+static void write_spi_pdc_register(sim_register *reg, uint32_t value)
+{
+	reg->value = value;
+
+	if((reg == &sim_PDC_SPI.PERIPH_TCR) || (reg == &sim_PDC_SPI.PERIPH_TNCR))
+	{
+		if((sim_PDC_SPI.PERIPH_TCR.value == 0) && (sim_PDC_SPI.PERIPH_TNCR.value != 0))
+		{
+			sim_PDC_SPI.PERIPH_TPR.value = sim_PDC_SPI.PERIPH_TNPR.value;
+			sim_PDC_SPI.PERIPH_TCR.value = sim_PDC_SPI.PERIPH_TNCR.value;
+			sim_PDC_SPI.PERIPH_TNCR.value = 0;
+		}
+
+		sim.spi.is_end_of_tx_latched = (sim_PDC_SPI.PERIPH_TCR.value == 0);
+	}
+	else if(reg == &sim_PDC_SPI.PERIPH_PTCR)
+	{
+		if(value & PERIPH_PTCR_TXTDIS)
+		{
+			sim_PDC_SPI.PERIPH_PTSR.value &= ~PERIPH_PTSR_TXTEN;
+		}
+		else if(value & PERIPH_PTCR_TXTEN)
+		{
+			sim_PDC_SPI.PERIPH_PTSR.value |= PERIPH_PTSR_TXTEN;
+		}
+	}
+
+	service_spi();
+}
+
+#pragma endregion "SPI and PDC Functions"
+
+#pragma region "AD5791 Functions"
+
+static void shift_AD5791_byte(uint8_t data_byte)
+{
+	sim.DAC.shift_register = (sim.DAC.shift_register << 8) | data_byte;
+	sim.DAC.bits_shifted += 8;
+}
+
+/**
+ * @brief SYNC rising ends a frame. Anything but 24 bits is ignored by the part, and counted here.
+ *
+ * @return void
+ */
+static void raise_AD5791_SYNC(void)
+{
+	uint32_t frame = sim.DAC.shift_register & 0xFFFFFF;
+	uint32_t data = frame & 0xFFFFF;
+
+	if(sim.DAC.bits_shifted != SIM_AD5791_FRAME_BITS)
+	{
+		sim.DAC.frame_errors++;
+		sim.DAC.bits_shifted = 0;
+		return;
+	}
+
+	sim.DAC.bits_shifted = 0;
+
+	if(frame & (1u << 23))
+	{
+		return;                                                 //read back, nothing listens to SDO
+	}
+
+	switch((frame >> 20) & 0x7)
+	{
+		case 1:                                                 //DAC register, by way of the input register
+			sim.DAC.input_register = data;
+			if(!sim.DAC.is_LDAC_high)
+			{
+				update_AD5791_DAC_register();
+			}
+			break;
+
+		case 2:
+			sim.DAC.control_register = data;
+			break;
+
+		case 4:                                                 //software control
+			if(data & 0x4)
+			{
+				sim.DAC.input_register = 0;
+				sim.DAC.control_register = SIM_AD5791_CONTROL_RESET;
+				update_AD5791_DAC_register();
+			}
+			else if(data & 0x1)
+			{
+				update_AD5791_DAC_register();
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+static void set_AD5791_LDAC(bool is_high)
+{
+	if(sim.DAC.is_LDAC_high && !is_high)
+	{
+		update_AD5791_DAC_register();
+	}
+
+	sim.DAC.is_LDAC_high = is_high;
+}
+
+static void update_AD5791_DAC_register(void)
+{
+	sim.DAC.DAC_register = (int32_t)(sim.DAC.input_register << 12) >> 12;
+
+	if(sim.DAC.capture_count < sim.DAC.capture_size)
+	{
+		sim.DAC.capture[sim.DAC.capture_count].cycle = sim.cycle;
+		sim.DAC.capture[sim.DAC.capture_count].code = sim.DAC.DAC_register;
+		sim.DAC.capture_count++;
+	}
+}
+
+#pragma endregion "AD5791 Functions"
+
+#pragma region "UART Functions"
+
+static uint32_t read_uart_register(struct sim_uart *uart, sim_register *reg)
+{
+	Uart *registers = uart->registers;
+	uint32_t status;
+	char data = 0;
+
+	if(reg == &registers->UART_SR)
+	{
+		advance_for_status_poll();
+
+		status = registers->UART_SR.value | UART_SR_TXRDY | UART_SR_TXEMPTY;
+		status |= (uart->rx.head != uart->rx.tail) ? UART_SR_RXRDY : 0;
+		return(status);
+	}
+
+	if(reg == &registers->UART_RHR)
+	{
+		pop_uart_fifo(&uart->rx, &data);
+		return((uint8_t)data);
+	}
+
+	return(reg->value);
+}
+
+static void write_uart_register(struct sim_uart *uart, sim_register *reg, uint32_t value)
+{
+	Uart *registers = uart->registers;
+
+	if(reg == &registers->UART_THR)
+	{
+		push_uart_fifo(&uart->tx, (char)value);
+	}
+	else if(reg == &registers->UART_CR)
+	{
+		if(value & UART_CR_RSTSTA)
+		{
+			registers->UART_SR.value &= ~UART_SR_OVRE;
+		}
+	}
+	else if(reg == &registers->UART_IER)
+	{
+		registers->UART_IMR.value |= value;
+	}
+	else if(reg == &registers->UART_IDR)
+	{
+		registers->UART_IMR.value &= ~value;
+	}
+	else
+	{
+		reg->value = value;
+	}
+}
+
+static bool push_uart_fifo(struct sim_uart_fifo *fifo, char data)
+{
+	uint32_t next_head = (fifo->head + 1) % SIM_UART_FIFO_SIZE;
+
+	if(next_head == fifo->tail)
+	{
+		return(false);
+	}
+
+	fifo->data[fifo->head] = data;
+	fifo->head = next_head;
+	return(true);
+}
+
+static bool pop_uart_fifo(struct sim_uart_fifo *fifo, char *data)
+{
+	if(fifo->head == fifo->tail)
+	{
+		return(false);
+	}
+
+	*data = fifo->data[fifo->tail];
+	fifo->tail = (fifo->tail + 1) % SIM_UART_FIFO_SIZE;
+	return(true);
+}
+
+static struct sim_uart *get_uart(Uart *uart)
+{
+	return((uart == &sim_UART1) ? &sim.uart[1] : &sim.uart[0]);
+}
+
+#pragma endregion "UART Functions"
+
+#pragma region "Watchdog, Flash and Reset Controller Functions"
+
+static void write_wdt_register(sim_register *reg, uint32_t value)
+{
+	if(reg == &sim_WDT.WDT_MR)
+	{
+		if(sim.wdt.is_mode_written)
+		{
+			return;                                             //write once, as on target
+		}
+
+		sim.wdt.is_mode_written = true;
+		sim_WDT.WDT_MR.value = value;
+		sim.wdt.is_enabled = !(value & WDT_MR_WDDIS);
+		sim.wdt.is_reset_enabled = (value & WDT_MR_WDRSTEN) != 0;
+		sim.wdt.period_cycles = (uint64_t)(value & WDT_MR_WDV_Msk) * 128 * SIM_CORE_CLOCK_FREQUENCY / SIM_SLOW_CLOCK_FREQUENCY;
+		sim.wdt.expiry_cycle = sim.cycle + sim.wdt.period_cycles;
+	}
+	else if(reg == &sim_WDT.WDT_CR)
+	{
+		if((value == (WDT_CR_KEY(0xA5) | WDT_CR_WDRSTT)) && sim.wdt.is_enabled)
+		{
+			sim.wdt.expiry_cycle = sim.cycle + sim.wdt.period_cycles;
+		}
+	}
+}
+
+static void process_wdt_event(void)
+{
+	sim_WDT.WDT_SR.value |= WDT_SR_WDUNF;
+	sim.wdt.expiry_cycle = sim.cycle + ((sim.wdt.period_cycles != 0) ? sim.wdt.period_cycles : 1);
+
+	if(sim.wdt.is_reset_enabled)
+	{
+		request_reset("watchdog");
+	}
+}
+
+static void write_efc_register(sim_register *reg, uint32_t value)
+{
+	if(reg != &sim_EFC.EEFC_FCR)
+	{
+		reg->value = value;
+		return;
+	}
+
+	if(((value & EEFC_FCR_FKEY_Msk) != EEFC_FCR_FKEY_PASSWD) || sim.efc.is_busy)
+	{
+		sim.efc.is_command_error = true;
+		return;
+	}
+
+	sim.efc.command = value;
+	sim.efc.is_busy = true;
+	sim.efc.done_cycle = sim.cycle + SIM_EFC_COMMAND_CYCLES;
+}
+
+static void process_efc_event(void)
+{
+	uint32_t argument = (sim.efc.command >> EEFC_FCR_FARG_Pos) & 0xFFFF;
+
+	switch(sim.efc.command & EEFC_FCR_FCMD_Msk)
+	{
+		case EEFC_FCR_FCMD_SGPB:    sim.efc.GPNVM_bits |= (1u << argument);             break;
+		case EEFC_FCR_FCMD_CGPB:    sim.efc.GPNVM_bits &= ~(1u << argument);            break;
+		case EEFC_FCR_FCMD_GGPB:    sim_EFC.EEFC_FRR.value = sim.efc.GPNVM_bits;        break;
+		default:                                                                        break;
+	}
+
+	sim.efc.is_busy = false;
+}
+
+/**
+ * @brief Counts a reset. The firmware carries on as if it hadn't happened, so it's up to the harness to stop or restart.
+ *
+ * @param reason what asked for it
+ *
+ * @return void
+ */
+static void request_reset(const char *reason)
+{
+	sim.reset_count++;
+	fprintf(stderr, "sim: %s reset at cycle %llu\n", reason, (unsigned long long)sim.cycle);
+}
+
+#pragma endregion "Watchdog, Flash and Reset Controller Functions"
+
+#pragma region "NVIC and Core Functions"
+
+/**
+ * @brief Calls pending interrupts, highest priority first, for as long as any outrank whatever is running. A handler
+ * that never clears its flag is reported and disabled rather than hanging the host.
+ *
+ * @return void
+ */
+static void dispatch_interrupts(void)
+{
+	uint32_t IRQn;
+	uint32_t chosen_IRQn;
+	uint32_t chosen_priority;
+	uint32_t interrupted_priority;
+
+	while(!sim.nvic.is_primask_set)
+	{
+		chosen_IRQn = PERIPH_COUNT_IRQn;
+		chosen_priority = sim.nvic.active_priority;
+
+		for(IRQn = 0; IRQn < PERIPH_COUNT_IRQn; IRQn++)
+		{
+			if(sim.nvic.is_enabled[IRQn] && (sim.nvic.priority[IRQn] < chosen_priority) && is_irq_pending(IRQn))
+			{
+				chosen_IRQn = IRQn;
+				chosen_priority = sim.nvic.priority[IRQn];
+			}
+		}
+
+		if(chosen_IRQn == PERIPH_COUNT_IRQn)
+		{
+			return;
+		}
+
+		if(sim.nvic.last_dispatch_cycle[chosen_IRQn] == sim.cycle)
+		{
+			if(++sim.nvic.dispatches_this_cycle[chosen_IRQn] > SIM_STUCK_IRQ_LIMIT)
+			{
+				fprintf(stderr, "sim: IRQ %u never clears, disabling it\n", (unsigned int)chosen_IRQn);
+				sim.nvic.is_enabled[chosen_IRQn] = false;
+				continue;
+			}
+		}
+		else
+		{
+			sim.nvic.last_dispatch_cycle[chosen_IRQn] = sim.cycle;
+			sim.nvic.dispatches_this_cycle[chosen_IRQn] = 1;
+		}
+
+		interrupted_priority = sim.nvic.active_priority;
+		sim.nvic.active_priority = chosen_priority;
+		sim.nvic.handler[chosen_IRQn]();
+		sim.nvic.active_priority = interrupted_priority;
+	}
+}
+
+static bool is_irq_pending(uint32_t IRQn)
+{
+	struct sim_tc_channel *channel;
+	Pio *pio;
+	Uart *uart;
+	uint32_t status;
+
+	switch(IRQn)
+	{
+		case TC0_IRQn: case TC1_IRQn: case TC2_IRQn:
+		case TC3_IRQn: case TC4_IRQn: case TC5_IRQn:
+		case TC6_IRQn: case TC7_IRQn: case TC8_IRQn:
+			channel = &sim.tc[IRQn - TC0_IRQn];
+			return((channel->status & channel->registers->TC_IMR.value) != 0);
+
+		case PIOA_IRQn: case PIOB_IRQn: case PIOC_IRQn:
+		case PIOD_IRQn: case PIOE_IRQn:
+			pio = sim.pio[IRQn - PIOA_IRQn].registers;
+			return((pio->PIO_ISR.value & pio->PIO_IMR.value) != 0);
+
+		case SPI_IRQn:
+			status = sim.spi.is_end_of_tx_latched ? SPI_SR_ENDTX : 0;
+			status |= ((sim_PDC_SPI.PERIPH_TCR.value == 0) && (sim_PDC_SPI.PERIPH_TNCR.value == 0)) ? SPI_SR_TXBUFE : 0;
+			status |= sim.spi.is_tdr_full ? 0 : SPI_SR_TDRE;
+			return((status & sim_SPI.SPI_IMR.value) != 0);
+
+		case UART0_IRQn: case UART1_IRQn:
+			uart = (IRQn == UART0_IRQn) ? &sim_UART0 : &sim_UART1;
+			status = UART_SR_TXRDY | UART_SR_TXEMPTY | uart->UART_SR.value;
+			status |= (get_uart(uart)->rx.head != get_uart(uart)->rx.tail) ? UART_SR_RXRDY : 0;
+			return((status & uart->UART_IMR.value) != 0);
+
+		default:
+			return(false);
+	}
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	sim.nvic.is_enabled[IRQn] = true;
+	dispatch_interrupts();
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	sim.nvic.is_enabled[IRQn] = false;
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+	sim.nvic.priority[IRQn] = priority & 0xF;                   //4 priority bits on the SAM4E
+}
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+	return(is_irq_pending(IRQn) ? 1 : 0);
+}
+
+void __disable_irq(void)
+{
+	sim.nvic.is_primask_set = true;
+}
+
+void __enable_irq(void)
+{
+	sim.nvic.is_primask_set = false;
+	dispatch_interrupts();
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return(sim.nvic.is_primask_set ? 1 : 0);
+}
+
+extern "C"
+{
+	void SystemInit(void)
+	{
+		SystemCoreClock = SIM_CORE_CLOCK_FREQUENCY;
+	}
+
+	//stand-ins for the handlers the firmware doesn't define in this configuration
+	__attribute__ ((weak)) void PIOA_Handler(void) {}
+	__attribute__ ((weak)) void PIOB_Handler(void) {}
+	__attribute__ ((weak)) void PIOC_Handler(void) {}
+	__attribute__ ((weak)) void PIOD_Handler(void) {}
+	__attribute__ ((weak)) void PIOE_Handler(void) {}
+	__attribute__ ((weak)) void SPI_Handler(void) {}
+	__attribute__ ((weak)) void TC0_Handler(void) {}
+	__attribute__ ((weak)) void TC1_Handler(void) {}
+	__attribute__ ((weak)) void TC2_Handler(void) {}
+	__attribute__ ((weak)) void TC3_Handler(void) {}
+	__attribute__ ((weak)) void TC4_Handler(void) {}
+	__attribute__ ((weak)) void TC5_Handler(void) {}
+	__attribute__ ((weak)) void TC6_Handler(void) {}
+	__attribute__ ((weak)) void TC7_Handler(void) {}
+	__attribute__ ((weak)) void TC8_Handler(void) {}
+	__attribute__ ((weak)) void UART0_Handler(void) {}
+	__attribute__ ((weak)) void UART1_Handler(void) {}
+}
+
+#pragma endregion "NVIC and Core Functions"
@@ -0,0 +1,154 @@
+/** @file sam4e_sim.h
+ *  @brief interface definition for the host build's simulated SAM4E peripherals
+ *
+ *  The registers declared in the host sam.h land here. Time only moves when the harness calls sim_run_cycles(), or when
+ *  the firmware polls a status register in a loop (SPI_SR, EEFC_FSR, UART_SR), each read of which costs
+ *  SIM_STATUS_POLL_CYCLES. As time passes the timers count, the SPI shifts, the watchdog runs down, and any interrupt that
+ *  comes pending is called straight away from inside the simulator, honouring NVIC priorities and PRIMASK.
+ *
+ *  Code itself takes no simulated time, so an ISR always finishes the instant it starts. Overrun detection and the
+ *  profiler will read zero, and nothing here stands in for them on target.
+ *
+ *  Modeled well enough for the firmware:
+ *  - TC: waveform UP_RC with RA/RC compares, TIOA actions, CPCDIS and CPCSTOP. Capture mode with LDRA on TIOA edges.
+ *  - SPI and its PDC: fixed and variable peripheral select, TCR/TNCR reloads, ENDTX/TXBUFE, DLYBS, DLYBCT and DLYBCS.
+ *  - The AD5791 on NPCS0: 24-bit frames latched by SYNC, LDAC on TIOA3, every DAC register update recorded.
+ *  - PIO: set/clear/ODSR writes, input levels, and edge or level interrupts.
+ *  - UART: THR/RHR through small FIFOs. No PDC, the host build swaps the UART circular buffer for a loopback.
+ *  - WDT, EFC GPNVM commands and RSTC resets, which are counted rather than acted on.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#ifndef SAM4E_SIM_H_
+#define SAM4E_SIM_H_
+
+#include "sam.h"
+
+#define SIM_CORE_CLOCK_FREQUENCY    120000000   //Hz, what SystemInit() sets SystemCoreClock to on target
+#define SIM_SLOW_CLOCK_FREQUENCY    32768       //Hz
+#define SIM_STATUS_POLL_CYCLES      8           //cycles each polled status register read costs, so busy-wait loops make progress
+#define SIM_EFC_COMMAND_CYCLES      12000       //~100uS, GPNVM bit commands
+#define SIM_STUCK_IRQ_LIMIT         10000       //dispatches of one IRQ without time moving before it's reported and disabled
+
+typedef struct
+{
+	uint64_t cycle;                             //core clock cycle the DAC register took the code
+	int32_t code;                               //signed 20-bit DAC code
+}sim_DAC_sample_type;
+
+/**
+ * \brief Puts every peripheral back to its reset state and time back to 0. The capture buffer, if one is set, is emptied.
+ *
+ * \return void
+ */
+void sim_reset(void);
+
+/**
+ * \brief Runs simulated time forward, servicing any interrupts that come due on the way.
+ *
+ * \param cycles core clock cycles to run
+ *
+ * \return void
+ */
+void sim_run_cycles(uint64_t cycles);
+
+/**
+ * \brief Gets the simulated time.
+ *
+ * \return uint64_t core clock cycles since sim_reset()
+ */
+uint64_t sim_get_cycle_count(void);
+
+/**
+ * \brief Drives input pins. Edges are fed to the PIO's edge detection, and PC29 also feeds the sync in capture on TIOA5.
+ *
+ * \param pio port, e.g. PIOE
+ * \param mask pins to drive, e.g. PIO_PDSR_P6
+ * \param is_high level to drive them to
+ *
+ * \return void
+ */
+void sim_set_pin_input(Pio *pio, uint32_t mask, bool is_high);
+
+/**
+ * \brief Gets the level on a port's pins, as an output drives them or as an input was set.
+ *
+ * \param pio port
+ *
+ * \return uint32_t one bit per pin
+ */
+uint32_t sim_get_pin_levels(Pio *pio);
+
+/**
+ * \brief Gives the AD5791 model somewhere to record DAC register updates. Recording stops once it's full.
+ *
+ * \param buffer destination, or NULL to stop recording
+ * \param size entries it holds
+ *
+ * \return void
+ */
+void sim_set_DAC_capture_buffer(sim_DAC_sample_type *buffer, uint32_t size);
+
+/**
+ * \brief Gets how many DAC register updates have been recorded since the buffer was set.
+ *
+ * \return uint32_t entries used
+ */
+uint32_t sim_get_DAC_capture_count(void);
+
+/**
+ * \brief Gets the AD5791 registers as they stand.
+ *
+ * \param DAC_code the DAC register, signed 20-bit. NULL if not wanted.
+ * \param control_register the control register. NULL if not wanted.
+ *
+ * \return void
+ */
+void sim_get_DAC_registers(int32_t *DAC_code, uint32_t *control_register);
+
+/**
+ * \brief Gets the count of AD5791 frames that weren't 24 bits long, which the part ignores.
+ *
+ * \return uint32_t malformed frames since sim_reset()
+ */
+uint32_t sim_get_DAC_frame_error_count(void);
+
+/**
+ * \brief Queues bytes on a UART's receiver.
+ *
+ * \param uart UART0 or UART1
+ * \param data bytes
+ * \param number_of_bytes how many
+ *
+ * \return void
+ */
+void sim_write_UART_Rx_bytes(Uart *uart, const char *data, uint32_t number_of_bytes);
+
+/**
+ * \brief Takes bytes the firmware wrote to a UART's THR.
+ *
+ * \param uart UART0 or UART1
+ * \param data destination
+ * \param maximum_number_of_bytes room in the destination
+ *
+ * \return uint32_t bytes copied out
+ */
+uint32_t sim_read_UART_Tx_bytes(Uart *uart, char *data, uint32_t maximum_number_of_bytes);
+
+/**
+ * \brief Gets the number of resets the firmware has asked for, through RSTC or by letting the watchdog run out.
+ *
+ * \return uint32_t resets since sim_reset()
+ */
+uint32_t sim_get_reset_count(void);
+
+/**
+ * \brief Gets the EFC's general purpose NVM bits.
+ *
+ * \return uint32_t bit n is GPNVM n
+ */
+uint32_t sim_get_GPNVM_bits(void);
+
+#endif /* SAM4E_SIM_H_ */
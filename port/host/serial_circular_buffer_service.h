@@ -0,0 +1,57 @@
+/** @file serial_circular_buffer_service.h
+ *  @brief host build stand in for the LSCI library's serial circular buffer service
+ *
+ *  port/host is ahead of "LSCI libraries" on the host include path, as it is for sam.h, so android_comm_interface_manager.cpp
+ *  builds unchanged against this header. It keeps the library's class name and init() signature, but the class is the
+ *  loopback circular buffer: there's no UART PDC to feed it, so the uart port, baud rate and parity are accepted and ignored.
+ *  The far end reaches the instance through the same mySerialCircularBuffer the firmware declares.
+ *
+ *  The include guard matches the library header's, so only one of the two can ever be seen in a translation unit.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+
+#ifndef SERIAL_CIRCULAR_BUFFER_SERVICE_H_
+#define SERIAL_CIRCULAR_BUFFER_SERVICE_H_
+
+#include "HAL_serial_circular_buffer.h"
+#include "loopback_circular_buffer.h"
+
+//same values as the library's, they're only passed through here
+typedef enum {UART_PARITY_EVEN = 0, UART_PARITY_ODD, UART_PARITY_SPACE, UART_PARITY_MARK, UART_PARITY_NONE} uart_parity_selection_t;
+
+class serial_circular_buffer : public loopback_circular_buffer
+{
+	public:
+		/**
+		 * @brief initialization routine, with serial_circular_buffer's signature
+		 *
+		 * @param uart_port_base_addr ignored, the loopback has no UART
+		 * @param Rx_buffer_ptr pointer to the buffer that will hold bytes written in by the far end
+		 * @param Rx_buffer_size_in_bytes size of the Rx buffer, in bytes
+		 * @param Tx_buffer_ptr pointer to the buffer that will hold transmitted bytes until the far end reads them
+		 * @param Tx_buffer_size_in_bytes size of the Tx buffer, in bytes
+		 * @param baud_rate ignored
+		 * @param parity ignored
+		 *
+		 * @return void
+		 */
+		void init(uart_t uart_port_base_addr,
+				  char *Rx_buffer_ptr,
+				  uint32_t Rx_buffer_size_in_bytes,
+				  char *Tx_buffer_ptr,
+				  uint32_t Tx_buffer_size_in_bytes,
+				  uint32_t baud_rate = 115200,
+				  uart_parity_selection_t parity = UART_PARITY_NONE)
+		{
+			(void)uart_port_base_addr;
+			(void)baud_rate;
+			(void)parity;
+			loopback_circular_buffer::init(Rx_buffer_ptr, Rx_buffer_size_in_bytes, Tx_buffer_ptr, Tx_buffer_size_in_bytes);
+		}
+};
+
+
+#endif /* SERIAL_CIRCULAR_BUFFER_SERVICE_H_ */
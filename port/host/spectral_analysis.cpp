@@ -0,0 +1,321 @@
+/** @file spectral_analysis.cpp
+ *  @brief Implementation file for the functions declared in spectral_analysis.h
+ *
+ *  Everything is done in double. The DAC codes only need 20 bits, but the window's sidelobes and the spurs being looked
+ *  for are both well below what float could hold onto next to the fundamental.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "spectral_analysis.h"
+#include <math.h>
+#include <stdlib.h>
+
+#pragma region "defintions and variables for the spectral analysis"
+
+#define SPECTRAL_PI                 3.14159265358979323846
+#define SPECTRAL_POWER_FLOOR        1e-300      //keeps log10() finite when a record is spotless
+
+static const double blackman_harris_7_term_coefficients[7] =    //a0 - a1 cos(x) + a2 cos(2x) - ..., signs folded in
+{
+	0.27105140069342, -0.43329793923448, 0.21812299954311, -0.06592544638803,
+	0.01081174209837, -0.00077658482522, 0.00001388721735
+};
+
+static double get_window_value(uint32_t index, uint32_t length);
+static void run_FFT(double *real, double *imaginary, uint32_t length);
+static double get_tone_power(const double *power, uint32_t last_bin, uint32_t center_bin);
+static double get_tone_frequency(const int32_t *codes, uint32_t number_of_samples, double sampling_frequency, double coarse_frequency);
+static double get_decibels(double numerator, double denominator);
+
+#pragma endregion "defintions and variables for the spectral analysis"
+
+#pragma region "spectral analysis functions"
+
+bool measure_sine_spectrum(const int32_t *codes, uint32_t number_of_samples, double sampling_frequency, double expected_frequency, spectral_metrics_type *metrics)
+{
+	const uint32_t half_width = SPECTRAL_TONE_HALF_WIDTH_BINS;
+	uint32_t last_bin = number_of_samples / 2;
+	double *real;
+	double *imaginary;
+	double window_energy = 0;
+	double fundamental_power, spur_power, harmonic_power = 0, noise_and_distortion_power = 0, power;
+	double bin_spacing = sampling_frequency / number_of_samples;
+	double harmonic_frequency, peak_offset;
+	uint32_t expected_bin, fundamental_bin, spur_bin = 0, harmonic_bin, search_start, search_stop;
+	uint32_t i;
+	uint32_t harmonic;
+
+	if((number_of_samples < 2) || (number_of_samples & (number_of_samples - 1)) ||
+	   ((expected_frequency * number_of_samples / sampling_frequency) < SPECTRAL_MINIMUM_CYCLES))
+	{
+		return(false);
+	}
+
+	real = (double *)malloc(number_of_samples * sizeof(double));
+	imaginary = (double *)malloc(number_of_samples * sizeof(double));
+
+	if((real == NULL) || (imaginary == NULL))
+	{
+		free(real);
+		free(imaginary);
+		return(false);
+	}
+
+	for(i = 0; i < number_of_samples; i++)
+	{
+		double window = get_window_value(i, number_of_samples);
+
+		real[i] = window * codes[i];
+		imaginary[i] = 0;
+		window_energy += window * window;
+	}
+
+	run_FFT(real, imaginary, number_of_samples);
+
+	for(i = 0; i <= last_bin; i++)
+	{
+		real[i] = (real[i] * real[i]) + (imaginary[i] * imaginary[i]);      //one sided power spectrum, reusing real[]
+	}
+
+	//fundamental is the biggest bin within a couple of lobe widths of where it was asked for
+	expected_bin = (uint32_t)((expected_frequency / bin_spacing) + 0.5);
+	search_start = (expected_bin > (2 * half_width + 1)) ? (expected_bin - 2 * half_width) : 1;
+	search_stop = ((expected_bin + 2 * half_width) < last_bin) ? (expected_bin + 2 * half_width) : (last_bin - 1);
+	fundamental_bin = search_start;
+
+	for(i = search_start; i <= search_stop; i++)
+	{
+		if(real[i] > real[fundamental_bin])
+		{
+			fundamental_bin = i;
+		}
+	}
+
+	fundamental_power = get_tone_power(real, last_bin, fundamental_bin);
+
+	//parabola through the log of the peak and its neighbours gets within a fraction of a bin, which the phase measurement then refines
+	peak_offset = 0;
+	if((fundamental_bin > 1) && (fundamental_bin < last_bin) && (real[fundamental_bin - 1] > 0) && (real[fundamental_bin + 1] > 0))
+	{
+		double below = log(real[fundamental_bin - 1]);
+		double peak = log(real[fundamental_bin]);
+		double above = log(real[fundamental_bin + 1]);
+
+		peak_offset = 0.5 * (below - above) / (below - 2 * peak + above);
+	}
+
+	metrics->measured_frequency = get_tone_frequency(codes, number_of_samples, sampling_frequency, (fundamental_bin + peak_offset) * bin_spacing);
+	metrics->fundamental_amplitude = sqrt(4 * fundamental_power / (number_of_samples * window_energy));
+
+	//largest spur: any lobe that doesn't overlap DC's or the fundamental's
+	spur_power = 0;
+	for(i = (2 * half_width) + 1; i <= last_bin; i++)
+	{
+		if((i + 2 * half_width >= fundamental_bin) && (i <= fundamental_bin + 2 * half_width))
+		{
+			continue;
+		}
+
+		power = get_tone_power(real, last_bin, i);
+
+		if(power > spur_power)
+		{
+			spur_power = power;
+			spur_bin = i;
+		}
+	}
+
+	metrics->SFDR = get_decibels(fundamental_power, spur_power);
+	metrics->spur_frequency = spur_bin * bin_spacing;
+
+	//harmonics, folded back into the first Nyquist zone. Any that land on DC or the fundamental can't be told apart, so are left out.
+	for(harmonic = 2; harmonic <= SPECTRAL_HARMONICS; harmonic++)
+	{
+		harmonic_frequency = fmod(harmonic * metrics->measured_frequency, sampling_frequency);
+
+		if(harmonic_frequency > (sampling_frequency / 2))
+		{
+			harmonic_frequency = sampling_frequency - harmonic_frequency;
+		}
+
+		harmonic_bin = (uint32_t)((harmonic_frequency / bin_spacing) + 0.5);
+
+		if((harmonic_bin > 2 * half_width) && ((harmonic_bin + 2 * half_width < fundamental_bin) || (harmonic_bin > fundamental_bin + 2 * half_width)))
+		{
+			harmonic_power += get_tone_power(real, last_bin, harmonic_bin);
+		}
+	}
+
+	metrics->THD = get_decibels(harmonic_power, fundamental_power);
+
+	for(i = half_width + 1; i <= last_bin; i++)
+	{
+		if((i + half_width < fundamental_bin) || (i > fundamental_bin + half_width))
+		{
+			noise_and_distortion_power += real[i];
+		}
+	}
+
+	metrics->SINAD = get_decibels(fundamental_power, noise_and_distortion_power);
+
+	free(real);
+	free(imaginary);
+
+	return(true);
+}
+
+/**
+ * @brief Periodic 7-term Blackman-Harris window
+ *
+ * @param index sample
+ * @param length samples in the record
+ *
+ * @return double window weight
+ */
+static double get_window_value(uint32_t index, uint32_t length)
+{
+	double angle = (2 * SPECTRAL_PI * index) / length;
+	double value = 0;
+	uint32_t term;
+
+	for(term = 0; term < 7; term++)
+	{
+		value += blackman_harris_7_term_coefficients[term] * cos(term * angle);
+	}
+
+	return(value);
+}
+
+/**
+ * @brief In place radix-2 complex FFT. Twiddles are worked out directly for each bin rather than by recurrence,
+ * since a recurrence's rounding error would show up as spurs near the floor being measured.
+ *
+ * @param real real parts, replaced by the transform's
+ * @param imaginary imaginary parts, replaced by the transform's
+ * @param length points, a power of 2
+ *
+ * @return void
+ */
+static void run_FFT(double *real, double *imaginary, uint32_t length)
+{
+	uint32_t i, j, bit, span, start, k;
+	double temp_real, temp_imaginary, twiddle_real, twiddle_imaginary;
+
+	for(i = 1, j = 0; i < length; i++)              //bit reversed reorder
+	{
+		for(bit = length >> 1; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j |= bit;
+
+		if(i < j)
+		{
+			temp_real = real[i];
+			real[i] = real[j];
+			real[j] = temp_real;
+			temp_imaginary = imaginary[i];
+			imaginary[i] = imaginary[j];
+			imaginary[j] = temp_imaginary;
+		}
+	}
+
+	for(span = 1; span < length; span <<= 1)
+	{
+		for(k = 0; k < span; k++)
+		{
+			twiddle_real = cos((SPECTRAL_PI * k) / span);
+			twiddle_imaginary = -sin((SPECTRAL_PI * k) / span);
+
+			for(start = k; start < length; start += (span << 1))
+			{
+				temp_real = (twiddle_real * real[start + span]) - (twiddle_imaginary * imaginary[start + span]);
+				temp_imaginary = (twiddle_real * imaginary[start + span]) + (twiddle_imaginary * real[start + span]);
+				real[start + span] = real[start] - temp_real;
+				imaginary[start + span] = imaginary[start] - temp_imaginary;
+				real[start] += temp_real;
+				imaginary[start] += temp_imaginary;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Sums the power across a tone's main lobe. Summed directly each time, as running sums would lose small
+ * spurs to rounding next to the fundamental.
+ *
+ * @param power one sided power spectrum
+ * @param last_bin its last bin, the Nyquist bin
+ * @param center_bin the tone
+ *
+ * @return double tone power
+ */
+static double get_tone_power(const double *power, uint32_t last_bin, uint32_t center_bin)
+{
+	uint32_t first = (center_bin > SPECTRAL_TONE_HALF_WIDTH_BINS) ? (center_bin - SPECTRAL_TONE_HALF_WIDTH_BINS) : 0;
+	uint32_t last = ((center_bin + SPECTRAL_TONE_HALF_WIDTH_BINS) < last_bin) ? (center_bin + SPECTRAL_TONE_HALF_WIDTH_BINS) : last_bin;
+	double sum = 0;
+	uint32_t i;
+
+	for(i = first; i <= last; i++)
+	{
+		sum += power[i];
+	}
+
+	return(sum);
+}
+
+/**
+ * @brief Refines a frequency estimate from the fundamental's phase in each half of the record. Both halves are
+ * correlated at the estimate using the same time base, so any frequency error shows up as a phase step between them.
+ *
+ * @param codes the samples
+ * @param number_of_samples how many
+ * @param sampling_frequency Hz
+ * @param coarse_frequency Hz, within a bin of the truth
+ *
+ * @return double measured frequency, Hz
+ */
+static double get_tone_frequency(const int32_t *codes, uint32_t number_of_samples, double sampling_frequency, double coarse_frequency)
+{
+	uint32_t half_length = number_of_samples / 2;
+	double radians_per_sample = (2 * SPECTRAL_PI * coarse_frequency) / sampling_frequency;
+	double first_real = 0, first_imaginary = 0, second_real = 0, second_imaginary = 0;
+	double window, angle, phase_step;
+	uint32_t i;
+
+	for(i = 0; i < half_length; i++)
+	{
+		window = get_window_value(i, half_length);
+
+		angle = radians_per_sample * i;
+		first_real += window * codes[i] * cos(angle);
+		first_imaginary -= window * codes[i] * sin(angle);
+
+		angle = radians_per_sample * (i + half_length);
+		second_real += window * codes[i + half_length] * cos(angle);
+		second_imaginary -= window * codes[i + half_length] * sin(angle);
+	}
+
+	//phase of second * conj(first), +/-pi
+	phase_step = atan2((second_imaginary * first_real) - (second_real * first_imaginary), (second_real * first_real) + (second_imaginary * first_imaginary));
+
+	return(coarse_frequency + (phase_step * sampling_frequency) / (2 * SPECTRAL_PI * half_length));
+}
+
+/**
+ * @brief Power ratio in dB, kept finite
+ *
+ * @param numerator power
+ * @param denominator power
+ *
+ * @return double dB
+ */
+static double get_decibels(double numerator, double denominator)
+{
+	return(10 * log10((numerator + SPECTRAL_POWER_FLOOR) / (denominator + SPECTRAL_POWER_FLOOR)));
+}
+
+#pragma endregion "spectral analysis functions"
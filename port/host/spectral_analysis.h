@@ -0,0 +1,49 @@
+/** @file spectral_analysis.h
+ *  @brief single tone spectral measurements on a captured DAC code stream, for host programs
+ *
+ *  The record is windowed with a 7-term Blackman-Harris window, whose sidelobes sit ~180dB down, so leakage from a tone
+ *  that doesn't land exactly on a bin stays well under the 20-bit DAC's quantization floor. No coherent sampling needed.
+ *  Tones are measured as the power summed across the window's main lobe, so a fundamental and its spurs compare fairly
+ *  wherever they fall between bins.
+ *
+ *  The frequency is measured from how the fundamental's phase moves between the two halves of the record, which resolves
+ *  far finer than the bin spacing.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+
+#ifndef SPECTRAL_ANALYSIS_H_
+#define SPECTRAL_ANALYSIS_H_
+
+#include <stdint.h>
+
+#define SPECTRAL_TONE_HALF_WIDTH_BINS   7           //7-term Blackman-Harris main lobe spans +/-7 bins
+#define SPECTRAL_HARMONICS              10          //THD sums the 2nd up to this one, aliased back into the 1st Nyquist zone
+#define SPECTRAL_MINIMUM_CYCLES         32          //the frequency measurement needs the fundamental well clear of DC in each half record
+
+typedef struct
+{
+	double measured_frequency;                      //Hz
+	double SFDR;                                    //dBc, fundamental over the largest spur other than DC
+	double spur_frequency;                          //Hz, where that largest spur is
+	double THD;                                     //dBc, harmonics 2 to SPECTRAL_HARMONICS over the fundamental
+	double SINAD;                                   //dB, fundamental over everything else but DC
+	double fundamental_amplitude;                   //DAC codes, peak
+}spectral_metrics_type;
+
+/**
+ * \brief Measures a sine captured as DAC codes at a fixed sample rate.
+ *
+ * \param codes the samples
+ * \param number_of_samples how many. A power of 2, and at least SPECTRAL_MINIMUM_CYCLES cycles of the sine.
+ * \param sampling_frequency Hz
+ * \param expected_frequency Hz, where to look for the fundamental
+ * \param metrics results
+ *
+ * \return bool false if the record isn't a power of 2, is too short, or there's no room for the FFT
+ */
+bool measure_sine_spectrum(const int32_t *codes, uint32_t number_of_samples, double sampling_frequency, double expected_frequency, spectral_metrics_type *metrics);
+
+#endif /* SPECTRAL_ANALYSIS_H_ */
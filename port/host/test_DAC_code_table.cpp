@@ -0,0 +1,243 @@
+/** @file test_DAC_code_table.cpp
+ *  @brief host tests for the DDS code table generation in output_control.cpp
+ *
+ *  Runs the firmware on the simulated SAM4E and checks the tables the fixed-point kernels write, so the tables can be
+ *  looked at directly, output_control.cpp is included here rather than linked. Each test prints PASS or FAIL with the
+ *  first mismatch, and the program exits nonzero if any failed.
+ *
+ *  Usage: test_DAC_code_table. Build and run with make -C port/host test, which takes the same DEFINES as the other
+ *  host programs. With DDS_ON_THE_FLY_SCALING_ENABLED there are no tables to check, and the tests report as skipped.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "sam4e_sim.h"
+#include "host_firmware.h"
+#include "../../source/output_control.cpp"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_FULL_SCALE_DIVISOR             10.0f   //the 10V range
+#define TEST_CALIBRATION_POINT              0
+#define TEST_CALIBRATION_GAIN               1.00037f
+#define TEST_CALIBRATION_OFFSET             0.00123f    //volts, so the bias isn't a whole number of codes
+#define TEST_OFFSET_AMPLITUDE               6.3f
+#define TEST_OFFSET_STEPS                   64
+#define TEST_OFFSET_STEP                    0.1913f     //sweeps the peaks well past both rails and back
+#define TEST_MAXIMUM_KERNEL_ERROR           1           //LSBs between the fixed-point kernel and COMPUTE_AD5791_CODE, which truncates where the kernel rounds
+
+typedef bool (*test_function_type)(void);
+
+typedef struct
+{
+	const char *name;
+	test_function_type function;
+}test_type;
+
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+static void start_test_firmware(float gain, float offset);
+static uint32_t find_first_table_difference(const AD5791_frame_type *table, const AD5791_frame_type *expected_table);
+static bool test_offset_steps_match_full_recompute(void);
+static bool test_sine_kernel_matches_float_codes(void);
+#endif
+
+static const test_type tests[] =
+{
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+	{"offset steps match a full recompute", test_offset_steps_match_full_recompute},
+	{"sine kernel matches COMPUTE_AD5791_CODE", test_sine_kernel_matches_float_codes},
+#endif
+	{NULL, NULL}
+};
+
+int main(void)
+{
+	uint32_t failures = 0;
+	uint32_t i;
+
+	for(i = 0; tests[i].function != NULL; i++)
+	{
+		if(tests[i].function())
+		{
+			printf("PASS %s\n", tests[i].name);
+		}
+		else
+		{
+			printf("FAIL %s\n", tests[i].name);
+			failures++;
+		}
+	}
+
+	if(i == 0)
+	{
+		printf("SKIP no code tables with DDS_ON_THE_FLY_SCALING_ENABLED\n");
+	}
+
+	printf("%u of %u tests failed\n", failures, i);
+
+	return((failures == 0) ? 0 : 1);
+}
+
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+/**
+ * @brief Starts the firmware afresh, with the test range's calibration set to the gain and offset given
+ *
+ * @param gain calibration gain of TEST_CALIBRATION_POINT
+ * @param offset calibration offset of TEST_CALIBRATION_POINT, in volts
+ *
+ * @return void
+ */
+static void start_test_firmware(float gain, float offset)
+{
+	sim_reset();
+	init_all();
+	test_init_function();
+
+	calibration_data.voltage.gains[TEST_CALIBRATION_POINT] = gain;
+	calibration_data.voltage.offsets[TEST_CALIBRATION_POINT] = offset;
+	invalidate_DAC_calibration();
+	select_DAC_calibration(TEST_CALIBRATION_POINT, TEST_FULL_SCALE_DIVISOR);
+}
+
+/**
+ * @brief Compares two code tables
+ *
+ * @param table table under test
+ * @param expected_table what it should hold
+ *
+ * @return uint32_t first point that differs, SINE_TABLE_SIZE if none do
+ */
+static uint32_t find_first_table_difference(const AD5791_frame_type *table, const AD5791_frame_type *expected_table)
+{
+	uint32_t i;
+
+	for(i = 0; i < SINE_TABLE_SIZE; i++)
+	{
+		if(memcmp(&table[i], &expected_table[i], sizeof(AD5791_frame_type)) != 0)
+		{
+			break;
+		}
+	}
+
+	return(i);
+}
+
+/**
+ * @brief Steps the offset TEST_OFFSET_STEPS times, through both rails and back, at a fixed amplitude and range, then checks the
+ * live table is bit for bit the one a fresh start generates for the last offset. Any rounding or clipping carried from one
+ * table into the next would show up as a difference.
+ *
+ * @return bool true = passed
+ */
+static bool test_offset_steps_match_full_recompute(void)
+{
+	static AD5791_frame_type stepped_table[SINE_TABLE_SIZE];
+	static const output_shape_type shapes[] = {SHAPE_SINE, SHAPE_TRIANGLE, SHAPE_RAMP};
+	float offset = 0;
+	uint32_t shape;
+	uint32_t step;
+	uint32_t point;
+	bool is_passed = true;
+
+	for(shape = 0; shape < (sizeof(shapes) / sizeof(shapes[0])); shape++)
+	{
+		start_test_firmware(TEST_CALIBRATION_GAIN, TEST_CALIBRATION_OFFSET);
+		output.waveform_shape = shapes[shape];
+
+		for(step = 0; step < TEST_OFFSET_STEPS; step++)
+		{
+			offset = (step < (TEST_OFFSET_STEPS / 2)) ? (step * TEST_OFFSET_STEP) : ((TEST_OFFSET_STEPS - step) * -TEST_OFFSET_STEP);
+			generate_DAC_code_table(TEST_OFFSET_AMPLITUDE, offset, TEST_FULL_SCALE_DIVISOR);
+		}
+		memcpy(stepped_table, output.int_DAC_code_table[output.active_DAC_table_index], sizeof(stepped_table));
+
+		start_test_firmware(TEST_CALIBRATION_GAIN, TEST_CALIBRATION_OFFSET);
+		output.waveform_shape = shapes[shape];
+		generate_DAC_code_table(TEST_OFFSET_AMPLITUDE, offset, TEST_FULL_SCALE_DIVISOR);
+
+		point = find_first_table_difference(stepped_table, output.int_DAC_code_table[output.active_DAC_table_index]);
+		if(point < SINE_TABLE_SIZE)
+		{
+			printf("     shape %u, offset %g: point %u is code %d, a full recompute gives %d\n", (unsigned int)shapes[shape], offset, point,
+			       unpack_AD5791_frame(&stepped_table[point]), unpack_AD5791_frame(&output.int_DAC_code_table[output.active_DAC_table_index][point]));
+			is_passed = false;
+		}
+	}
+
+	return(is_passed);
+}
+
+/**
+ * @brief Checks compute_DAC_code_table() against the float COMPUTE_AD5791_CODE it replaced, point by point, across amplitudes,
+ * offsets and every range's full scale divisor. Calibration is left at unity gain and no offset, so both see the same level.
+ * Levels that would go past full scale are skipped, COMPUTE_AD5791_CODE wraps rather than saturates.
+ *
+ * @return bool true = passed
+ */
+static bool test_sine_kernel_matches_float_codes(void)
+{
+	static const float full_scale_divisors[] = {FULL_SCALE_100V_RANGE_VALUE, FULL_SCALE_10V_RANGE_VALUE, FULL_SCALE_1V_RANGE_VALUE,
+	                                            FULL_SCALE_100MV_RANGE_VALUE, FULL_SCALE_10MV_RANGE_VALUE, FULL_SCALE_100MA_RANGE_VALUE,
+	                                            FULL_SCALE_10MA_RANGE_VALUE, FULL_SCALE_1MA_RANGE_VALUE, FULL_SCALE_100UA_RANGE_VALUE,
+	                                            FULL_SCALE_10UA_RANGE_VALUE, FULL_SCALE_1UA_RANGE_VALUE};
+	static const float amplitudes[] = {0.0f, 0.000003f, 0.001f, 0.123457f, 0.5f, 0.9f, 1.0f};        //of full scale
+	static const float offsets[] = {-0.5f, -0.1f, -0.0000031f, 0.0f, 0.0003f, 0.1f, 0.5f};
+	uint32_t range, amplitude_index, offset_index;
+	uint32_t i;
+	float full_scale_divisor, amplitude, offset;
+	int32_t amplitude_scale, offset_scale;
+	int32_t DAC_code, expected_DAC_code;
+	int32_t error, worst_error = 0;
+	uint32_t number_of_tables = 0;
+
+	start_test_firmware(1.0f, 0.0f);
+
+	for(range = 0; range < (sizeof(full_scale_divisors) / sizeof(full_scale_divisors[0])); range++)
+	{
+		full_scale_divisor = full_scale_divisors[range];
+		select_DAC_calibration(TEST_CALIBRATION_POINT, full_scale_divisor);
+
+		for(amplitude_index = 0; amplitude_index < (sizeof(amplitudes) / sizeof(amplitudes[0])); amplitude_index++)
+		{
+			for(offset_index = 0; offset_index < (sizeof(offsets) / sizeof(offsets[0])); offset_index++)
+			{
+				if((amplitudes[amplitude_index] + fabsf(offsets[offset_index])) > 1.0f)
+				{
+					continue;
+				}
+
+				amplitude = amplitudes[amplitude_index] * full_scale_divisor;
+				offset = offsets[offset_index] * full_scale_divisor;
+				amplitude_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(amplitude, full_scale_divisor), false);
+				offset_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(offset, full_scale_divisor), true);
+				compute_DAC_code_table(1, amplitude_scale, offset_scale, 0, SINE_QUARTER_TABLE_SIZE);
+				number_of_tables++;
+
+				for(i = 0; i < SINE_TABLE_SIZE; i++)
+				{
+					DAC_code = unpack_AD5791_frame(&output.int_DAC_code_table[1][i]);
+					expected_DAC_code = ((int32_t)COMPUTE_AD5791_CODE(offset + amplitude * get_sine_table_value(i), full_scale_divisor) << 12) >> 12;
+					error = abs(DAC_code - expected_DAC_code);
+					if(error > worst_error)
+					{
+						worst_error = error;
+					}
+					if(error > TEST_MAXIMUM_KERNEL_ERROR)
+					{
+						printf("     full scale %g, amplitude %g, offset %g: point %u is code %d, COMPUTE_AD5791_CODE gives %d\n",
+						       full_scale_divisor, amplitude, offset, i, DAC_code, expected_DAC_code);
+						return(false);
+					}
+				}
+			}
+		}
+	}
+
+	printf("     %u tables, worst difference %d LSB\n", number_of_tables, worst_error);
+
+	return(true);
+}
+#endif
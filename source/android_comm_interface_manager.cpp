@@ -16,6 +16,7 @@
 #include "serial_circular_buffer_service.h"
 #include "sources_command_callbacks.h"
 #include "sources_settings_callbacks.h"
+#include "profiler.h"
 
 //buffers and packet sizes are defined here in application to meet the application requirements
 #define ANDROID_TX_UART_BUFFER_SIZE			2048
@@ -59,7 +60,9 @@ void init_android_comm_interface(void)
 
 void execute_android_comm_packet_reception_state_machine(void)
 {	
+	PROFILE_BEGIN(PROFILE_PROBE_LSCP_PROCESSING);
 	myLSCPService.run_packet_reception_and_message_processing_state_machine();
+	PROFILE_END(PROFILE_PROBE_LSCP_PROCESSING);
 }
 
 void generate_local_setting_message(const char *setting_name)
@@ -32,6 +32,18 @@ void load_calibration_default_values(void)
         calibration_data.current.gains[counter] = 1.0;
         calibration_data.current.offsets[counter] = 0.0;
     }
+    
+    //frequency response
+    for(counter = 0; counter < NUMBER_OF_FREQUENCY_RESPONSE_POINTS; counter++)
+    {
+        calibration_data.frequency_response[counter] = 0.0;
+    }
+    
+    //INL
+    for(counter = 0; counter < NUMBER_OF_INL_CORRECTION_POINTS; counter++)
+    {
+        calibration_data.INL_corrections[counter] = 0.0;
+    }
 }
 
 void update_caldata_values_in_RAM(calibration_data_type udpated_calibration_data)
@@ -42,6 +42,15 @@ const char **execute_VersionInfo_command(void)
 }
 #pragma endregion "local VersionInfo command support functions"
 
+#pragma region "local Profile command support functions"
+const char *execute_Profile_command(uint32_t probe, bool reset, profile_probe_data_type *probe_data)
+{
+	get_profile_probe_data((profile_probe_type)probe, probe_data, reset);
+	
+	return(get_profile_probe_name((profile_probe_type)probe));
+}
+#pragma endregion "local Profile command support functions"
+
 #pragma region "input micro status support functions"
 uint32_t check_status_of_input_micro(uint32_t input_micro_number)
 {
@@ -6,10 +6,11 @@
  */ 
 
 #include "sam.h"
-#include "hal.h"                                //TODO: REMOVE!! - here for watchdog pet
+#include "HAL.h"                                //TODO: REMOVE!! - here for watchdog pet
 #include "android_comm_interface_manager.h"
 #include "output_control.h"
 #include "settings_manager.h"
+#include "profiler.h"
 
 void init_all(void);
 
@@ -35,6 +36,16 @@ int main(void)
 		PET_WATCHDOG();
 		
 		execute_android_comm_packet_reception_state_machine();      
+		
+		service_DAC_code_table_generation();                        //level changes fill the DAC code table a slice per pass
+		
+		service_frequency_sweep();                                  //sweep progress/completion notifications
+		
+		service_sync_in();                                          //phase lock gained/lost notifications
+		
+		service_DC_ramp();                                          //DC ramp complete notifications
+		
+		service_sample_overrun();                                   //missed sample notifications
         
         crude_ticker++;             //TODO: REMOVE THIS
 
@@ -89,6 +100,7 @@ void init_all() {
     
     // Setup the microcontroller itself
     init_processor();
+    init_profiler();
     
     // Delay to let the external supplies settle
     delay_ms(200);
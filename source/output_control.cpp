@@ -7,30 +7,242 @@
 
 #include "HAL.h"
 #include "output_control.h"
+#include "profiler.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #pragma region "defintions, prototypes and variables restricted to the scope of this module"
 
 #define AD5791_DAC_INIT_COMMAND 0x200302
 #define AD5791_DAC_WRITE_COMMAND 0x100000
+#define AD5791_DAC_DATA_MASK 0xFFFFF
+#define AD5791_DAC_DATA_BITS 20
+#define AD5791_DAC_POSITIVE_FULL_SCALE_CODE 0x7FFFF
+#define DAC_CODE_SCALE_FRACTION_BITS 11                     //sub-LSB resolution carried in the integer scale and bias (0x7FFFF << 11 still fits in 31 bits)
+#define DAC_TABLE_GENERATION_POINTS_PER_SLICE 256          //table points written per call to service_DAC_code_table_generation(). Bounds how long one main loop pass can be held off.
 #define COMPUTE_AD5791_CODE(voltage, full_scale_divisor) (AD5791_DAC_WRITE_COMMAND | (0xFFFFF & (int)(0x7FFFFu*((voltage)/(full_scale_divisor)))))
 
+#define DAC_STREAM_WORDS_PER_FRAME 3                //one PDC word per AD5791 frame byte when streaming in blocks
+#define AD5791_FRAME_BYTES 3
+
+typedef enum {DAC_TABLE_GENERATION_IDLE = 0, DAC_TABLE_GENERATION_COMPUTE, DAC_TABLE_GENERATION_SWAP_PENDING} DAC_table_generation_state_type;
+
+//One range's calibration, folded into the integer form the table kernels use: calibrated scale = (scale * gain_scale >> DAC_CALIBRATION_GAIN_FRACTION_BITS) + bias_scale
+typedef struct
+{
+	bool is_valid;
+	float full_scale_divisor;                               //what bias_scale was worked out against
+	int32_t gain_scale;
+	int32_t bias_scale;                                     //calibration offset, as returned by get_DAC_code_scale
+}DAC_calibration_type;
+
+//A DAC code table fill in progress. The pending half of int_DAC_code_table is filled a slice at a time and only made active once complete.
+typedef struct
+{
+	DAC_table_generation_state_type state;
+	uint32_t pending_active_DAC_table_index;
+	uint32_t next_point;                                    //next table point, or quarter table point for sine, to write
+	uint32_t generation_number;                             //becomes live_DAC_table_generation once this table is adopted by the output
+	output_shape_type shape;
+	int32_t amplitude_scale;
+	int32_t offset_scale;
+	float amplitude;                                        //after amplitude_frequency_compensation
+	float uncompensated_amplitude;                          //as requested, so a frequency change can regenerate the table
+	float offset;
+	float full_scale_divisor;
+}DAC_table_generation_type;
+
+//One AD5791 SPI frame, stored in wire order (MSB first) so the PDC can be pointed straight at it.
+//Packed at 3 bytes so the double buffered code table costs 2 x 4096 x 3 = 24KB of SRAM rather than 32KB.
+typedef struct
+{
+	uint8_t bytes[AD5791_FRAME_BYTES];
+}AD5791_frame_type;
+
+//A slew limited or dithered DC level. Levels are DAC codes, two's complement, with DC_RAMP_FRACTION_BITS below the LSB
+//so slow ramps can move less than a code per sample, and dithered levels can sit between codes.
+typedef struct
+{
+	volatile bool is_active;                                //OUTPUT_UPDATE_TIMER_ISR steps the ramp, or dithers the level, instead of playing the table
+	volatile bool is_complete_report_pending;
+	volatile bool is_dither_enabled;                        //keep the timer running at the target, noise shaping between the codes either side of it
+	int32_t dither_error[2];                                //quantization error of the last two samples, 0 to 1 LSB in DC_RAMP_FRACTION_BITS
+	bool is_waveform_running;                               //the sample timer is playing a table, so the DAC level isn't in present_code
+	float slew_rate;                                        //V/s or A/s, 0 = jump straight to the new level
+	volatile int32_t present_code;
+	int32_t target_code;
+	int32_t step;                                           //per sample, signed toward target_code
+	AD5791_frame_type frame[2];                             //ping-pong, the PDC may still be reading one while the ISR builds the other
+	uint32_t frame_index;
+}DC_ramp_type;
+
+//How late the sample ISR is getting to its frames. Latency is in sample timer counts from the RC compare that fired the ISR,
+//or when streaming, from the ENDTX that fired the SPI ISR.
+typedef struct
+{
+	volatile uint32_t late_samples;
+	volatile uint32_t overlapped_samples;
+	volatile uint32_t worst_latency_counts;
+	volatile uint32_t late_threshold_counts;                //latest entry count that still gets the frame shifted out before RA drops LDAC
+	uint32_t pending_late_threshold_counts;                 //adopted along with the pending sample rate
+#if DAC_BLOCK_STREAMING_ENABLED
+	uint32_t stream_frame_counts;                           //sample timer counts per streamed frame
+	volatile int32_t stream_frame_error_counts;             //streamed frame length less the sample timer period, 0 = in step with LDAC
+#endif
+	volatile bool is_notify_armed;                          //the next overrun raises a report, disarming as it does so only the first one is reported
+	volatile bool is_report_pending;
+	bool is_one_shot_write;                                 //execute_one_shot_DAC_write_sequence() is "calling" the ISR with the timer stopped
+}sample_overrun_type;
+
 struct output_data
 {
-	volatile union four_byte_pack DAC_code;
-	union four_byte_pack next_DAC_code;
+	const AD5791_frame_type *next_DAC_frame;
+	const AD5791_frame_type * volatile PDC_DAC_frame;         //the frame last handed to the PDC, which may still be shifting out
+	AD5791_frame_type one_shot_DAC_frame;
 	unsigned int phase_accumulator;
 	volatile unsigned int phase_increment;
-	uint32_t int_DAC_code_table[2][SINE_TABLE_SIZE];
+	volatile uint32_t phase_increment_remainder;              //the rest of the increment, in 1/phase_modulus counts, see rational_phase_increment_type
+	volatile uint32_t phase_modulus;
+	uint32_t phase_fraction;                                  //carries phase_increment_remainder into phase_accumulator, always < phase_modulus
+	rational_phase_increment_type requested_phase_increment;  //the last one asked for, whether the ISR has adopted it yet or not
+	uint32_t requested_sample_rate_shift;
+	unsigned int phase_offset;                                //in PERIOD_COUNTS, ahead of where the accumulator would otherwise be
+	bool is_phase_reset_on_frequency_change;                  //false = frequency changes carry on from the present phase
+	volatile uint32_t burst_samples_remaining;                //the phase accumulator only advances while this is non zero
+	volatile uint32_t burst_sample_decrement;                 //1 in burst mode, 0 for continuous output so burst_samples_remaining never runs out
+	unsigned int burst_start_phase;                           //in PERIOD_COUNTS. Bursts start here, and the output parks here between them.
+	uint32_t burst_cycles;
+	uint32_t burst_samples;                                   //samples in burst_cycles cycles at requested_phase_increment
+	uint32_t sync_out_mask;                                   //SYNC_OUT_BIT when sync out is on, 0 holds the line low
+	volatile uint32_t sample_rate_shift;                      //present sample rate = OUTPUT_SAMPLING_FREQUENCY >> sample_rate_shift
+	volatile bool is_sample_rate_change_pending;              //the ISR adopts the pending rate and increment together on its next pass
+	bool is_pending_phase_reset;                              //...and restarts from phase_offset as it does
+	uint32_t pending_sample_rate_shift;
+	rational_phase_increment_type pending_phase_increment;
+	uint32_t pending_sample_timer_RA;
+	uint32_t pending_sample_timer_RC;
+	uint32_t sample_timer_LDAC_low_counts;                    //RC - RA at OUTPUT_SAMPLING_FREQUENCY
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	volatile int32_t waveform_amplitude_scale;                //as returned by get_calibrated_DAC_code_scale. Written with the shape, interrupts masked.
+	volatile int32_t waveform_offset_scale;
+	volatile output_shape_type normalized_waveform_shape;     //shape the sample path looks up, straight from normalized_sine_table or ARB_table
+	AD5791_frame_type scaled_DAC_frame[2];                    //ping-pong, the PDC may still be reading one while the ISR builds the other
+	uint32_t scaled_DAC_frame_index;
+#else
+	AD5791_frame_type int_DAC_code_table[2][SINE_TABLE_SIZE];
+#endif
 	volatile uint32_t active_DAC_table_index;
+	volatile uint32_t swap_DAC_table_index;                   //equals active_DAC_table_index unless a phase synchronous swap is armed
+	volatile unsigned int DAC_table_swap_accumulator;         //phase accumulator value of the first sample at or past DAC_table_swap_phase
+	unsigned int DAC_table_swap_phase;                        //in PERIOD_COUNTS, 0 = swap as the accumulator wraps
+	volatile uint32_t live_DAC_table_generation;
+	volatile uint32_t swap_DAC_table_generation;              //equals live_DAC_table_generation unless a phase synchronous swap is armed
+	int32_t normalized_sine_table[SINE_QUARTER_TABLE_SIZE];  //Q31 copy of quarter_sine_table, so a table can be rescaled with integer math. On the fly scaling plays sine from it.
+	volatile uint32_t DAC_table_half_generation[2];           //fill each half of int_DAC_code_table holds, 0 while it's being filled. The ISR only adopts a half whose fill matches the armed one.
+	DAC_calibration_type DAC_calibration[NUMBER_OF_DAC_CALIBRATION_POINTS];   //built the first time each range is selected after a CalData change
+	uint32_t active_DAC_calibration_point;
+	int32_t DAC_INL_correction[NUMBER_OF_INL_CORRECTION_POINTS];     //DAC_CODE_SCALE_FRACTION_BITS, ready to subtract
+	bool is_DAC_INL_correction_active;                        //false = all zero, so the kernels skip it
+	output_shape_type waveform_shape;                         //shape the DDS tables are generated for. Only changes via set_output_shape().
+	float amplitude_frequency_compensation;                   //sine amplitudes are scaled by this to undo the zero-order hold and filter droop
+	float compensation_frequency;                             //output and sample rate the compensation was worked out for
+	float compensation_sampling_frequency;
+	int16_t ARB_tables[2][ARB_WAVEFORM_POINTS];               //user waveforms, Q15 normalized to +/-1. One is live, the other takes the next upload.
+	const int16_t *ARB_table;                                 //live waveform, the one DAC code tables are generated from
+	int16_t *ARB_upload_table;                                //chunks land here, swapped with ARB_table once the last one is in
+	DAC_table_generation_type DAC_table_generation;
+	DC_ramp_type DC_ramp;
+	sample_overrun_type sample_overrun;
+#if DDS_LINEAR_INTERPOLATION_ENABLED
+	AD5791_frame_type interpolated_DAC_frame[2];              //ping-pong, the PDC may still be reading one while the ISR builds the other
+	uint32_t interpolated_DAC_frame_index;
+#endif
+#if DAC_BLOCK_STREAMING_ENABLED
+	uint32_t DAC_stream_buffer[2][DAC_STREAM_BLOCK_SAMPLES * DAC_STREAM_WORDS_PER_FRAME];
+	uint32_t DAC_stream_block_to_refill;
+	uint32_t DAC_stream_cadence_blocks;                       //ENDTXs left to go in the start up cadence check, 0 = done
+	uint32_t DAC_stream_cadence_start_cycle;                  //core clock at the check's first ENDTX
+	uint32_t one_shot_stream_frame[DAC_STREAM_WORDS_PER_FRAME];
+#endif
 };
 
 struct output_data output;
 
+//A frequency sweep in progress. Stepped by the waveform control timer ISR, reported on from the main loop.
+struct frequency_sweep_data
+{
+	volatile bool is_running;
+	sweep_law_type law;
+	float start_phase_increment;
+	float stop_phase_increment;
+	rational_phase_increment_type exact_stop_phase_increment;  //the last step lands on exactly what a Frequency setting of stop_frequency would give
+	float log_ratio_per_step;                               //ln(stop/start)/steps, for the logarithmic law
+	uint32_t number_of_steps;
+	uint32_t ticks_per_step;                                //whole ticks in every step
+	uint32_t ticks_per_step_remainder;                      //number_of_ticks % number_of_steps, spread a tick at a time over the steps so the sweep lasts its full duration
+	uint32_t step_tick_fraction;                            //carries ticks_per_step_remainder, always < number_of_steps
+	uint32_t ticks_in_step;                                 //length of the present step, ticks_per_step or one more
+	uint32_t step;                                          //present step, 0 to number_of_steps
+	uint32_t tick_in_step;
+	uint32_t ticks_since_progress_report;
+	volatile bool is_progress_report_pending;
+	volatile bool is_completion_report_pending;
+};
+
+struct frequency_sweep_data frequency_sweep;
+
+//Sync in. Steered from SYNC_IN_CAPTURE_ISR on every reference edge.
+struct sync_in_data
+{
+	sync_in_mode_type mode;
+	unsigned int lock_phase;                                //DDS phase to hold at the reference edge, in PERIOD_COUNTS, before phase_offset
+	unsigned int nominal_phase_increment;                   //integer part of the requested increment, before trimming
+	float proportional_gain;                                //increment counts per count of phase error
+	float integral_gain;
+	float integral;                                         //increment counts
+	float integral_limit;
+	volatile int32_t phase_error;                           //at the last reference edge, in PERIOD_COUNTS
+	volatile uint32_t edges_in_lock_window;
+	bool was_locked;                                        //lock state last reported to the android
+};
+
+struct sync_in_data sync_in;
+
 output_stage_selection_type presently_selected_output_stage = OUTSTG_SEL_BOTH;
 
 void execute_one_shot_DAC_write_sequence(void);
+static void write_DC_DAC_code(int32_t DAC_code);
+static void start_DC_ramp(int32_t target_code, float codes_per_second);
+static int32_t get_DAC_code_scale(float level, float full_scale_divisor);
+static int32_t get_calibrated_DAC_code_scale(int32_t DAC_code_scale, bool is_offset);
+static inline int32_t get_INL_corrected_DAC_code_scale(int64_t DAC_code_scale);
+static inline int32_t get_INL_predistorted_DAC_code(int64_t DAC_code_scale);
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+static void compute_DAC_code_table(uint32_t pending_active_DAC_table_index, int32_t amplitude_scale, int32_t offset_scale, uint32_t first_quarter_point, uint32_t number_of_quarter_points);
+static void compute_DAC_code_table_from_waveform(uint32_t pending_active_DAC_table_index, output_shape_type shape, int32_t amplitude_scale, int32_t offset_scale, uint32_t first_point, uint32_t number_of_points);
+#endif
+static inline int32_t get_normalized_waveform_value(output_shape_type shape, uint32_t index);
+static void arm_DAC_table_swap(void);
+static unsigned int get_frequency_sweep_step_phase_increment(uint32_t step);
+static inline uint32_t get_frequency_sweep_step_ticks(void);
+static uint32_t get_sample_rate_shift(float frequency);
+static void request_output_phase_increment(rational_phase_increment_type phase_increment, uint32_t sample_rate_shift, bool reset_phase);
+static uint32_t get_burst_samples(rational_phase_increment_type phase_increment, uint32_t cycles);
+static void update_sync_in_loop_gains(void);
+static void swap_DAC_table_now(void);
+static void cancel_DAC_code_table_generation(void);
+static float get_amplitude_frequency_compensation(float frequency, float sampling_frequency);
+static void update_amplitude_frequency_compensation(float frequency, float sampling_frequency);
+static uint32_t get_sample_late_threshold_counts(uint32_t sample_timer_RA);
+
+#if DAC_BLOCK_STREAMING_ENABLED
+void fill_DAC_stream_block(uint32_t *stream_block);
+void start_DAC_block_streaming(void);
+void stop_DAC_block_streaming(void);
+#else
+static void start_sample_timer_playback(void);
+#endif
 
 #pragma endregion "defintions and variables restricted to the scope of this module"
 
@@ -38,387 +250,2558 @@ void execute_one_shot_DAC_write_sequence(void);
 
 void initialize_output_control_parameters(void)
 {
+	uint32_t i;
+	
+	output.next_DAC_frame = &output.one_shot_DAC_frame;
+	output.PDC_DAC_frame = &output.one_shot_DAC_frame;
 	output.active_DAC_table_index = 0;
+	output.swap_DAC_table_index = 0;
+	output.DAC_table_swap_accumulator = 0;
+	output.DAC_table_swap_phase = 0;
+	output.live_DAC_table_generation = 0;
+	output.swap_DAC_table_generation = 0;
+	output.DAC_table_generation.generation_number = 0;
 	output.phase_accumulator = 0;
 	output.phase_increment = 0;
+	output.phase_increment_remainder = 0;
+	output.phase_modulus = 1;
+	output.phase_fraction = 0;
+	output.requested_phase_increment.integer = 0;
+	output.requested_phase_increment.remainder = 0;
+	output.requested_phase_increment.modulus = 1;
+	output.requested_sample_rate_shift = 0;
+	output.phase_offset = 0;
+	output.is_phase_reset_on_frequency_change = false;
+	output.burst_samples_remaining = 1;                     //continuous output
+	output.burst_sample_decrement = 0;
+	output.burst_start_phase = 0;
+	output.burst_cycles = 1;
+	output.burst_samples = 0;
+	output.sync_out_mask = 0;
+	sync_in.mode = SYNC_IN_OFF;
+	sync_in.lock_phase = 0;
+	sync_in.integral = 0;
+	sync_in.phase_error = 0;
+	sync_in.edges_in_lock_window = 0;
+	sync_in.was_locked = false;
+	update_sync_in_loop_gains();
+	output.sample_rate_shift = 0;                           //init_timers() starts the sample timer at OUTPUT_SAMPLING_FREQUENCY
+	output.is_sample_rate_change_pending = false;
+	output.is_pending_phase_reset = false;
+	output.sample_timer_LDAC_low_counts = GET_SAMPLE_TIMER_PERIOD_COUNTS(OUTPUT_SAMPLING_FREQUENCY) - (uint32_t)(OUTPUT_SAMPLING_LDAC_DUTY * GET_SAMPLE_TIMER_PERIOD_COUNTS(OUTPUT_SAMPLING_FREQUENCY));
+	output.DAC_table_half_generation[0] = 0;                 //matches live_DAC_table_generation, both halves are the (empty) table everything starts on
+	output.DAC_table_half_generation[1] = 0;
+	output.DAC_table_generation.uncompensated_amplitude = 0;
+	output.compensation_frequency = 0;
+	output.compensation_sampling_frequency = OUTPUT_SAMPLING_FREQUENCY;
+	invalidate_DAC_calibration();                           //also works out amplitude_frequency_compensation
+	output.DAC_calibration[0].is_valid = true;              //uncalibrated until a range is selected
+	output.DAC_calibration[0].full_scale_divisor = 0;
+	output.DAC_calibration[0].gain_scale = 1 << DAC_CALIBRATION_GAIN_FRACTION_BITS;
+	output.DAC_calibration[0].bias_scale = 0;
+	output.active_DAC_calibration_point = 0;
+	output.waveform_shape = SHAPE_SINE;
+	output.DC_ramp.is_active = false;
+	output.DC_ramp.is_complete_report_pending = false;
+	output.DC_ramp.is_dither_enabled = false;
+	output.DC_ramp.dither_error[0] = 0;
+	output.DC_ramp.dither_error[1] = 0;
+	output.DC_ramp.is_waveform_running = false;
+	output.DC_ramp.slew_rate = 0;
+	output.DC_ramp.present_code = 0;
+	output.DC_ramp.target_code = 0;
+	output.DC_ramp.step = 0;
+	output.DC_ramp.frame_index = 0;
+	output.sample_overrun.late_samples = 0;
+	output.sample_overrun.overlapped_samples = 0;
+	output.sample_overrun.worst_latency_counts = 0;
+#if DAC_BLOCK_STREAMING_ENABLED
+	output.sample_overrun.stream_frame_counts = GET_SAMPLE_TIMER_PERIOD_COUNTS(OUTPUT_SAMPLING_FREQUENCY);
+	output.sample_overrun.stream_frame_error_counts = (int32_t)(get_DAC_SPI_frame_period_clocks(OUTPUT_SAMPLING_FREQUENCY) - output.sample_overrun.stream_frame_counts);   //what the padding should give, until a stream is timed
+	output.DAC_stream_cadence_blocks = 0;
+	output.sample_overrun.late_threshold_counts = DAC_STREAM_BLOCK_SAMPLES * output.sample_overrun.stream_frame_counts;   //only an empty buffer is late
+#else
+	output.sample_overrun.late_threshold_counts = get_sample_late_threshold_counts(GET_SAMPLE_TIMER_PERIOD_COUNTS(OUTPUT_SAMPLING_FREQUENCY) - output.sample_timer_LDAC_low_counts);
+#endif
+	output.sample_overrun.pending_late_threshold_counts = output.sample_overrun.late_threshold_counts;
+	output.sample_overrun.is_notify_armed = false;
+#if DAC_BLOCK_STREAMING_ENABLED
+	output.sample_overrun.is_report_pending = (output.sample_overrun.stream_frame_error_counts != 0);   //DLYBCS can't pad the frames out to the sample period
+#else
+	output.sample_overrun.is_report_pending = false;
+#endif
+	output.sample_overrun.is_one_shot_write = false;
+	frequency_sweep.is_running = false;
+	frequency_sweep.is_progress_report_pending = false;
+	frequency_sweep.is_completion_report_pending = false;
+	frequency_sweep.number_of_steps = 1;                    //progress reads 0 until a sweep has been run
+	memset(output.ARB_tables, 0, sizeof(output.ARB_tables));
+	output.ARB_table = output.ARB_tables[0];
+	output.ARB_upload_table = output.ARB_tables[1];
+	output.DAC_table_generation.state = DAC_TABLE_GENERATION_IDLE;
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	output.waveform_amplitude_scale = 0;
+	output.waveform_offset_scale = 0;
+	output.normalized_waveform_shape = SHAPE_SINE;
+	output.scaled_DAC_frame_index = 0;
+#endif
+	
+	for(i = 0; i < SINE_QUARTER_TABLE_SIZE; i++)
+	{
+		if(quarter_sine_table[i] >= 1.0f)
+		{
+			output.normalized_sine_table[i] = INT32_MAX;                                 //the table is printed to 6 places, so its peak rounds up to exactly 1.0
+		}
+		else
+		{
+			output.normalized_sine_table[i] = (int32_t)(quarter_sine_table[i] * 2147483648.0f);
+		}
+	}
 }
 #pragma endregion "general output control functions"
 
 #pragma region "AD5791 DAC Manipulation Functions"
 
 /**
- * @brief Output Waveform ISR
+ * @brief Splits an AD5791 24-bit command/code word into a frame in SPI wire order
  * 
- * This Timer ISR is the heart of the waveform generation capabilities. It's executed at a rate as
- * defined by OUTPUT_SAMPLING_FREQUENCY. It is dependent on the int_DAC_code_table being populated
- * with integer DAC code values, already scaled and formatted properly with calibration values included.
- * 
- * THIS ISR IS EXTREMELY TIMING CRITICAL. INCLUDING BOTH CONTEXT SWITCHES, IT TAKES APPROXIMATELY
- * 670nS TO EXECUTE. AT A 600kHz SAMPLING RATE, IT EXECUTES EVERY 1.66uS, RESULTING IN A CPU UTILIZAITON
- * OF APPROX. 40%. ANY MODIFICATIONS TO THIS ROUTINE MUST BE ACCOMPANIED WITH VERIFICATION TO ENSURE
- * THE ISR WILL EXECUTE IN ENOUGH TIME AND STILL MEET OVERALL TIMING REQUIREMENTS.
- * 
- * @param none
+ * @param DAC_frame destination frame
+ * @param DAC_code command and data as produced by COMPUTE_AD5791_CODE
  * 
  * @return void
  */
+static inline void pack_AD5791_frame(AD5791_frame_type *DAC_frame, uint32_t DAC_code)
+{
+	DAC_frame->bytes[0] = (uint8_t)(DAC_code >> 16);
+	DAC_frame->bytes[1] = (uint8_t)(DAC_code >> 8);
+	DAC_frame->bytes[2] = (uint8_t)DAC_code;
+}
 
-__attribute__ ((section(".ramfunc")))
-void OUTPUT_UPDATE_TIMER_ISR()
+/**
+ * @brief Recovers the signed 20-bit DAC data from a frame, dropping the write command bits
+ * 
+ * @param DAC_frame frame in wire order
+ * 
+ * @return int32_t DAC code, two's complement
+ */
+static inline int32_t unpack_AD5791_frame(const AD5791_frame_type *DAC_frame)
 {
-	//Move data down pipeline (reverse the endianness here)
-	output.DAC_code.bytes[0] = output.next_DAC_code.bytes[2];
-	output.DAC_code.bytes[1] = output.next_DAC_code.bytes[1];
-	output.DAC_code.bytes[2] = output.next_DAC_code.bytes[0];
-	
-	// Initiate PDC transfer
-	SET_SPI_PDC_TX_POINTER(&output.DAC_code.bytes[0]);
-	SET_SPI_PDC_TX_COUNT(3);
+	uint32_t DAC_code = ((uint32_t)DAC_frame->bytes[0] << 16) | ((uint32_t)DAC_frame->bytes[1] << 8) | DAC_frame->bytes[2];
 	
-	//Clear ISR flag
-	CLEAR_OUTPUT_UPDATE_TIMER_FLAG();
+	return ((int32_t)(DAC_code << 12) >> 12);                                 //sign extend bit 19
+}
+
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+/**
+ * @brief Builds one sample's frame straight from the normalized waveform (see get_normalized_waveform_value()). The amplitude and offset go on here rather than
+ * into a table: code = (offset_scale << 31 + amplitude_scale * waveform_Q31) >> 42, rounded and saturated exactly as the table
+ * kernels do it, which is one SMLAL and an SSAT. With DDS_LINEAR_INTERPOLATION_ENABLED the normalized points either side are blended first.
+ * 
+ * @param DAC_frame destination frame
+ * @param shape normalized_waveform_shape, read by the caller with the scales
+ * @param amplitude_scale waveform_amplitude_scale, read by the caller along with offset_scale so the two always match
+ * @param offset_scale waveform_offset_scale
+ * @param phase_accumulator current phase
+ * 
+ * @return void
+ */
+static inline void scale_DAC_frame(AD5791_frame_type *DAC_frame, output_shape_type shape, int32_t amplitude_scale, int32_t offset_scale, unsigned int phase_accumulator)
+{
+	uint32_t index = TABLE_INDEX(phase_accumulator);
+	int32_t value = get_normalized_waveform_value(shape, index);
+	int64_t level;
 	
-	// Compute new value
-	output.next_DAC_code.packed = output.int_DAC_code_table[output.active_DAC_table_index][TABLE_INDEX(output.phase_accumulator)];
+#if DDS_LINEAR_INTERPOLATION_ENABLED
+	int32_t next_value = get_normalized_waveform_value(shape, (index + 1) & (SINE_TABLE_SIZE - 1));
+	value += (int32_t)((((int64_t)next_value - value) * (int32_t)TABLE_FRACTION_Q15(phase_accumulator)) >> 15);     //64-bit difference, a square's edge spans the whole Q31 range
+#endif
 	
-	// Update phase accumulator
-	output.phase_accumulator += output.phase_increment;
+	level = ((int64_t)offset_scale << 31) + ((int64_t)1 << (30 + DAC_CODE_SCALE_FRACTION_BITS)) + ((int64_t)amplitude_scale * value);
+	pack_AD5791_frame(DAC_frame, AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & __SSAT((int32_t)(level >> (31 + DAC_CODE_SCALE_FRACTION_BITS)), AD5791_DAC_DATA_BITS)));
 }
-
-void init_AD5791_DAC(void)
+#elif DDS_LINEAR_INTERPOLATION_ENABLED
+/**
+ * @brief Linearly interpolates between the table point at TABLE_INDEX and the one after it, using the
+ * fractional accumulator bits. The blend is a single SMLAWB: code = this + (delta * fraction) >> 15.
+ * Codes are two's complement, so wrapping from the last table point back to the first needs no special case.
+ * 
+ * @param DAC_frame destination frame
+ * @param DAC_code_table active half of int_DAC_code_table
+ * @param phase_accumulator current phase
+ * 
+ * @return void
+ */
+static inline void interpolate_DAC_frame(AD5791_frame_type *DAC_frame, const AD5791_frame_type *DAC_code_table, unsigned int phase_accumulator)
 {
-	output.next_DAC_code.packed = AD5791_DAC_INIT_COMMAND;
-	execute_one_shot_DAC_write_sequence();
+	uint32_t index = TABLE_INDEX(phase_accumulator);
+	int32_t this_code = unpack_AD5791_frame(&DAC_code_table[index]);
+	int32_t next_code = unpack_AD5791_frame(&DAC_code_table[(index + 1) & (SINE_TABLE_SIZE - 1)]);
+	int32_t DAC_code = SMLAWB((next_code - this_code) << 1, TABLE_FRACTION_Q15(phase_accumulator), this_code);     //<< 1 makes the Q15 fraction a full Q16 weight
+	
+	pack_AD5791_frame(DAC_frame, AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & DAC_code));
 }
+#endif
 
-void generate_DAC_code_table(float amplitude, float offset, float full_scale_divisor)
+#if SAMPLE_OVERRUN_DETECTION_ENABLED
+/**
+ * @brief Books how late an ISR got to its frame, counting it as an overrun if it's past the threshold or the previous
+ * frame is still waiting on the PDC
+ * 
+ * @param latency_counts sample timer counts since the event that fired the ISR
+ * @param is_overlapped the PDC hasn't finished with what it was last given
+ * 
+ * @return void
+ */
+static inline void check_sample_overrun(uint32_t latency_counts, bool is_overlapped)
 {
-	uint32_t i;
-	uint32_t pending_active_DAC_table_index;
-	
-	if(output.active_DAC_table_index == 1)
+	if(latency_counts > output.sample_overrun.worst_latency_counts)
 	{
-		pending_active_DAC_table_index = 0;
+		output.sample_overrun.worst_latency_counts = latency_counts;
 	}
-	else
+	
+	if(is_overlapped || (latency_counts > output.sample_overrun.late_threshold_counts))
 	{
-		pending_active_DAC_table_index = 1;
+		if(is_overlapped)
+		{
+			output.sample_overrun.overlapped_samples++;
+		}
+		else
+		{
+			output.sample_overrun.late_samples++;
+		}
+		
+		if(output.sample_overrun.is_notify_armed)
+		{
+			output.sample_overrun.is_notify_armed = false;
+			output.sample_overrun.is_report_pending = true;
+		}
 	}
+}
+#endif
+
+/**
+ * @brief Picks the DAC code for a level between codes with a second order error feedback modulator.
+ * The quantization error is shaped by (1 - z^-1)^2, pushing it up toward the sample rate where the output filter takes it out,
+ * so the filtered output averages to the level to within 1/2^DC_RAMP_FRACTION_BITS of an LSB.
+ * 
+ * @param level DAC code with DC_RAMP_FRACTION_BITS below the LSB
+ * 
+ * @return int32_t DAC code, two's complement
+ */
+static inline int32_t get_dithered_DC_code(int32_t level)
+{
+	int32_t shaped_level = level + (2 * output.DC_ramp.dither_error[0]) - output.DC_ramp.dither_error[1];
+	int32_t DAC_code = shaped_level >> DC_RAMP_FRACTION_BITS;                                  //floor, so the error is always 0 to 1 LSB
+	
+	output.DC_ramp.dither_error[1] = output.DC_ramp.dither_error[0];
+	output.DC_ramp.dither_error[0] = shaped_level & ((1 << DC_RAMP_FRACTION_BITS) - 1);
 	
-	for(i = 0; i < SINE_TABLE_SIZE; i++)
+	if(DAC_code > 0x7FFFF)                                  //within an LSB of full scale, the shaping can ask for a code past the end
 	{
-		output.int_DAC_code_table[pending_active_DAC_table_index][i] = COMPUTE_AD5791_CODE((amplitude * sine_table[i]  + offset), full_scale_divisor);       //TODO: add in cal factors from calibration.h
+		DAC_code = 0x7FFFF;
+	}
+	else if(DAC_code < -0x80000)
+	{
+		DAC_code = -0x80000;
 	}
 	
-	output.active_DAC_table_index = pending_active_DAC_table_index;                 //Throw the switch!
+	return(DAC_code);
 }
 
-void bring_DAC_output_to_zero(output_shape_type output_shape)
+/**
+ * @brief Takes a DC ramp one sample closer to its target, or dithers the level once it's there. The frame built here goes out
+ * at the top of the next pass. Without dithering, once the exact target frame has gone out, the timer is left to finish
+ * that LDAC pulse and stop, as it does for a one shot write.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+static inline void step_DC_ramp(void)
 {
-	if(output_shape == SHAPE_DC)
+	int32_t remaining;
+	int32_t DAC_code;
+	
+	if(output.DC_ramp.present_code == output.DC_ramp.target_code)
+	{
+		if(output.DC_ramp.step != 0)
+		{
+			output.DC_ramp.step = 0;                                    //arrived, this pass builds the target frame
+			output.DC_ramp.is_complete_report_pending = true;
+		}
+		else if(!output.DC_ramp.is_dither_enabled)
+		{
+			ENABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();
+			DISABLE_TIMER_INTERRUPT();
+			output.DC_ramp.is_active = false;
+			return;
+		}
+	}
+	else
 	{
-		update_DAC_output_while_in_DC_mode(0,1);        //full scale divisor is a don't care when going to zero.
+		remaining = output.DC_ramp.target_code - output.DC_ramp.present_code;
+		if((output.DC_ramp.step > 0) ? (remaining <= output.DC_ramp.step) : (remaining >= output.DC_ramp.step))
+		{
+			output.DC_ramp.present_code = output.DC_ramp.target_code;
+		}
+		else
+		{
+			output.DC_ramp.present_code += output.DC_ramp.step;
+		}
 	}
-	else if(output_shape == SHAPE_SINE)
+	
+	if(output.DC_ramp.is_dither_enabled)
 	{
-		generate_DAC_code_table(0,0,1);
+		DAC_code = get_dithered_DC_code(output.DC_ramp.present_code);
 	}
-
+	else
+	{
+		DAC_code = output.DC_ramp.present_code >> DC_RAMP_FRACTION_BITS;
+	}
+	
+	output.DC_ramp.frame_index ^= 1;
+	pack_AD5791_frame(&output.DC_ramp.frame[output.DC_ramp.frame_index], AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & DAC_code));
+	output.next_DAC_frame = &output.DC_ramp.frame[output.DC_ramp.frame_index];
 }
 
-void update_DAC_output_while_in_DC_mode(float desired_output_amplitude, float full_scale_divisor)
+/**
+ * @brief Takes up the table half armed by arm_DAC_table_swap(), as long as the half still holds the fill that was armed.
+ * A half being refilled has its generation number cleared first, so a swap left armed behind the refill can't land on it.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+static inline void adopt_armed_DAC_table(void)
 {
-	generate_DAC_code_table(0, desired_output_amplitude, full_scale_divisor);						//under the hood, in DC mode, desired user amplitude setting is generated by passing it in as "offset" parameter.
-	output.next_DAC_code.packed = output.int_DAC_code_table[output.active_DAC_table_index][0];      //just grab the 1st value for DC mode since they're all the same
-	execute_one_shot_DAC_write_sequence();
+	if(output.swap_DAC_table_generation == output.DAC_table_half_generation[output.swap_DAC_table_index])
+	{
+		output.active_DAC_table_index = output.swap_DAC_table_index;
+		output.live_DAC_table_generation = output.swap_DAC_table_generation;
+	}
 }
 
 /**
- * \brief called when only one value needs to be written to AD5791 DAC
+ * @brief Output Waveform ISR
  * 
- * See comments in implementation for further details of how this works.
+ * This Timer ISR is the heart of the waveform generation capabilities. It's executed at a rate as
+ * defined by OUTPUT_SAMPLING_FREQUENCY. It is dependent on the int_DAC_code_table being populated
+ * with AD5791 frames, already scaled, calibrated and stored in SPI wire order.
  * 
- * \param 
+ * THIS ISR IS EXTREMELY TIMING CRITICAL. INCLUDING BOTH CONTEXT SWITCHES, IT TAKES APPROXIMATELY
+ * 670nS TO EXECUTE. AT A 600kHz SAMPLING RATE, IT EXECUTES EVERY 1.66uS, RESULTING IN A CPU UTILIZAITON
+ * OF APPROX. 40%. ANY MODIFICATIONS TO THIS ROUTINE MUST BE ACCOMPANIED WITH VERIFICATION TO ENSURE
+ * THE ISR WILL EXECUTE IN ENOUGH TIME AND STILL MEET OVERALL TIMING REQUIREMENTS.
+ * With PROFILER_ENABLED, the SampleIsr probe measures the body in core clocks (the context switches aren't included). Only the
+ * interrupt's own passes are recorded: the passes execute_one_shot_DAC_write_sequence() and start_sample_timer_playback() make
+ * from thread level could be torn by the interrupt mid record.
  * 
- * \return void
+ * With SAMPLE_OVERRUN_DETECTION_ENABLED, the sample timer count on entry says how long after the RC compare the ISR got going.
+ * Past RA less a frame's SPI time, the frame can't make LDAC and the DAC repeats a sample (late). If the PDC still hasn't
+ * taken the previous frame, the last pass was itself held off (overlapped). An ISR held off for a whole period or more finds
+ * the counter wrapped, and the missed compare merged into the one it's serving, so that isn't caught.
+ * 
+ * Below OUTPUT_SAMPLING_FREQUENCY / OUTPUT_MINIMUM_SAMPLES_PER_CYCLE the ISR can run at a power of 2 fraction of 600kHz,
+ * down to 18.75kHz (~1.3% CPU), as far as its images allow, see get_sample_rate_shift().
+ * 
+ * With DDS_ON_THE_FLY_SCALING_ENABLED, the frame is built here from the normalized waveform instead (see scale_DAC_frame()),
+ * which adds the shape lookup, a multiply-accumulate, a saturate and the frame packing to every sample. Re-verify the timing when enabling it.
+ * 
+ * @param none
+ * 
+ * @return void
  */
-void execute_one_shot_DAC_write_sequence(void)
-{
-	OUTPUT_UPDATE_TIMER_ISR();									//"call" ISR in order to take new DC value and kick of SPI Tx so it gets shifted into DAC.
-	while(!IS_SPI_PDC_TXBUFFER_EMPTY());						//wait for PDC to push data out before we kick off timer, which in turn will then fire off LDAC toggle
-	ENABLE_TIMER_CLOCK();										//Enables timer clock but doesn't actually start counting up yet.
-	ENABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();					//This ensures the LDAC line will only load once. Once RC is hit, the timer peripheral will disable its own clock
-	ISSUE_TIMER_SW_TRIGGER();									//This causes the timer counter to reset and start the count up to the LDAC toggle (low when RA is hit, back high when RC is hit)
-}
 
-#pragma endregion "AD5791 DAC Manipulation Functions"
-
-#pragma region "Output Stage Hardware Manipulation Functions"
-
-void configure_DAC_input_to_desired_output_stage(output_mode_type output_mode, output_stage_selection_type desired_output_stage)
+__attribute__ ((section(".ramfunc")))
+void OUTPUT_UPDATE_TIMER_ISR()
 {
-	uint32_t IO_line_state;
-	uint32_t IO_line_mask = (LV_DAC_IN_MASK | HV_DAC_IN_MASK | LV_OUTMODE_SEL_MASK | HV_OUTMODE_SEL_MASK);     //we're always manipulating the respective DAC input and OUTMODEL SEL masks in this function
+	PROFILE_BEGIN(PROFILE_PROBE_SAMPLE_ISR);
 	
-	if(desired_output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+#if SAMPLE_OVERRUN_DETECTION_ENABLED
+	// Check this pass is in time before handing the PDC its frame. The counter restarted at the RC compare that fired it.
+	if(!output.sample_overrun.is_one_shot_write)
 	{
-		IO_line_state = LV_DAC_IN_ENABLE | HV_DAC_IN_DISABLE | HV_OUTMODE_SEL_VOLTAGE;      //despite being disabled and a don't care, force HV outmode to known "voltage" state. Helps with system testing.
+		check_sample_overrun(READ_SAMPLE_TIMER_COUNT(), !IS_SPI_PDC_TXBUFFER_EMPTY());
+	}
+#endif
+	
+	// Initiate PDC transfer. Table entries are already in wire order, so the PDC reads the frame straight out of the table.
+	SET_SPI_PDC_TX_POINTER(output.next_DAC_frame);
+	SET_SPI_PDC_TX_COUNT(AD5791_FRAME_BYTES);
+	output.PDC_DAC_frame = output.next_DAC_frame;
+	
+	//Clear ISR flag
+	CLEAR_OUTPUT_UPDATE_TIMER_FLAG();
+	
+	// DC ramps borrow the sample timer, stepping the level instead of playing the table
+	if(output.DC_ramp.is_active)
+	{
+		step_DC_ramp();
+		PROFILE_END_IF(PROFILE_PROBE_SAMPLE_ISR, !output.sample_overrun.is_one_shot_write);
+		return;
+	}
+	
+	// Adopt a pending table once the output reaches the swap phase. When nothing is armed, the swap index is the active one, so a stray match does no harm.
+	if(output.phase_accumulator == output.DAC_table_swap_accumulator)
+	{
+		adopt_armed_DAC_table();
+	}
+	
+	// Retune the sample rate. The counter restarted at RC compare a moment ago, so it's still below the new RA and RC.
+	if(output.is_sample_rate_change_pending)
+	{
+		SET_SAMPLE_TIMER_COUNTS(output.pending_sample_timer_RA, output.pending_sample_timer_RC);
+		output.phase_increment = output.pending_phase_increment.integer;
+		output.phase_increment_remainder = output.pending_phase_increment.remainder;
+		output.phase_modulus = output.pending_phase_increment.modulus;
+		output.phase_fraction = 0;
+		output.sample_rate_shift = output.pending_sample_rate_shift;
+		output.sample_overrun.late_threshold_counts = output.sample_overrun.pending_late_threshold_counts;
+		output.is_sample_rate_change_pending = false;
 		
-		if(output_mode == VOLTAGE_MODE)
+		if(output.is_pending_phase_reset)
 		{
-			IO_line_state |= LV_OUTMODE_SEL_VOLTAGE;
+			output.phase_accumulator = output.phase_offset;
+			output.is_pending_phase_reset = false;
 		}
-		else if(output_mode == CURRENT_MODE)
+		
+		if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
 		{
-			IO_line_state |= LV_OUTMODE_SEL_CURRENT;
+			arm_DAC_table_swap();                                   //the armed accumulator value won't be hit at the new increment
 		}
-		
-		presently_selected_output_stage = OUTSTG_SEL_LOW_VOLTAGE;
 	}
-	else if(desired_output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+	
+	// Compute new value
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	output.scaled_DAC_frame_index ^= 1;
+	scale_DAC_frame(&output.scaled_DAC_frame[output.scaled_DAC_frame_index], output.normalized_waveform_shape, output.waveform_amplitude_scale, output.waveform_offset_scale, output.phase_accumulator);
+	output.next_DAC_frame = &output.scaled_DAC_frame[output.scaled_DAC_frame_index];
+#elif DDS_LINEAR_INTERPOLATION_ENABLED
+	output.interpolated_DAC_frame_index ^= 1;
+	interpolate_DAC_frame(&output.interpolated_DAC_frame[output.interpolated_DAC_frame_index], output.int_DAC_code_table[output.active_DAC_table_index], output.phase_accumulator);
+	output.next_DAC_frame = &output.interpolated_DAC_frame[output.interpolated_DAC_frame_index];
+#else
+	output.next_DAC_frame = &output.int_DAC_code_table[output.active_DAC_table_index][TABLE_INDEX(output.phase_accumulator)];
+#endif
+	
+	// Update phase accumulator. The fraction carries the part of the increment that isn't a whole count, so the frequency is exact over the long run.
+	// In burst mode the accumulator only moves while the burst has samples left. Continuous output never counts down.
+	if(output.burst_samples_remaining != 0)
 	{
-		IO_line_state = LV_DAC_IN_DISABLE | HV_DAC_IN_ENABLE | LV_OUTMODE_SEL_VOLTAGE;      //despite being disabled and a don't care, force LV outmode to known "voltage" state. Helps with system testing.
+		unsigned int previous_phase_accumulator = output.phase_accumulator;
 		
-		if(output_mode == VOLTAGE_MODE)
-		{
-			IO_line_state |= HV_OUTMODE_SEL_VOLTAGE;
-		}
-		else if(output_mode == CURRENT_MODE)
+		output.burst_samples_remaining -= output.burst_sample_decrement;
+		
+		output.phase_accumulator += output.phase_increment;
+		output.phase_fraction += output.phase_increment_remainder;
+		if(output.phase_fraction >= output.phase_modulus)
 		{
-			IO_line_state |= HV_OUTMODE_SEL_CURRENT;
+			output.phase_fraction -= output.phase_modulus;
+			output.phase_accumulator++;
 		}
 		
-		presently_selected_output_stage = OUTSTG_SEL_HIGH_VOLTAGE;
-	}
-	else                                                                                    //else, safely default to disabling inputs to both output stages
-	{
-		IO_line_state = (LV_DAC_IN_DISABLE | HV_DAC_IN_DISABLE | LV_OUTMODE_SEL_VOLTAGE | HV_OUTMODE_SEL_VOLTAGE);
+		// Sync out goes high for the sample the accumulator wraps on, i.e. when the bit above the period count toggles. Leads the output by one sample.
+		WRITE_SYNC_OUT_OUTPUT(((previous_phase_accumulator ^ output.phase_accumulator) >> ((SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS) - SYNC_OUT_BIT_SHIFT)) & output.sync_out_mask);
 		
-		presently_selected_output_stage = OUTSTG_SEL_BOTH;
+		if(output.burst_samples_remaining == 0)
+		{
+			// Burst done. Park on the start phase, and take any armed table now, as the phase won't be moving to reach it.
+			output.phase_accumulator = output.burst_start_phase;
+			output.phase_fraction = 0;
+			adopt_armed_DAC_table();
+			WRITE_SYNC_OUT_OUTPUT(0);
+		}
 	}
 	
-	set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
+	PROFILE_END_IF(PROFILE_PROBE_SAMPLE_ISR, !output.sample_overrun.is_one_shot_write);
 }
 
-output_stage_selection_type get_presently_selected_output_stage(void)
+#if DAC_BLOCK_STREAMING_ENABLED
+/**
+ * @brief Expands one AD5791 frame into the three PDC words of a streamed SPI frame
+ * 
+ * @param stream_frame destination for the DAC_STREAM_WORDS_PER_FRAME words
+ * @param DAC_frame frame in wire order
+ * 
+ * @return void
+ */
+static inline void format_DAC_stream_frame(uint32_t *stream_frame, const AD5791_frame_type *DAC_frame)
 {
-	return(presently_selected_output_stage);
+	stream_frame[0] = SPI_STREAM_WORD(DAC_frame->bytes[0]);
+	stream_frame[1] = SPI_STREAM_WORD(DAC_frame->bytes[1]);
+	stream_frame[2] = SPI_STREAM_LAST_WORD(DAC_frame->bytes[2]);              //LASTXFER raises SYNC so the AD5791 takes the frame
 }
 
-void set_low_voltage_voltage_range_HW(voltage_range_type range)
+/**
+ * @brief Refills one half of the DAC stream ping-pong buffer
+ * 
+ * Walks the phase accumulator forward DAC_STREAM_BLOCK_SAMPLES samples, exactly as OUTPUT_UPDATE_TIMER_ISR would
+ * one sample at a time, and formats each int_DAC_code_table entry into a ready-to-send SPI frame.
+ * 
+ * @param stream_block the half of DAC_stream_buffer to fill
+ * 
+ * @return void
+ */
+__attribute__ ((section(".ramfunc")))
+void fill_DAC_stream_block(uint32_t *stream_block)
 {
-	uint32_t LV_range_IO_line_state = 0;
+	uint32_t i;
+	unsigned int phase_accumulator = output.phase_accumulator;
+	unsigned int phase_increment = output.phase_increment;
+	uint32_t phase_fraction = output.phase_fraction;
+	uint32_t phase_increment_remainder = output.phase_increment_remainder;
+	uint32_t phase_modulus = output.phase_modulus;
+	uint32_t burst_samples_remaining = output.burst_samples_remaining;
+	uint32_t burst_sample_decrement = output.burst_sample_decrement;
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	output_shape_type shape = output.normalized_waveform_shape;             //once per block, so a level or shape change lands on a block boundary
+	int32_t amplitude_scale = output.waveform_amplitude_scale;
+	int32_t offset_scale = output.waveform_offset_scale;
+	AD5791_frame_type scaled_DAC_frame;
+#else
+	unsigned int DAC_table_swap_accumulator = output.DAC_table_swap_accumulator;
+	const AD5791_frame_type *DAC_code_table = output.int_DAC_code_table[output.active_DAC_table_index];
+#endif
+#if DDS_LINEAR_INTERPOLATION_ENABLED && !DDS_ON_THE_FLY_SCALING_ENABLED
+	AD5791_frame_type interpolated_DAC_frame;
+#endif
 	
-	switch(range)
+	for(i = 0; i < DAC_STREAM_BLOCK_SAMPLES; i++)
 	{
-		case VRANGE_100mV:
-			LV_range_IO_line_state = LV_VRNG_100MV;
-			break;
-		
-		case VRANGE_1V:
-			LV_range_IO_line_state = LV_VRNG_1V;
-			break;
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+		scale_DAC_frame(&scaled_DAC_frame, shape, amplitude_scale, offset_scale, phase_accumulator);
+		format_DAC_stream_frame(stream_block, &scaled_DAC_frame);
+#else
+		if(phase_accumulator == DAC_table_swap_accumulator)
+		{
+			adopt_armed_DAC_table();
+			DAC_code_table = output.int_DAC_code_table[output.active_DAC_table_index];
+		}
 		
-		case VRANGE_10V:
-			LV_range_IO_line_state = LV_VRNG_10V;
-			break;
+#if DDS_LINEAR_INTERPOLATION_ENABLED
+		interpolate_DAC_frame(&interpolated_DAC_frame, DAC_code_table, phase_accumulator);
+		format_DAC_stream_frame(stream_block, &interpolated_DAC_frame);
+#else
+		format_DAC_stream_frame(stream_block, &DAC_code_table[TABLE_INDEX(phase_accumulator)]);
+#endif
+#endif
+		stream_block += DAC_STREAM_WORDS_PER_FRAME;
 		
-		case VRANGE_10mV:
-		default:
-			LV_range_IO_line_state = LV_VRNG_10MV;
-			break;
+		if(burst_samples_remaining != 0)
+		{
+			burst_samples_remaining -= burst_sample_decrement;
+			
+			phase_accumulator += phase_increment;
+			phase_fraction += phase_increment_remainder;
+			if(phase_fraction >= phase_modulus)
+			{
+				phase_fraction -= phase_modulus;
+				phase_accumulator++;
+			}
+			
+			if(burst_samples_remaining == 0)
+			{
+				phase_accumulator = output.burst_start_phase;
+				phase_fraction = 0;
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+				adopt_armed_DAC_table();
+				DAC_code_table = output.int_DAC_code_table[output.active_DAC_table_index];
+#endif
+			}
+		}
 	}
 	
-	set_HW_configuration_lines(LV_IO_PORT, LV_VRNG_MASK, LV_range_IO_line_state);
+	output.phase_accumulator = phase_accumulator;
+	output.phase_fraction = phase_fraction;
+	output.burst_samples_remaining = burst_samples_remaining;
 }
 
-void set_low_voltage_current_range_HW(current_range_type range)
+/**
+ * @brief Times the first DAC_STREAM_CADENCE_CHECK_BLOCKS blocks of a stream, to check the frames really are one sample timer period
+ * long. Nothing but the DLYBCS padding holds them to LDAC, so frames off by even one clock drift through it, and every so often
+ * LDAC latches a frame mid shift. The ISR's entry latency varies, so the blocks are timed together and the error per frame
+ * rounded, which takes out anything up to half a frame's worth of cycles. A mismatch raises a SampleOverrunStatus report
+ * whether or not notifications are armed.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+static inline void check_DAC_stream_cadence(void)
+{
+	uint32_t cycle = READ_CYCLE_COUNT();
+	int32_t check_frames = DAC_STREAM_CADENCE_CHECK_BLOCKS * DAC_STREAM_BLOCK_SAMPLES;
+	int32_t error_cycles;
+	
+	output.DAC_stream_cadence_blocks--;
+	
+	if(output.DAC_stream_cadence_blocks == DAC_STREAM_CADENCE_CHECK_BLOCKS)
+	{
+		output.DAC_stream_cadence_start_cycle = cycle;
+	}
+	else if(output.DAC_stream_cadence_blocks == 0)
+	{
+		//The sample timer runs off MCK, the same clock as the cycle counter
+		error_cycles = (int32_t)((cycle - output.DAC_stream_cadence_start_cycle) - (check_frames * READ_SAMPLE_TIMER_PERIOD()));
+		output.sample_overrun.stream_frame_error_counts = (error_cycles + ((error_cycles < 0) ? -(check_frames / 2) : (check_frames / 2))) / check_frames;
+		
+		if(output.sample_overrun.stream_frame_error_counts != 0)
+		{
+			output.sample_overrun.is_report_pending = true;
+		}
+	}
+}
+
+/**
+ * @brief DAC stream end of transfer ISR
+ * 
+ * Fires once per DAC_STREAM_BLOCK_SAMPLES samples, when the PDC has finished one half of DAC_stream_buffer and 
+ * reloaded itself with the other half. The finished half is refilled and queued back up as the PDC "next" buffer.
+ * Writing the next counter clears the ENDTX flag.
+ * 
+ * The refill has one full block period (DAC_STREAM_BLOCK_SAMPLES / OUTPUT_SAMPLING_FREQUENCY) to complete before the PDC runs dry.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+__attribute__ ((section(".ramfunc")))
+void SPI_ISR()
+{
+	uint32_t *completed_block = output.DAC_stream_buffer[output.DAC_stream_block_to_refill];
+	PROFILE_BEGIN(PROFILE_PROBE_STREAM_BLOCK_ISR);
+	
+#if SAMPLE_OVERRUN_DETECTION_ENABLED
+	// ENDTX fired as the PDC moved on to the other half, so whatever it has sent of that half since is how late this refill is starting.
+	// If it has sent all of it, the output has already stopped.
+	check_sample_overrun(((DAC_STREAM_BLOCK_SAMPLES * DAC_STREAM_WORDS_PER_FRAME) - READ_SPI_PDC_TX_COUNT()) * output.sample_overrun.stream_frame_counts / DAC_STREAM_WORDS_PER_FRAME,
+	                     IS_SPI_PDC_TXBUFFER_EMPTY());
+#endif
+	
+	if(output.DAC_stream_cadence_blocks != 0)
+	{
+		check_DAC_stream_cadence();
+	}
+	
+	fill_DAC_stream_block(completed_block);
+	
+	SET_SPI_PDC_TX_NEXT_POINTER(completed_block);
+	SET_SPI_PDC_TX_NEXT_COUNT(DAC_STREAM_BLOCK_SAMPLES * DAC_STREAM_WORDS_PER_FRAME);
+	
+	output.DAC_stream_block_to_refill ^= 1;
+	
+	PROFILE_END(PROFILE_PROBE_STREAM_BLOCK_ISR);
+}
+
+/**
+ * @brief primes both halves of the stream buffer and starts the PDC and the LDAC timer back to back
+ * 
+ * The PDC is primed first, so the first frame is already shifting when the timer starts, and is complete well ahead of the
+ * first LDAC at RA. Started the other way round, the first LDAC could latch whatever the DAC last held. From there on,
+ * SPI frame timing is padded out to exactly one sample period (see init_SPI()) so the two stay locked, which the first
+ * blocks are timed to confirm (see check_DAC_stream_cadence()).
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+void start_DAC_block_streaming(void)
+{
+	fill_DAC_stream_block(output.DAC_stream_buffer[0]);
+	fill_DAC_stream_block(output.DAC_stream_buffer[1]);
+	output.DAC_stream_block_to_refill = 0;
+	output.DAC_stream_cadence_blocks = DAC_STREAM_CADENCE_CHECK_BLOCKS + 1;          //the first ENDTX starts the clock
+	
+	MASK_ALL_INTERRUPTS();                                                           //nothing may come between the first frame and the timer start
+	SET_SPI_PDC_TX_POINTER(output.DAC_stream_buffer[0]);                             //current buffer must be loaded before next, otherwise the PDC reloads next immediately
+	SET_SPI_PDC_TX_COUNT(DAC_STREAM_BLOCK_SAMPLES * DAC_STREAM_WORDS_PER_FRAME);
+	SET_SPI_PDC_TX_NEXT_POINTER(output.DAC_stream_buffer[1]);
+	SET_SPI_PDC_TX_NEXT_COUNT(DAC_STREAM_BLOCK_SAMPLES * DAC_STREAM_WORDS_PER_FRAME);
+	
+	DISABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();
+	ENABLE_TIMER_CLOCK();
+	ISSUE_TIMER_SW_TRIGGER();
+	
+	ENABLE_SPI_END_OF_TX_INTERRUPT();
+	UNMASK_INTERRUPTS();
+}
+
+/**
+ * @brief stops queuing blocks and waits for the PDC to drain
+ * 
+ * The block in flight is allowed to finish so a frame is never cut off with SYNC held low.
+ * Worst case this blocks for one block period.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+void stop_DAC_block_streaming(void)
+{
+	DISABLE_SPI_END_OF_TX_INTERRUPT();
+	SET_SPI_PDC_TX_NEXT_COUNT(0);
+	while(!IS_SPI_PDC_TXBUFFER_EMPTY());
+	DISABLE_TIMER_CLOCK();
+}
+#endif
+
+void init_AD5791_DAC(void)
+{
+	pack_AD5791_frame(&output.one_shot_DAC_frame, AD5791_DAC_INIT_COMMAND);
+	execute_one_shot_DAC_write_sequence();
+}
+
+void generate_DAC_code_table(float amplitude, float offset, float full_scale_divisor)
+{
+	PROFILE_BEGIN(PROFILE_PROBE_DAC_TABLE_GENERATION);
+	
+	//A time sliced fill still in flight is superseded, not left to finish behind this one. This table is built from the latest
+	//levels, so a level notification that was waiting on that fill goes out once this one is live instead.
+	cancel_DAC_code_table_generation();
+	request_DAC_code_table_generation(amplitude, offset, full_scale_divisor);
+	
+	while(output.DAC_table_generation.state == DAC_TABLE_GENERATION_COMPUTE)
+	{
+		service_DAC_code_table_generation();
+	}
+	
+	swap_DAC_table_now();                       //callers are about to start, stop or re-range the output, so there's no point waiting for the swap phase
+	service_DAC_code_table_generation();
+	
+	PROFILE_END(PROFILE_PROBE_DAC_TABLE_GENERATION);
+}
+
+uint32_t request_DAC_code_table_generation(float amplitude, float offset, float full_scale_divisor)
+{
+	DAC_table_generation_type *generation = &output.DAC_table_generation;
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	int32_t amplitude_scale;
+	int32_t offset_scale;
+#endif
+	
+	generation->uncompensated_amplitude = amplitude;
+	if(output.waveform_shape == SHAPE_SINE)
+	{
+		amplitude *= output.amplitude_frequency_compensation;   //the other shapes' harmonics droop by different amounts, so no one gain flattens them
+	}
+	
+#if DDS_ON_THE_FLY_SCALING_ENABLED
+	//No table to fill. The sample path scales the normalized waveform itself, so the new levels go out on the next sample.
+	amplitude_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(amplitude, full_scale_divisor), false);
+	offset_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(offset, full_scale_divisor), true);
+	
+	MASK_ALL_INTERRUPTS();
+	output.normalized_waveform_shape = output.waveform_shape;
+	output.waveform_amplitude_scale = amplitude_scale;
+	output.waveform_offset_scale = offset_scale;
+	generation->state = DAC_TABLE_GENERATION_IDLE;
+	generation->pending_active_DAC_table_index = output.active_DAC_table_index;
+	generation->generation_number++;
+	output.live_DAC_table_generation = generation->generation_number;
+	output.swap_DAC_table_generation = generation->generation_number;
+	UNMASK_INTERRUPTS();
+#else
+	//Any fill already in progress is cancelled. It was writing the inactive half, so nothing the ISR reads is disturbed.
+	cancel_DAC_code_table_generation();
+	generation->pending_active_DAC_table_index = output.active_DAC_table_index ^ 1;     //nothing is armed now, so the active half stays put
+	
+#if !DAC_BLOCK_STREAMING_ENABLED && !DDS_LINEAR_INTERPOLATION_ENABLED
+	//The PDC reads frames straight out of the active half. Had the swap away from the half about to be written happened on the
+	//last sample, the frame sent on that sample can still be shifting out of it, for less than a frame time.
+	while((output.PDC_DAC_frame >= output.int_DAC_code_table[generation->pending_active_DAC_table_index]) &&
+	      (output.PDC_DAC_frame < (output.int_DAC_code_table[generation->pending_active_DAC_table_index] + SINE_TABLE_SIZE)) && !IS_SPI_TX_COMPLETE());
+#endif
+	
+	generation->generation_number++;
+	
+	//Offset only changes are computed in full too. Adding a code delta to the active table's codes would round twice, and a
+	//code clipped at the rail would stay clipped, so the error would build up change after change. The kernel is integer already.
+	generation->amplitude_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(amplitude, full_scale_divisor), false);
+	generation->offset_scale = get_calibrated_DAC_code_scale(get_DAC_code_scale(offset, full_scale_divisor), true);
+	generation->state = DAC_TABLE_GENERATION_COMPUTE;
+#endif
+	
+	generation->next_point = 0;
+	generation->shape = output.waveform_shape;
+	generation->amplitude = amplitude;
+	generation->offset = offset;
+	generation->full_scale_divisor = full_scale_divisor;
+	
+	return(generation->generation_number);
+}
+
+void service_DAC_code_table_generation(void)
+{
+	DAC_table_generation_type *generation = &output.DAC_table_generation;
+	bool is_fill_complete = false;
+	
+#if !DDS_ON_THE_FLY_SCALING_ENABLED                 //nothing to fill, request_DAC_code_table_generation() applies levels directly
+	if((generation->state == DAC_TABLE_GENERATION_COMPUTE) && (generation->shape == SHAPE_SINE))
+	{
+		compute_DAC_code_table(generation->pending_active_DAC_table_index, generation->amplitude_scale, generation->offset_scale, generation->next_point, DAC_TABLE_GENERATION_POINTS_PER_SLICE / 4);   //each quarter point writes four table points
+		generation->next_point += DAC_TABLE_GENERATION_POINTS_PER_SLICE / 4;
+		is_fill_complete = (generation->next_point >= SINE_QUARTER_TABLE_SIZE);
+	}
+	else if(generation->state == DAC_TABLE_GENERATION_COMPUTE)
+	{
+		compute_DAC_code_table_from_waveform(generation->pending_active_DAC_table_index, generation->shape, generation->amplitude_scale, generation->offset_scale, generation->next_point, DAC_TABLE_GENERATION_POINTS_PER_SLICE);
+		generation->next_point += DAC_TABLE_GENERATION_POINTS_PER_SLICE;
+		is_fill_complete = (generation->next_point >= SINE_TABLE_SIZE);
+	}
+	else
+#endif
+	if(generation->state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		if(output.live_DAC_table_generation == generation->generation_number)
+		{
+			generation->state = DAC_TABLE_GENERATION_IDLE;
+			execute_DAC_code_table_update_complete_sequence();
+		}
+	}
+	
+	if(is_fill_complete)
+	{
+		output.DAC_table_half_generation[generation->pending_active_DAC_table_index] = generation->generation_number;
+		generation->state = DAC_TABLE_GENERATION_SWAP_PENDING;
+		
+		arm_DAC_table_swap();                   //Throw the switch! ...once the output gets round to the swap phase
+	}
+}
+
+uint32_t get_live_DAC_table_generation(void)
+{
+	return(output.live_DAC_table_generation);
+}
+
+void set_DAC_table_swap_phase(float phase_degrees)
+{
+	output.DAC_table_swap_phase = (unsigned int)((phase_degrees / 360.0f) * PERIOD_COUNTS) & (PERIOD_COUNTS - 1);
+	
+	if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		arm_DAC_table_swap();
+	}
+}
+
+/**
+ * @brief Arms the sample path to adopt the freshly filled table at the first sample at or past DAC_table_swap_phase.
+ * 
+ * Rather than have the ISR test for the phase crossing every sample, the accumulator value of that sample is worked out
+ * here, so the hot path only does an equality compare. Because the increment is fixed between now and then, the
+ * accumulator is guaranteed to land on it. Anything that changes the increment or the accumulator must re-arm.
+ * 
+ * The fraction carries are accounted for: after n samples the accumulator has moved n * integer + (fraction + n * remainder) / modulus
+ * counts, so n is the smallest count for which that reaches the swap phase, i.e. n * (integer * modulus + remainder) >= phase * modulus - fraction.
+ * 
+ * @return void
+ */
+static void arm_DAC_table_swap(void)
+{
+	uint64_t phase_to_swap;
+	uint64_t modulus_counts_per_sample;
+	uint64_t samples_to_swap;
+	
+	MASK_ALL_INTERRUPTS();
+	if((output.phase_increment == 0) || (output.burst_samples_remaining == 0))
+	{
+		UNMASK_INTERRUPTS();
+		swap_DAC_table_now();                   //the phase never moves (or is parked between bursts), so it'll never reach the swap phase
+	}
+	else
+	{
+		phase_to_swap = ((output.DAC_table_swap_phase - output.phase_accumulator) & (PERIOD_COUNTS - 1)) * (uint64_t)output.phase_modulus;     //in 1/modulus counts
+		phase_to_swap = (phase_to_swap > output.phase_fraction) ? (phase_to_swap - output.phase_fraction) : 0;
+		modulus_counts_per_sample = ((uint64_t)output.phase_increment * output.phase_modulus) + output.phase_increment_remainder;
+		samples_to_swap = (phase_to_swap + modulus_counts_per_sample - 1) / modulus_counts_per_sample;
+		output.DAC_table_swap_accumulator = output.phase_accumulator + (unsigned int)(samples_to_swap * output.phase_increment) +
+		                                    (unsigned int)((output.phase_fraction + (samples_to_swap * output.phase_increment_remainder)) / output.phase_modulus);
+		output.swap_DAC_table_generation = output.DAC_table_generation.generation_number;
+		output.swap_DAC_table_index = output.DAC_table_generation.pending_active_DAC_table_index;
+		UNMASK_INTERRUPTS();
+	}
+}
+
+/**
+ * @brief Adopts the freshly filled table immediately, regardless of phase.
+ * 
+ * @return void
+ */
+static void swap_DAC_table_now(void)
+{
+	MASK_ALL_INTERRUPTS();
+	output.active_DAC_table_index = output.DAC_table_generation.pending_active_DAC_table_index;
+	output.swap_DAC_table_index = output.active_DAC_table_index;
+	output.live_DAC_table_generation = output.DAC_table_generation.generation_number;
+	output.swap_DAC_table_generation = output.live_DAC_table_generation;
+	UNMASK_INTERRUPTS();
+}
+
+/**
+ * @brief Cancels a table fill in progress, or one filled and waiting on its swap. The swap is disarmed, and the inactive half
+ * loses its generation number before interrupts come back, so the ISR can't adopt it part filled or superseded. The swap may
+ * have just happened, in which case that table is now the active one and stays so.
+ * 
+ * @return void
+ */
+static void cancel_DAC_code_table_generation(void)
+{
+	MASK_ALL_INTERRUPTS();
+	output.swap_DAC_table_index = output.active_DAC_table_index;
+	output.swap_DAC_table_generation = output.live_DAC_table_generation;   //disarmed the same way swap_DAC_table_now() leaves it, nothing refers to the cancelled fill
+	output.DAC_table_generation.state = DAC_TABLE_GENERATION_IDLE;     //so a frequency sweep tick can't re-arm it behind our back
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+	output.DAC_table_half_generation[output.active_DAC_table_index ^ 1] = 0;
+#endif
+	UNMASK_INTERRUPTS();
+}
+
+bool is_DAC_code_table_generation_pending(void)
+{
+	return(output.DAC_table_generation.state != DAC_TABLE_GENERATION_IDLE);
+}
+
+/**
+ * @brief Converts a level into the integer scale used by the table kernels: DAC LSBs
+ * with DAC_CODE_SCALE_FRACTION_BITS of fraction.
+ * 
+ * @param level amplitude or offset, in the same units as full_scale_divisor
+ * @param full_scale_divisor nominal full scale of the active range
+ * 
+ * @return int32_t scaled level
+ */
+static int32_t get_DAC_code_scale(float level, float full_scale_divisor)
+{
+	return ((int32_t)(((double)(AD5791_DAC_POSITIVE_FULL_SCALE_CODE << DAC_CODE_SCALE_FRACTION_BITS) * level) / full_scale_divisor));   //double, since float would only keep 24 of the 31 bits. Once per table, so the cost doesn't matter.
+}
+
+void invalidate_DAC_calibration(void)
+{
+	uint32_t i;
+	float correction;
+	
+	for(i = 0; i < NUMBER_OF_DAC_CALIBRATION_POINTS; i++)
+	{
+		output.DAC_calibration[i].is_valid = false;
+	}
+	
+	output.is_DAC_INL_correction_active = false;
+	for(i = 0; i < NUMBER_OF_INL_CORRECTION_POINTS; i++)
+	{
+		correction = calibration_data.INL_corrections[i];
+		if(correction > DAC_INL_MAXIMUM_CORRECTION)
+		{
+			correction = DAC_INL_MAXIMUM_CORRECTION;
+		}
+		else if(!(correction >= -DAC_INL_MAXIMUM_CORRECTION))   //catches NaN too
+		{
+			correction = (correction < 0.0f) ? -DAC_INL_MAXIMUM_CORRECTION : 0.0f;
+		}
+		
+		output.DAC_INL_correction[i] = (int32_t)(correction * (float)(1 << DAC_CODE_SCALE_FRACTION_BITS));
+		if(output.DAC_INL_correction[i] != 0)
+		{
+			output.is_DAC_INL_correction_active = true;
+		}
+	}
+	
+	output.amplitude_frequency_compensation = get_amplitude_frequency_compensation(output.compensation_frequency, output.compensation_sampling_frequency);
+}
+
+void select_DAC_calibration(uint32_t calibration_point, float full_scale_divisor)
+{
+	DAC_calibration_type *calibration;
+	calibration_set_type *calibration_set = &calibration_data.voltage;
+	uint32_t set_point = calibration_point;
+	float gain;
+	
+	if(calibration_point >= NUMBER_OF_DAC_CALIBRATION_POINTS)
+	{
+		return;
+	}
+	
+	if(calibration_point >= NUMBER_OF_VOLTAGE_CAL_POINTS)
+	{
+		calibration_set = &calibration_data.current;
+		set_point -= NUMBER_OF_VOLTAGE_CAL_POINTS;
+	}
+	
+	calibration = &output.DAC_calibration[calibration_point];
+	
+	if(!calibration->is_valid || (calibration->full_scale_divisor != full_scale_divisor))
+	{
+		gain = calibration_set->gains[set_point];
+		if((gain <= 0.0f) || (gain >= DAC_CALIBRATION_MAXIMUM_GAIN))
+		{
+			gain = 1.0f;                                        //not a usable gain, most likely an unwritten cal point
+		}
+		
+		calibration->gain_scale = (int32_t)(gain * (float)(1 << DAC_CALIBRATION_GAIN_FRACTION_BITS));
+		calibration->bias_scale = get_DAC_code_scale(calibration_set->offsets[set_point], full_scale_divisor);
+		calibration->full_scale_divisor = full_scale_divisor;
+		calibration->is_valid = true;
+	}
+	
+	output.active_DAC_calibration_point = calibration_point;
+}
+
+/**
+ * @brief Applies the active range's calibration to a scaled level. The gain and offset were folded into integers once by
+ * select_DAC_calibration(), so this is a multiply-add per table rather than anything per point.
+ * 
+ * @param DAC_code_scale level, as returned by get_DAC_code_scale
+ * @param is_offset true = offsets and DC levels get the calibration offset added, false = amplitudes only get the gain
+ * 
+ * @return int32_t calibrated level, limited to the DAC's range
+ */
+static int32_t get_calibrated_DAC_code_scale(int32_t DAC_code_scale, bool is_offset)
+{
+	const DAC_calibration_type *calibration = &output.DAC_calibration[output.active_DAC_calibration_point];
+	int64_t calibrated_scale = ((int64_t)DAC_code_scale * calibration->gain_scale) >> DAC_CALIBRATION_GAIN_FRACTION_BITS;
+	
+	if(is_offset)
+	{
+		calibrated_scale += calibration->bias_scale;
+	}
+	
+	if(calibrated_scale > ((int64_t)AD5791_DAC_POSITIVE_FULL_SCALE_CODE << DAC_CODE_SCALE_FRACTION_BITS))
+	{
+		calibrated_scale = (int64_t)AD5791_DAC_POSITIVE_FULL_SCALE_CODE << DAC_CODE_SCALE_FRACTION_BITS;
+	}
+	else if(calibrated_scale < -((int64_t)(AD5791_DAC_POSITIVE_FULL_SCALE_CODE + 1) << DAC_CODE_SCALE_FRACTION_BITS))
+	{
+		calibrated_scale = -((int64_t)(AD5791_DAC_POSITIVE_FULL_SCALE_CODE + 1) << DAC_CODE_SCALE_FRACTION_BITS);
+	}
+	
+	return((int32_t)calibrated_scale);
+}
+
+/**
+ * @brief Takes the DAC's INL at a level off it. The code space is split into 2^DAC_INL_SEGMENT_BITS equal segments, so
+ * finding the segment is a shift, and the correction is a linear blend of the two ends of it. Only the code's top bits pick
+ * the segment, so the error from using the uncorrected code is far below an LSB.
+ * 
+ * @param DAC_code_scale level in DAC_CODE_SCALE_FRACTION_BITS, limited to the DAC's range here
+ * 
+ * @return int32_t corrected level, still in DAC_CODE_SCALE_FRACTION_BITS and limited to the DAC's range
+ */
+static inline int32_t get_INL_corrected_DAC_code_scale(int64_t DAC_code_scale)
+{
+	const int32_t maximum_scale = (1 << (AD5791_DAC_DATA_BITS - 1 + DAC_CODE_SCALE_FRACTION_BITS)) - 1;
+	int32_t level;
+	uint32_t position;
+	uint32_t segment;
+	int32_t fraction;
+	int32_t correction;
+	
+	if(DAC_code_scale > maximum_scale)
+	{
+		level = maximum_scale;
+	}
+	else if(DAC_code_scale < -maximum_scale - 1)
+	{
+		level = -maximum_scale - 1;
+	}
+	else
+	{
+		level = (int32_t)DAC_code_scale;
+	}
+	
+	position = (uint32_t)(level + maximum_scale + 1);                                                          //0 at the most negative code
+	segment = position >> (AD5791_DAC_DATA_BITS + DAC_CODE_SCALE_FRACTION_BITS - DAC_INL_SEGMENT_BITS);
+	fraction = (int32_t)((position >> DAC_CODE_SCALE_FRACTION_BITS) & ((1 << (AD5791_DAC_DATA_BITS - DAC_INL_SEGMENT_BITS)) - 1));
+	correction = output.DAC_INL_correction[segment] +
+	             (((output.DAC_INL_correction[segment + 1] - output.DAC_INL_correction[segment]) * fraction) >> (AD5791_DAC_DATA_BITS - DAC_INL_SEGMENT_BITS));
+	
+	return(__SSAT(level - correction, AD5791_DAC_DATA_BITS + DAC_CODE_SCALE_FRACTION_BITS));
+}
+
+/**
+ * @brief Turns a level into a DAC code, less the DAC's INL at that code
+ * 
+ * @param DAC_code_scale level in DAC_CODE_SCALE_FRACTION_BITS, including any rounding, limited to the DAC's range here
+ * 
+ * @return int32_t DAC code, two's complement
+ */
+static inline int32_t get_INL_predistorted_DAC_code(int64_t DAC_code_scale)
+{
+	return(get_INL_corrected_DAC_code_scale(DAC_code_scale) >> DAC_CODE_SCALE_FRACTION_BITS);
+}
+
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+/**
+ * @brief Fixed-point DAC code table kernel. Every point is code = (offset_scale << 31 + amplitude_scale * sine_Q31) >> 42,
+ * with the scale and bias worked out once per call by get_DAC_code_scale, rounded to nearest and saturated to 20 bits.
+ * 
+ * The quarter-wave table makes the product for point i in the 1st quadrant serve four points: i and its mirror in the 2nd
+ * quadrant get bias + product, their negations in the 3rd and 4th quadrants get bias - product. So each iteration is one
+ * SMULL, an add and a subtract on the 64-bit accumulator (SMLAL-style), two SSATs and four stores. This replaces the float
+ * multiply/add/divide/convert of COMPUTE_AD5791_CODE for every point, and lands within about 1 LSB of the ideal code.
+ * 
+ * @param pending_active_DAC_table_index half of int_DAC_code_table to write
+ * @param amplitude_scale amplitude, as returned by get_DAC_code_scale
+ * @param offset_scale offset, as returned by get_DAC_code_scale
+ * @param first_quarter_point first quarter table point of this slice
+ * @param number_of_quarter_points quarter table points in this slice
+ * 
+ * @return void
+ */
+static void compute_DAC_code_table(uint32_t pending_active_DAC_table_index, int32_t amplitude_scale, int32_t offset_scale, uint32_t first_quarter_point, uint32_t number_of_quarter_points)
+{
+	uint32_t i;
+	uint32_t end_quarter_point = first_quarter_point + number_of_quarter_points;
+	int64_t bias = ((int64_t)offset_scale << 31) + ((int64_t)1 << (30 + DAC_CODE_SCALE_FRACTION_BITS));     //offset plus 1/2 LSB, so the shift rounds
+	AD5791_frame_type *pending_DAC_code_table = output.int_DAC_code_table[pending_active_DAC_table_index];
+	
+	if(end_quarter_point > SINE_QUARTER_TABLE_SIZE)
+	{
+		end_quarter_point = SINE_QUARTER_TABLE_SIZE;
+	}
+	
+	for(i = first_quarter_point; i < end_quarter_point; i++)
+	{
+		int64_t product = (int64_t)amplitude_scale * output.normalized_sine_table[i];
+		uint32_t positive_DAC_code;
+		uint32_t negative_DAC_code;
+		
+		if(output.is_DAC_INL_correction_active)
+		{
+			positive_DAC_code = AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & get_INL_predistorted_DAC_code((bias + product) >> 31));
+			negative_DAC_code = AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & get_INL_predistorted_DAC_code((bias - product) >> 31));
+		}
+		else
+		{
+			positive_DAC_code = AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & __SSAT((int32_t)((bias + product) >> (31 + DAC_CODE_SCALE_FRACTION_BITS)), AD5791_DAC_DATA_BITS));
+			negative_DAC_code = AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & __SSAT((int32_t)((bias - product) >> (31 + DAC_CODE_SCALE_FRACTION_BITS)), AD5791_DAC_DATA_BITS));
+		}
+		
+		pack_AD5791_frame(&pending_DAC_code_table[i], positive_DAC_code);
+		pack_AD5791_frame(&pending_DAC_code_table[(2 * SINE_QUARTER_TABLE_SIZE - 1) - i], positive_DAC_code);
+		pack_AD5791_frame(&pending_DAC_code_table[(2 * SINE_QUARTER_TABLE_SIZE) + i], negative_DAC_code);
+		pack_AD5791_frame(&pending_DAC_code_table[(SINE_TABLE_SIZE - 1) - i], negative_DAC_code);
+	}
+}
+
+/**
+ * @brief DAC code table kernel for the shapes without sine's quarter-wave table. Same scale, bias, rounding and saturation
+ * as compute_DAC_code_table, but one point per iteration from get_normalized_waveform_value().
+ * 
+ * @param pending_active_DAC_table_index half of int_DAC_code_table to write
+ * @param shape square, triangle, ramp or ARB
+ * @param amplitude_scale amplitude, as returned by get_DAC_code_scale
+ * @param offset_scale offset, as returned by get_DAC_code_scale
+ * @param first_point first table point of this slice
+ * @param number_of_points table points in this slice
+ * 
+ * @return void
+ */
+static void compute_DAC_code_table_from_waveform(uint32_t pending_active_DAC_table_index, output_shape_type shape, int32_t amplitude_scale, int32_t offset_scale, uint32_t first_point, uint32_t number_of_points)
+{
+	uint32_t i;
+	uint32_t end_point = first_point + number_of_points;
+	int64_t bias = ((int64_t)offset_scale << 31) + ((int64_t)1 << (30 + DAC_CODE_SCALE_FRACTION_BITS));
+	AD5791_frame_type *pending_DAC_code_table = output.int_DAC_code_table[pending_active_DAC_table_index];
+	
+	if(end_point > SINE_TABLE_SIZE)
+	{
+		end_point = SINE_TABLE_SIZE;
+	}
+	
+	for(i = first_point; i < end_point; i++)
+	{
+		int64_t product = (int64_t)amplitude_scale * get_normalized_waveform_value(shape, i);
+		int32_t DAC_code;
+		
+		if(output.is_DAC_INL_correction_active)
+		{
+			DAC_code = get_INL_predistorted_DAC_code((bias + product) >> 31);
+		}
+		else
+		{
+			DAC_code = __SSAT((int32_t)((bias + product) >> (31 + DAC_CODE_SCALE_FRACTION_BITS)), AD5791_DAC_DATA_BITS);
+		}
+		
+		pack_AD5791_frame(&pending_DAC_code_table[i], AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & DAC_code));
+	}
+}
+#endif
+
+/**
+ * @brief Gets one point of a normalized (+/-1) waveform period, Q31. Points sit at the same half-index phases as the sine table,
+ * and each shape starts at 0 phase the way sine does, so switching shapes keeps the same phase reference. With
+ * DDS_ON_THE_FLY_SCALING_ENABLED this is the sample path's waveform lookup, so there's no full period table to keep in SRAM.
+ * 
+ * @param shape sine, square, triangle, ramp or ARB
+ * @param index table point, 0 to SINE_TABLE_SIZE - 1
+ * 
+ * @return int32_t normalized waveform value, Q31
+ */
+static inline int32_t get_normalized_waveform_value(output_shape_type shape, uint32_t index)
+{
+	int32_t value;
+	uint32_t quarter_index;
+	
+	switch(shape)
+	{
+		case SHAPE_SINE:
+			quarter_index = index & (SINE_QUARTER_TABLE_SIZE - 1);                          //quadrants folded as in compute_DAC_code_table()
+			if(index & SINE_QUARTER_TABLE_SIZE)
+			{
+				quarter_index = (SINE_QUARTER_TABLE_SIZE - 1) - quarter_index;
+			}
+			value = output.normalized_sine_table[quarter_index];
+			if(index & (2 * SINE_QUARTER_TABLE_SIZE))
+			{
+				value = -value;
+			}
+			break;
+		
+		case SHAPE_SQUARE:
+			value = (index < (SINE_TABLE_SIZE / 2)) ? INT32_MAX : -INT32_MAX;
+			break;
+		
+		case SHAPE_TRIANGLE:
+			quarter_index = index & (SINE_QUARTER_TABLE_SIZE - 1);                          //folded by quadrant exactly like get_sine_table_value()
+			if(index & SINE_QUARTER_TABLE_SIZE)
+			{
+				quarter_index = (SINE_QUARTER_TABLE_SIZE - 1) - quarter_index;
+			}
+			value = (int32_t)((2 * quarter_index + 1) << (32 - SINE_TABLE_BITS));
+			if(index & (2 * SINE_QUARTER_TABLE_SIZE))
+			{
+				value = -value;
+			}
+			break;
+		
+		case SHAPE_RAMP:
+			value = (int32_t)((2 * index + 1) << (31 - SINE_TABLE_BITS));                  //rises 0 to +1 over the 1st half period, then wraps to -1 and rises back to 0
+			break;
+		
+		case SHAPE_ARB:
+			value = (int32_t)output.ARB_table[index] << 16;
+			break;
+		
+		default:
+			value = 0;
+			break;
+	}
+	
+	return(value);
+}
+
+void bring_DAC_output_to_zero(output_shape_type output_shape)
+{
+	if(output_shape == SHAPE_DC)
+	{
+		write_DC_DAC_code(0);                           //straight to zero, no ramp. The hardware is about to be reconfigured.
+	}
+	else
+	{
+		generate_DAC_code_table(0,0,1);
+	}
+
+}
+
+void update_DAC_output_while_in_DC_mode(float desired_output_amplitude, float full_scale_divisor)
+{
+	int32_t level = get_calibrated_DAC_code_scale(get_DAC_code_scale(desired_output_amplitude, full_scale_divisor), true);   //DAC_CODE_SCALE_FRACTION_BITS == DC_RAMP_FRACTION_BITS
+	int32_t DAC_code = (level + (1 << (DC_RAMP_FRACTION_BITS - 1))) >> DC_RAMP_FRACTION_BITS;                                //rounded, to match the table kernels
+	
+	if(output.is_DAC_INL_correction_active)
+	{
+		DAC_code = get_INL_predistorted_DAC_code((int64_t)level + (1 << (DC_RAMP_FRACTION_BITS - 1)));
+	}
+	
+#if !DAC_BLOCK_STREAMING_ENABLED                    //the PDC owns the sample timer's frames while streaming
+	if(!output.DC_ramp.is_dither_enabled)
+	{
+		level = DAC_code << DC_RAMP_FRACTION_BITS;                  //a plain DC level lands exactly on a code
+	}
+	else if(output.is_DAC_INL_correction_active)
+	{
+		//Blend the corrected levels either side by the fraction, so the dither carries the correction's sub-LSB part as well as the level's
+		int32_t lower_level = get_INL_corrected_DAC_code_scale((int64_t)(level >> DC_RAMP_FRACTION_BITS) << DC_RAMP_FRACTION_BITS);
+		int32_t upper_level = get_INL_corrected_DAC_code_scale(((int64_t)(level >> DC_RAMP_FRACTION_BITS) + 1) << DC_RAMP_FRACTION_BITS);
+		
+		level = lower_level + (int32_t)(((int64_t)(upper_level - lower_level) * (level & ((1 << DC_RAMP_FRACTION_BITS) - 1))) >> DC_RAMP_FRACTION_BITS);
+	}
+	
+	if((output.DC_ramp.slew_rate > 0) || output.DC_ramp.is_dither_enabled)
+	{
+		start_DC_ramp(level, (output.DC_ramp.slew_rate * 0x7FFFFu) / full_scale_divisor);
+		return;
+	}
+#endif
+	
+	write_DC_DAC_code(DAC_code);
+}
+
+void set_DC_dither_enabled(bool enable_dither)
+{
+	if(enable_dither && !output.DC_ramp.is_dither_enabled)
+	{
+		output.DC_ramp.dither_error[0] = 0;
+		output.DC_ramp.dither_error[1] = 0;
+	}
+	
+	output.DC_ramp.is_dither_enabled = enable_dither;
+}
+
+void set_DC_slew_rate(float slew_rate)
+{
+	output.DC_ramp.slew_rate = slew_rate;
+}
+
+bool is_DC_ramp_running(void)
+{
+	return(output.DC_ramp.is_active && (output.DC_ramp.step != 0));          //a dithered level keeps the ISR running once it's there
+}
+
+void service_DC_ramp(void)
+{
+	//The report goes out over LSCP, which mallocs, so it can't be sent from the ISR
+	if(output.DC_ramp.is_complete_report_pending)
+	{
+		output.DC_ramp.is_complete_report_pending = false;
+		execute_DC_ramp_complete_sequence();
+	}
+}
+
+/**
+ * @brief Jumps the DAC straight to a DC code, abandoning any ramp in progress
+ * 
+ * @param DAC_code two's complement DAC code
+ * 
+ * @return void
+ */
+static void write_DC_DAC_code(int32_t DAC_code)
+{
+	if(output.DC_ramp.is_active)
+	{
+		DISABLE_TIMER_INTERRUPT();
+		DISABLE_TIMER_CLOCK();
+		output.DC_ramp.is_active = false;
+	}
+	
+	output.DC_ramp.present_code = DAC_code << DC_RAMP_FRACTION_BITS;
+	pack_AD5791_frame(&output.one_shot_DAC_frame, AD5791_DAC_WRITE_COMMAND | (AD5791_DAC_DATA_MASK & DAC_code));	//the waveform timer is stopped in DC mode, so only the one code is needed, not a whole table
+	execute_one_shot_DAC_write_sequence();
+}
+
+/**
+ * @brief Ramps the DAC from its present level to a new DC level at a fixed slew, one step per sample at the present sample rate.
+ * A new target while a ramp is running carries on from wherever the ramp has got to. Without a slew rate, the level is jumped to
+ * on the next sample, which is how a dithered level is started.
+ * 
+ * @param target_level DAC code to end on, with DC_RAMP_FRACTION_BITS below the LSB
+ * @param codes_per_second slew rate, 0 = jump
+ * 
+ * @return void
+ */
+static void start_DC_ramp(int32_t target_level, float codes_per_second)
+{
+	float step = (codes_per_second * (float)(1 << DC_RAMP_FRACTION_BITS)) / get_output_sampling_frequency();
+	int32_t step_counts = (step >= (float)DC_RAMP_MAXIMUM_STEP) ? DC_RAMP_MAXIMUM_STEP : (int32_t)step;
+	
+	if(step_counts < 1)
+	{
+		step_counts = 1;
+	}
+	
+	MASK_ALL_INTERRUPTS();
+	output.DC_ramp.target_code = target_level;
+	if(codes_per_second > 0)
+	{
+		output.DC_ramp.step = (target_level < output.DC_ramp.present_code) ? -step_counts : step_counts;
+	}
+	else
+	{
+		output.DC_ramp.present_code = target_level;
+		output.DC_ramp.step = 0;                                    //nothing to report arriving at
+	}
+	
+	if(!output.DC_ramp.is_active)
+	{
+		output.DC_ramp.is_active = true;
+		output.DC_ramp.is_complete_report_pending = false;
+		DISABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();                //the first pass re-sends the present level, so a one shot in flight isn't disturbed
+		ENABLE_TIMER_INTERRUPT();
+		ENABLE_TIMER_CLOCK();
+		ISSUE_TIMER_SW_TRIGGER();
+	}
+	UNMASK_INTERRUPTS();
+}
+
+/**
+ * \brief called when only one value needs to be written to AD5791 DAC
+ * 
+ * See comments in implementation for further details of how this works.
+ * 
+ * \param 
+ * 
+ * \return void
+ */
+void execute_one_shot_DAC_write_sequence(void)
+{
+#if DAC_BLOCK_STREAMING_ENABLED
+	format_DAC_stream_frame(output.one_shot_stream_frame, &output.one_shot_DAC_frame);      //SPI is in variable peripheral mode, so the frame has to go out as stream words too.
+	SET_SPI_PDC_TX_POINTER(output.one_shot_stream_frame);
+	SET_SPI_PDC_TX_COUNT(DAC_STREAM_WORDS_PER_FRAME);
+#else
+	output.next_DAC_frame = &output.one_shot_DAC_frame;
+	output.sample_overrun.is_one_shot_write = true;				//the counter isn't running, so the ISR's lateness check would be meaningless
+	OUTPUT_UPDATE_TIMER_ISR();									//"call" ISR in order to take new DC value and kick of SPI Tx so it gets shifted into DAC.
+	output.sample_overrun.is_one_shot_write = false;
+#endif
+	while(!IS_SPI_PDC_TXBUFFER_EMPTY());						//wait for PDC to push data out before we kick off timer, which in turn will then fire off LDAC toggle
+	ENABLE_TIMER_CLOCK();										//Enables timer clock but doesn't actually start counting up yet.
+	ENABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();					//This ensures the LDAC line will only load once. Once RC is hit, the timer peripheral will disable its own clock
+	ISSUE_TIMER_SW_TRIGGER();									//This causes the timer counter to reset and start the count up to the LDAC toggle (low when RA is hit, back high when RC is hit)
+}
+
+#if !DAC_BLOCK_STREAMING_ENABLED
+/**
+ * @brief Starts the sample timer playing the table. The first LDAC falls at RA, a whole period before the first RC compare
+ * fires the ISR, so the sample path is run twice here first with the timer stopped: the first pass builds the frame for the
+ * present phase, the second hands it to the PDC and builds the one after. The first LDAC then latches the first sample,
+ * rather than whatever the DAC last held, and the first RC compare sends the second.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+static void start_sample_timer_playback(void)
+{
+	DISABLE_TIMER_INTERRUPT();                                  //the table may already be playing, e.g. a range change, so keep the ISR out of the passes below
+	DISABLE_TIMER_CLOCK();
+	
+	output.sample_overrun.is_one_shot_write = true;             //the counter isn't running, so the ISR's lateness check would be meaningless
+	OUTPUT_UPDATE_TIMER_ISR();
+	while(!IS_SPI_TX_COMPLETE());                               //a byte queued before SYNC rises would run the two frames together
+	OUTPUT_UPDATE_TIMER_ISR();
+	output.sample_overrun.is_one_shot_write = false;
+	
+	DISABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();
+	ENABLE_TIMER_INTERRUPT();
+	ENABLE_TIMER_CLOCK();
+	ISSUE_TIMER_SW_TRIGGER();                                   //the first frame is already shifting, and done well before RA
+}
+#endif
+
+#pragma endregion "AD5791 DAC Manipulation Functions"
+
+#pragma region "Output Stage Hardware Manipulation Functions"
+
+void configure_DAC_input_to_desired_output_stage(output_mode_type output_mode, output_stage_selection_type desired_output_stage)
+{
+	uint32_t IO_line_state;
+	uint32_t IO_line_mask = (LV_DAC_IN_MASK | HV_DAC_IN_MASK | LV_OUTMODE_SEL_MASK | HV_OUTMODE_SEL_MASK);     //we're always manipulating the respective DAC input and OUTMODEL SEL masks in this function
+	
+	if(desired_output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+	{
+		IO_line_state = LV_DAC_IN_ENABLE | HV_DAC_IN_DISABLE | HV_OUTMODE_SEL_VOLTAGE;      //despite being disabled and a don't care, force HV outmode to known "voltage" state. Helps with system testing.
+		
+		if(output_mode == VOLTAGE_MODE)
+		{
+			IO_line_state |= LV_OUTMODE_SEL_VOLTAGE;
+		}
+		else if(output_mode == CURRENT_MODE)
+		{
+			IO_line_state |= LV_OUTMODE_SEL_CURRENT;
+		}
+		
+		presently_selected_output_stage = OUTSTG_SEL_LOW_VOLTAGE;
+	}
+	else if(desired_output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+	{
+		IO_line_state = LV_DAC_IN_DISABLE | HV_DAC_IN_ENABLE | LV_OUTMODE_SEL_VOLTAGE;      //despite being disabled and a don't care, force LV outmode to known "voltage" state. Helps with system testing.
+		
+		if(output_mode == VOLTAGE_MODE)
+		{
+			IO_line_state |= HV_OUTMODE_SEL_VOLTAGE;
+		}
+		else if(output_mode == CURRENT_MODE)
+		{
+			IO_line_state |= HV_OUTMODE_SEL_CURRENT;
+		}
+		
+		presently_selected_output_stage = OUTSTG_SEL_HIGH_VOLTAGE;
+	}
+	else                                                                                    //else, safely default to disabling inputs to both output stages
+	{
+		IO_line_state = (LV_DAC_IN_DISABLE | HV_DAC_IN_DISABLE | LV_OUTMODE_SEL_VOLTAGE | HV_OUTMODE_SEL_VOLTAGE);
+		
+		presently_selected_output_stage = OUTSTG_SEL_BOTH;
+	}
+	
+	set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
+}
+
+output_stage_selection_type get_presently_selected_output_stage(void)
+{
+	return(presently_selected_output_stage);
+}
+
+void set_low_voltage_voltage_range_HW(voltage_range_type range)
+{
+	uint32_t LV_range_IO_line_state = 0;
+	
+	switch(range)
+	{
+		case VRANGE_100mV:
+			LV_range_IO_line_state = LV_VRNG_100MV;
+			break;
+		
+		case VRANGE_1V:
+			LV_range_IO_line_state = LV_VRNG_1V;
+			break;
+		
+		case VRANGE_10V:
+			LV_range_IO_line_state = LV_VRNG_10V;
+			break;
+		
+		case VRANGE_10mV:
+		default:
+			LV_range_IO_line_state = LV_VRNG_10MV;
+			break;
+	}
+	
+	set_HW_configuration_lines(LV_IO_PORT, LV_VRNG_MASK, LV_range_IO_line_state);
+}
+
+void set_low_voltage_current_range_HW(current_range_type range)
 {
     uint32_t LV_range_IO_line_state = 0;
     
-    switch(range)
+    switch(range)
+    {
+        case IRANGE_10uA:
+            LV_range_IO_line_state = LV_IRNG_10UA;
+            break;
+        
+        case IRANGE_100uA:
+            LV_range_IO_line_state = LV_IRNG_100UA;
+            break;
+        
+        case IRANGE_1mA:
+            LV_range_IO_line_state = LV_IRNG_1MA;
+            break;
+        
+        case IRANGE_10mA:
+            LV_range_IO_line_state = LV_IRNG_10MA;
+            break;
+        
+        case IRANGE_100mA:
+            LV_range_IO_line_state = LV_IRNG_100MA_AC_BYPASS;
+            break;
+        
+        case IRANGE_1uA:
+        default:
+            LV_range_IO_line_state = LV_IRNG_1UA;
+            break;
+    }
+    
+    set_HW_configuration_lines(LV_IO_PORT, LV_IRNG_MASK, LV_range_IO_line_state);
+}
+
+void set_high_voltage_current_range_HW(current_range_type range)
+{
+    uint32_t HV_range_IO_line_state = 0;
+    
+    switch(range)
+    {
+        case IRANGE_HV_AC_BYPASS:
+            HV_range_IO_line_state = HV_IRNG_AC_BYPASS;
+            break;
+            
+        case IRANGE_10uA:
+            HV_range_IO_line_state = HV_IRNG_10UA;
+            break;
+        
+        case IRANGE_100uA:
+            HV_range_IO_line_state = HV_IRNG_100UA;
+            break;
+        
+        case IRANGE_1mA:
+            HV_range_IO_line_state = HV_IRNG_1MA;
+            break;
+        
+        case IRANGE_10mA:
+            HV_range_IO_line_state = HV_IRNG_10MA;
+            break;
+        
+        case IRANGE_1uA:
+        default:
+            HV_range_IO_line_state = HV_IRNG_1UA;
+            break;
+    }
+    
+    set_HW_configuration_lines(HV_IO_PORT, HV_IRNG_MASK, HV_range_IO_line_state);
+    
+}
+
+void shunt_output_stage(output_stage_selection_type output_stage)
+{
+	uint32_t IO_line_state = (LV_OUTPUT_SHUNT_ENABLE | HV_OUTPUT_SHUNT_ENABLE);     //default to shunt both unless otherwise told
+	uint32_t IO_line_mask = (LV_OUTPUT_SHUNT_MASK | HV_OUTPUT_SHUNT_MASK);
+	
+	if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+	{
+		IO_line_state = LV_OUTPUT_SHUNT_ENABLE;
+		IO_line_mask = LV_OUTPUT_SHUNT_MASK;
+	}
+	else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+	{
+		IO_line_state = HV_OUTPUT_SHUNT_ENABLE;
+		IO_line_mask = HV_OUTPUT_SHUNT_MASK;
+	}
+	
+	set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
+}
+
+void unshunt_output_stage(output_stage_selection_type output_stage)
+{
+	uint32_t IO_line_state = 0;
+	uint32_t IO_line_mask = 0;
+	
+	if(output_stage != OUTSTG_SEL_BOTH)
+	{
+		if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+		{
+			IO_line_state = LV_OUTPUT_SHUNT_DISABLE;
+			IO_line_mask = LV_OUTPUT_SHUNT_MASK;
+		}
+		else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+		{
+			IO_line_state = HV_OUTPUT_SHUNT_DISABLE;
+			IO_line_mask = HV_OUTPUT_SHUNT_MASK;
+		}
+		
+		set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
+	}
+}
+
+void connect_output_stage_to_output_terminals(output_stage_selection_type output_stage)
+{
+	uint32_t IO_line_state = 0xFFFFFFFF;                            //init to safe state for IO lines in case of "output_stage" being corrupt
+	
+	if(output_stage != OUTSTG_SEL_BOTH)
+	{
+		if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+		{
+			IO_line_state = OUTSTG_SEL_LV;
+		}
+		else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+		{
+			IO_line_state = OUTSTG_SEL_HV;
+		}
+		
+		set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, OUTSTG_SEL_MASK, IO_line_state);
+	}
+	
+}
+
+void disable_output_terminals(void)
+{
+	set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, OUTSTG_SEL_MASK, OUTSTG_SEL_OPEN);
+}
+
+void select_front_or_rear_output_terminals(terminal_selection_type terminal_selection)
+{
+	uint32_t IO_line_state = 0XFFFFFFFF;                            //init to safe state for IO lines in case of "terminal_selection" being corrupt
+	
+	if(terminal_selection == TERMINALS_FRONT)
+	{
+		IO_line_state = FRONT_REAR_TERM_FRONT_SEL;
+	}
+	else if(terminal_selection == TERMINALS_REAR)
+	{
+		IO_line_state = FRONT_REAR_TERM_REAR_SEL;
+	}
+	
+	set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, FRONT_REAR_TERM_MASK, IO_line_state);
+	
+}
+
+#pragma endregion "Output Stage Hardware Manipulation Functions"
+
+#pragma region "Output Waveform Functions"
+
+void set_output_frequency(float desired_output_frequency)
+{
+    uint32_t sample_rate_shift = get_sample_rate_shift(desired_output_frequency);
+    
+    request_output_phase_increment(get_rational_phase_increment(desired_output_frequency, OUTPUT_SAMPLING_FREQUENCY / (float)(1u << sample_rate_shift)), sample_rate_shift, output.is_phase_reset_on_frequency_change);
+    update_amplitude_frequency_compensation((float)get_achieved_output_frequency(), OUTPUT_SAMPLING_FREQUENCY / (float)(1u << sample_rate_shift));
+}
+
+double get_achieved_output_frequency(void)
+{
+	return(get_rational_phase_increment_frequency(output.requested_phase_increment, OUTPUT_SAMPLING_FREQUENCY / (float)(1u << output.requested_sample_rate_shift)));
+}
+
+float get_output_sampling_frequency(void)
+{
+	return(OUTPUT_SAMPLING_FREQUENCY / (float)(1u << output.sample_rate_shift));
+}
+
+/**
+ * @brief Works out the gain that undoes the output's droop at a frequency. The DAC holds each sample for a whole sample
+ * period, which scales a sine by sinc(f/fs) = sin(pi*f/fs)/(pi*f/fs), about -0.4dB at 100kHz from 600kHz. What the
+ * reconstruction filter and output stage add on top is taken from the CalData frequency response points.
+ * 
+ * @param frequency output frequency, Hz
+ * @param sampling_frequency sample rate the DAC is updated at, Hz
+ * 
+ * @return float amplitude multiplier, 1 = no droop
+ */
+static float get_amplitude_frequency_compensation(float frequency, float sampling_frequency)
+{
+	float x = ((float)M_PI * frequency) / sampling_frequency;
+	float zero_order_hold_gain = 1.0f;
+	float position = 0;
+	float residual;
+	uint32_t point;
+	
+	if(x > 1e-3f)                                                       //below this sinc is 1 to float precision
+	{
+		zero_order_hold_gain = sinf(x) / x;
+	}
+	
+	if(frequency > FREQUENCY_RESPONSE_FIRST_POINT_HZ)
+	{
+		position = log10f(frequency / FREQUENCY_RESPONSE_FIRST_POINT_HZ) * (float)FREQUENCY_RESPONSE_POINTS_PER_DECADE;
+	}
+	
+	if(position >= (float)(NUMBER_OF_FREQUENCY_RESPONSE_POINTS - 1))
+	{
+		residual = calibration_data.frequency_response[NUMBER_OF_FREQUENCY_RESPONSE_POINTS - 1];
+	}
+	else
+	{
+		point = (uint32_t)position;
+		residual = calibration_data.frequency_response[point] + ((calibration_data.frequency_response[point + 1] - calibration_data.frequency_response[point]) * (position - (float)point));
+	}
+	
+	if(residual > FREQUENCY_RESPONSE_MAXIMUM_RESIDUAL)
+	{
+		residual = FREQUENCY_RESPONSE_MAXIMUM_RESIDUAL;
+	}
+	else if(!(residual >= -FREQUENCY_RESPONSE_MAXIMUM_RESIDUAL))        //catches NaN too
+	{
+		residual = (residual < 0.0f) ? -FREQUENCY_RESPONSE_MAXIMUM_RESIDUAL : 0.0f;
+	}
+	
+	return(1.0f / (zero_order_hold_gain * (1.0f + residual)));
+}
+
+/**
+ * @brief Moves the sine amplitude compensation to a new frequency. If it changes by more than AMPLITUDE_COMPENSATION_UPDATE_THRESHOLD
+ * while a sine is being output, the table is regenerated at the last requested levels, and adopted at the swap phase like any level change.
+ * 
+ * @param frequency output frequency, Hz
+ * @param sampling_frequency sample rate the DAC is updated at, Hz
+ * 
+ * @return void
+ */
+static void update_amplitude_frequency_compensation(float frequency, float sampling_frequency)
+{
+	DAC_table_generation_type *generation = &output.DAC_table_generation;
+	float compensation = get_amplitude_frequency_compensation(frequency, sampling_frequency);
+	
+	output.compensation_frequency = frequency;
+	output.compensation_sampling_frequency = sampling_frequency;
+	
+	if(fabsf(compensation - output.amplitude_frequency_compensation) > (AMPLITUDE_COMPENSATION_UPDATE_THRESHOLD * compensation))
+	{
+		output.amplitude_frequency_compensation = compensation;
+		
+		if((output.waveform_shape == SHAPE_SINE) && output.DC_ramp.is_waveform_running && (generation->uncompensated_amplitude != 0.0f))
+		{
+			request_DAC_code_table_generation(generation->uncompensated_amplitude, generation->offset, generation->full_scale_divisor);
+		}
+	}
+}
+
+/**
+ * @brief Picks the slowest sample rate that still gives OUTPUT_MINIMUM_SAMPLES_PER_CYCLE samples per cycle of the output,
+ * and keeps its first zero-order hold image, at fs - f, out of the output. The hold's sinc response leaves that image at
+ * exactly f/(fs - f) of the output, only -36dBc at 64 samples per cycle, so either the image has to be in the reconstruction
+ * filter's stopband, or the rate has to be high enough that the hold alone takes it OUTPUT_MINIMUM_IMAGE_REJECTION down.
+ * 
+ * @param frequency output frequency, Hz
+ * 
+ * @return uint32_t sample rate = OUTPUT_SAMPLING_FREQUENCY >> returned value
+ */
+static uint32_t get_sample_rate_shift(float frequency)
+{
+	uint32_t sample_rate_shift = 0;
+	
+#if !DAC_BLOCK_STREAMING_ENABLED                    //DLYBCS is 8 bits, so streamed frames can't be padded out to the slower sample periods
+	float image_frequency;
+	
+	while(sample_rate_shift < OUTPUT_SAMPLING_RATE_MAX_SHIFT)
+	{
+		image_frequency = (OUTPUT_SAMPLING_FREQUENCY / (float)(2u << sample_rate_shift)) - frequency;       //first image at the next rate down
+		
+		if(((image_frequency + frequency) < (frequency * OUTPUT_MINIMUM_SAMPLES_PER_CYCLE)) ||
+		   ((image_frequency < OUTPUT_FILTER_STOPBAND_FREQUENCY) && (image_frequency < (frequency * OUTPUT_MINIMUM_IMAGE_REJECTION))))
+		{
+			break;
+		}
+		
+		sample_rate_shift++;
+	}
+#endif
+	
+	return(sample_rate_shift);
+}
+
+/**
+ * @brief Applies a new phase increment, along with the sample rate it was worked out for.
+ * 
+ * At the present rate, the increment is simply written, as it always has been. A new rate has to go in at a sample boundary with
+ * the counter below the new RA and RC, so it and the increment are handed to OUTPUT_UPDATE_TIMER_ISR to adopt together.
+ * Once a hand off is pending, everything goes through it so a stale pending increment can't land later on.
+ * Either way the accumulator carries on from where it is, unless reset_phase restarts it from phase_offset on the same sample.
+ * 
+ * @param phase_increment new phase increment
+ * @param sample_rate_shift sample rate the increment is for, OUTPUT_SAMPLING_FREQUENCY >> sample_rate_shift
+ * @param reset_phase true = restart the output at phase_offset. Ignored in burst mode, where bursts always start at the burst start phase.
+ * 
+ * @return void
+ */
+static void request_output_phase_increment(rational_phase_increment_type phase_increment, uint32_t sample_rate_shift, bool reset_phase)
+{
+	uint32_t sample_timer_RC;
+	
+	reset_phase = reset_phase && (output.burst_sample_decrement == 0);
+	
+	output.requested_phase_increment = phase_increment;
+	output.requested_sample_rate_shift = sample_rate_shift;
+	output.burst_samples = get_burst_samples(phase_increment, output.burst_cycles);
+	update_sync_in_loop_gains();
+	
+	if((sample_rate_shift == output.sample_rate_shift) && !output.is_sample_rate_change_pending)
+	{
+		MASK_ALL_INTERRUPTS();
+		output.phase_increment = phase_increment.integer;
+		output.phase_increment_remainder = phase_increment.remainder;
+		output.phase_modulus = phase_increment.modulus;
+		output.phase_fraction = 0;                                  //must stay below the new modulus
+		if(reset_phase)
+		{
+			output.phase_accumulator = output.phase_offset;
+		}
+		UNMASK_INTERRUPTS();
+		
+		if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+		{
+			arm_DAC_table_swap();                   //the old swap accumulator value won't be hit at the new increment
+		}
+	}
+	else
+	{
+		sample_timer_RC = GET_SAMPLE_TIMER_PERIOD_COUNTS(OUTPUT_SAMPLING_FREQUENCY) << sample_rate_shift;
+		
+		MASK_ALL_INTERRUPTS();
+		output.pending_phase_increment = phase_increment;
+		output.pending_sample_rate_shift = sample_rate_shift;
+		output.pending_sample_timer_RC = sample_timer_RC;
+		output.pending_sample_timer_RA = sample_timer_RC - output.sample_timer_LDAC_low_counts;
+		output.sample_overrun.pending_late_threshold_counts = get_sample_late_threshold_counts(output.pending_sample_timer_RA);
+		output.is_pending_phase_reset = reset_phase;
+		output.is_sample_rate_change_pending = true;
+		UNMASK_INTERRUPTS();
+	}
+}
+
+void set_output_shape(output_shape_type desired_output_shape, float amplitude, float offset, float full_scale_divisor)
+{
+    if(presently_selected_output_stage == OUTSTG_SEL_LOW_VOLTAGE)
     {
-        case IRANGE_10uA:
-            LV_range_IO_line_state = LV_IRNG_10UA;
-            break;
-        
-        case IRANGE_100uA:
-            LV_range_IO_line_state = LV_IRNG_100UA;
-            break;
-        
-        case IRANGE_1mA:
-            LV_range_IO_line_state = LV_IRNG_1MA;
-            break;
-        
-        case IRANGE_10mA:
-            LV_range_IO_line_state = LV_IRNG_10MA;
-            break;
-        
-        case IRANGE_100mA:
-            LV_range_IO_line_state = LV_IRNG_100MA_AC_BYPASS;
-            break;
-        
-        case IRANGE_1uA:
-        default:
-            LV_range_IO_line_state = LV_IRNG_1UA;
-            break;
+        amplitude = -amplitude;
+        offset = -offset;        
     }
     
-    set_HW_configuration_lines(LV_IO_PORT, LV_IRNG_MASK, LV_range_IO_line_state);
+    if(desired_output_shape == SHAPE_DC)
+    {
+        //HAS_RC_COMPARED_SINCE_LAST_STAUS_REG_READ();
+        //while(!HAS_RC_COMPARED_SINCE_LAST_STAUS_REG_READ());   //this assumes the timer is actively firing, probably won't work on power up and transition to enabled output
+#if DAC_BLOCK_STREAMING_ENABLED
+        stop_DAC_block_streaming();
+#else
+        DISABLE_TIMER_CLOCK();
+        DISABLE_TIMER_INTERRUPT();        
+#endif
+        output.DC_ramp.is_active = false;                           //a ramp stopped part way carries on from present_code
+        if(output.DC_ramp.is_waveform_running)
+        {
+            output.DC_ramp.is_waveform_running = false;
+            output.DC_ramp.present_code = unpack_AD5791_frame(output.next_DAC_frame) << DC_RAMP_FRACTION_BITS;     //ramp from wherever the waveform stopped
+        }
+        update_DAC_output_while_in_DC_mode(amplitude, full_scale_divisor);        
+    }
+    else
+    {
+        output.waveform_shape = desired_output_shape;
+        output.DC_ramp.is_active = false;                           //the table takes over from any DC ramp
+        output.DC_ramp.is_waveform_running = true;
+        generate_DAC_code_table(amplitude, offset, full_scale_divisor);
+#if DAC_BLOCK_STREAMING_ENABLED
+        if(IS_SPI_PDC_TXBUFFER_EMPTY())                          //if already streaming (e.g. range change while in sine), the new table is simply picked up on the next refill
+        {
+            start_DAC_block_streaming();
+        }
+#else
+        start_sample_timer_playback();
+#endif
+    }    
+}    
+
+void load_ARB_waveform_points(uint32_t first_point, const int16_t *points, uint32_t number_of_points)
+{
+	if((first_point + number_of_points) <= ARB_WAVEFORM_POINTS)
+	{
+		memcpy(&output.ARB_upload_table[first_point], points, number_of_points * sizeof(int16_t));
+		
+		if((first_point + number_of_points) == ARB_WAVEFORM_POINTS)
+		{
+			// Last chunk, the upload is a whole waveform. The live table becomes the next upload's buffer.
+			int16_t *uploaded_table = output.ARB_upload_table;
+			
+			output.ARB_upload_table = (int16_t *)output.ARB_table;
+			output.ARB_table = uploaded_table;
+#if !DDS_ON_THE_FLY_SCALING_ENABLED
+			// A fill part way through the old waveform starts over, rather than finishing with points from the new one
+			if((output.DAC_table_generation.state == DAC_TABLE_GENERATION_COMPUTE) && (output.DAC_table_generation.shape == SHAPE_ARB))
+			{
+				request_DAC_code_table_generation(output.DAC_table_generation.uncompensated_amplitude, output.DAC_table_generation.offset, output.DAC_table_generation.full_scale_divisor);
+			}
+#endif
+		}
+	}
+}
+
+#pragma endregion "Output Waveform Functions"
+
+#pragma region "Phase Functions"
+
+void set_output_phase(float phase_degrees, bool reset_phase_on_frequency_change)
+{
+	unsigned int phase_offset = (unsigned int)((phase_degrees / 360.0f) * PERIOD_COUNTS) & (PERIOD_COUNTS - 1);
+	
+	output.is_phase_reset_on_frequency_change = reset_phase_on_frequency_change;
+	
+	//One read-modify-write with the ISR held off, so the step lands between two samples and no sample is lost or repeated.
+	//Moving by the difference keeps the rest of the accumulator, and the phase fraction, as they were.
+	MASK_ALL_INTERRUPTS();
+	if(output.burst_sample_decrement == 0)                       //bursts park and start at the burst start phase instead
+	{
+		output.phase_accumulator += (phase_offset - output.phase_offset);
+	}
+	output.phase_offset = phase_offset;
+	UNMASK_INTERRUPTS();
+	
+	if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		arm_DAC_table_swap();                                    //the accumulator just jumped past or short of the armed value
+	}
+}
+
+float get_output_phase(void)
+{
+	return(((float)output.phase_offset * 360.0f) / (float)PERIOD_COUNTS);
+}
+
+#pragma endregion "Phase Functions"
+
+#pragma region "Burst Functions"
+
+void set_burst_mode(bool enable_burst_mode, uint32_t cycles, float start_phase_degrees, burst_trigger_source_type trigger_source)
+{
+	DISABLE_EXT_TRIGGER_INTERRUPT();
+	
+	output.burst_cycles = cycles;
+	output.burst_start_phase = (unsigned int)((start_phase_degrees / 360.0f) * PERIOD_COUNTS) & (PERIOD_COUNTS - 1);
+	output.burst_samples = get_burst_samples(output.requested_phase_increment, cycles);
+	
+	MASK_ALL_INTERRUPTS();
+	if(enable_burst_mode)
+	{
+		output.burst_sample_decrement = 1;
+		output.burst_samples_remaining = 0;                      //parked until the first trigger
+		output.phase_accumulator = output.burst_start_phase;
+		output.phase_fraction = 0;
+	}
+	else
+	{
+		output.burst_sample_decrement = 0;
+		output.burst_samples_remaining = 1;                      //carries on from wherever it is
+	}
+	UNMASK_INTERRUPTS();
+	
+	if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		arm_DAC_table_swap();                                    //parking or unparking moves the goalposts
+	}
+	
+	if(enable_burst_mode && (trigger_source == BURST_TRIGGER_EXTERNAL))
+	{
+		CLEAR_EXT_TRIGGER_FLAG();                                //don't act on an edge from before now
+		ENABLE_EXT_TRIGGER_INTERRUPT();
+	}
+}
+
+void trigger_burst(void)
+{
+	MASK_ALL_INTERRUPTS();
+	if((output.burst_sample_decrement != 0) && (output.burst_samples_remaining == 0))   //in burst mode and parked. A trigger mid burst is ignored.
+	{
+		output.phase_accumulator = output.burst_start_phase;
+		output.phase_fraction = 0;
+		output.burst_samples_remaining = output.burst_samples;
+	}
+	UNMASK_INTERRUPTS();
+}
+
+bool is_burst_running(void)
+{
+	return((output.burst_sample_decrement != 0) && (output.burst_samples_remaining != 0));
+}
+
+/**
+ * @brief Works out how many samples make up exactly cycles cycles of the output, starting with a clear phase fraction.
+ * That's the smallest n for which the accumulator has advanced cycles * PERIOD_COUNTS, i.e.
+ * n = ceil(cycles * PERIOD_COUNTS * modulus / (integer * modulus + remainder)). The numerator can pass 64 bits, so the
+ * whole samples per cycle are taken out first and the leftover is multiplied in a bit at a time, keeping the remainder below the divisor.
+ * 
+ * @param phase_increment phase increment the burst will run at
+ * @param cycles number of whole cycles
+ * 
+ * @return uint32_t samples, saturated at UINT32_MAX
+ */
+static uint32_t get_burst_samples(rational_phase_increment_type phase_increment, uint32_t cycles)
+{
+	uint64_t counts_per_sample = ((uint64_t)phase_increment.integer * phase_increment.modulus) + phase_increment.remainder;     //all in 1/modulus counts
+	uint64_t counts_per_cycle = (uint64_t)PERIOD_COUNTS * phase_increment.modulus;
+	uint64_t leftover_counts_per_cycle;
+	uint64_t samples;
+	uint64_t leftover_samples = 0;
+	uint64_t leftover_counts = 0;
+	uint32_t bit;
+	
+	if(counts_per_sample == 0)
+	{
+		return(0);
+	}
+	
+	samples = (counts_per_cycle / counts_per_sample) * cycles;
+	leftover_counts_per_cycle = counts_per_cycle % counts_per_sample;
+	
+	for(bit = 32; bit > 0; bit--)
+	{
+		leftover_samples <<= 1;
+		leftover_counts <<= 1;
+		if(leftover_counts >= counts_per_sample)
+		{
+			leftover_counts -= counts_per_sample;
+			leftover_samples++;
+		}
+		
+		if(cycles & (1u << (bit - 1)))
+		{
+			leftover_counts += leftover_counts_per_cycle;
+			if(leftover_counts >= counts_per_sample)
+			{
+				leftover_counts -= counts_per_sample;
+				leftover_samples++;
+			}
+		}
+	}
+	
+	samples += leftover_samples + ((leftover_counts != 0) ? 1 : 0);
+	
+	return((samples > UINT32_MAX) ? UINT32_MAX : (uint32_t)samples);
+}
+
+/**
+ * @brief External trigger ISR
+ * 
+ * A rising edge on the trigger input starts a burst. Only enabled while in burst mode with the external trigger source.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+void EXT_TRIGGER_ISR()
+{
+	if(CLEAR_EXT_TRIGGER_FLAG() & EXT_TRIGGER_BIT)
+	{
+		trigger_burst();
+	}
 }
 
-void set_high_voltage_current_range_HW(current_range_type range)
+#pragma endregion "Burst Functions"
+
+#pragma region "Sync Functions"
+
+void set_sync_in_mode(sync_in_mode_type mode, float lock_phase_degrees)
 {
-    uint32_t HV_range_IO_line_state = 0;
-    
-    switch(range)
-    {
-        case IRANGE_HV_AC_BYPASS:
-            HV_range_IO_line_state = HV_IRNG_AC_BYPASS;
-            break;
-            
-        case IRANGE_10uA:
-            HV_range_IO_line_state = HV_IRNG_10UA;
-            break;
-        
-        case IRANGE_100uA:
-            HV_range_IO_line_state = HV_IRNG_100UA;
-            break;
-        
-        case IRANGE_1mA:
-            HV_range_IO_line_state = HV_IRNG_1MA;
-            break;
-        
-        case IRANGE_10mA:
-            HV_range_IO_line_state = HV_IRNG_10MA;
-            break;
-        
-        case IRANGE_1uA:
-        default:
-            HV_range_IO_line_state = HV_IRNG_1UA;
-            break;
-    }
-    
-    set_HW_configuration_lines(HV_IO_PORT, HV_IRNG_MASK, HV_range_IO_line_state);
-    
+	STOP_SYNC_IN_CAPTURE();
+	
+	sync_in.mode = mode;
+	sync_in.lock_phase = (unsigned int)((lock_phase_degrees / 360.0f) * PERIOD_COUNTS) & (PERIOD_COUNTS - 1);
+	sync_in.integral = 0;
+	sync_in.phase_error = 0;
+	sync_in.edges_in_lock_window = 0;
+	
+	output.phase_increment = sync_in.nominal_phase_increment;            //drop any trim left over from the last lock
+	if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		arm_DAC_table_swap();
+	}
+	
+	if(mode != SYNC_IN_OFF)
+	{
+		READ_SYNC_IN_CAPTURE_STATUS();                                   //don't act on an edge from before now
+		START_SYNC_IN_CAPTURE();
+	}
 }
 
-void shunt_output_stage(output_stage_selection_type output_stage)
+void set_sync_out_enabled(bool enable_sync_out)
 {
-	uint32_t IO_line_state = (LV_OUTPUT_SHUNT_ENABLE | HV_OUTPUT_SHUNT_ENABLE);     //default to shunt both unless otherwise told
-	uint32_t IO_line_mask = (LV_OUTPUT_SHUNT_MASK | HV_OUTPUT_SHUNT_MASK);
+	output.sync_out_mask = enable_sync_out ? SYNC_OUT_BIT : 0;
+}
+
+bool is_sync_in_locked(void)
+{
+	return((sync_in.mode != SYNC_IN_OFF) && (sync_in.edges_in_lock_window >= SYNC_IN_LOCK_EDGES));
+}
+
+float get_sync_in_phase_error(void)
+{
+	return(((float)sync_in.phase_error * 360.0f) / (float)PERIOD_COUNTS);
+}
+
+void service_sync_in(void)
+{
+	bool is_locked = is_sync_in_locked();
 	
-	if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+	//The report goes out over LSCP, which mallocs, so it can't be sent from the ISR
+	if(is_locked != sync_in.was_locked)
 	{
-		IO_line_state = LV_OUTPUT_SHUNT_ENABLE;
-		IO_line_mask = LV_OUTPUT_SHUNT_MASK;
+		sync_in.was_locked = is_locked;
+		execute_sync_lock_change_sequence();
 	}
-	else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+}
+
+/**
+ * @brief Works out the phase lock loop gains for the present frequency. The loop runs once per reference edge, and a trim of
+ * one increment count moves the phase by samples_per_cycle counts over the next edge, so the gains are scaled by 1/samples_per_cycle.
+ * That leaves a loop that corrects 1/SYNC_IN_PROPORTIONAL_PERIODS of the error per edge, with a slower integral taking out
+ * the frequency offset between the two clocks, at any output frequency.
+ * 
+ * @return void
+ */
+static void update_sync_in_loop_gains(void)
+{
+	float samples_per_cycle;
+	
+	sync_in.nominal_phase_increment = output.requested_phase_increment.integer;
+	
+	if(sync_in.nominal_phase_increment == 0)
 	{
-		IO_line_state = HV_OUTPUT_SHUNT_ENABLE;
-		IO_line_mask = HV_OUTPUT_SHUNT_MASK;
+		sync_in.proportional_gain = 0;
+		sync_in.integral_gain = 0;
+		sync_in.integral_limit = 0;
+	}
+	else
+	{
+		samples_per_cycle = (float)PERIOD_COUNTS / (float)sync_in.nominal_phase_increment;
+		sync_in.proportional_gain = 1.0f / (samples_per_cycle * SYNC_IN_PROPORTIONAL_PERIODS);
+		sync_in.integral_gain = 1.0f / (samples_per_cycle * SYNC_IN_INTEGRAL_PERIODS);
+		sync_in.integral_limit = (float)sync_in.nominal_phase_increment * SYNC_IN_MAXIMUM_TRIM;
 	}
 	
-	set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
+	sync_in.integral = 0;
 }
 
-void unshunt_output_stage(output_stage_selection_type output_stage)
+/**
+ * @brief Sync in capture ISR
+ * 
+ * Fires on each rising edge of the reference. The capture register holds when the edge came in, so the DDS phase at that
+ * instant is worked back from the phase now, the sample timer count, and how long ago the capture was. The difference from
+ * lock_phase is the phase error, which is either trimmed out of the phase increment by a PI loop (SYNC_IN_PHASE_LOCK) or
+ * taken straight off the accumulator (SYNC_IN_RESET). The reference is expected at the output frequency.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+void SYNC_IN_CAPTURE_ISR()
 {
-	uint32_t IO_line_state = 0;
-	uint32_t IO_line_mask = 0;
+	uint32_t sample_timer_count;
+	uint16_t sync_in_timer_count;
+	uint16_t capture_count;
+	unsigned int phase_accumulator;
+	unsigned int phase_at_edge;
+	int32_t counts_since_edge;
+	int32_t phase_error;
+	float trim;
 	
-	if(output_stage != OUTSTG_SEL_BOTH)
+	if(!(READ_SYNC_IN_CAPTURE_STATUS() & TC_SR_LDRAS))
 	{
-		if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
-		{
-			IO_line_state = LV_OUTPUT_SHUNT_DISABLE;
-			IO_line_mask = LV_OUTPUT_SHUNT_MASK;
-		}
-		else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+		return;
+	}
+	
+	PROFILE_BEGIN(PROFILE_PROBE_SYNC_IN_ISR);
+	capture_count = (uint16_t)READ_SYNC_IN_CAPTURE();
+	
+	if(!output.DC_ramp.is_waveform_running)
+	{
+		PROFILE_END(PROFILE_PROBE_SYNC_IN_ISR);
+		return;                                                     //DC, or nothing started yet. The accumulator isn't stepping, so there's no phase to lock.
+	}
+	
+	//Read the phase and both counts together. Right after an RC compare, the sample ISR may still be pending behind the mask,
+	//so the count has restarted but the accumulator hasn't stepped. Take the step it's about to make rather than wait for it.
+	MASK_ALL_INTERRUPTS();
+	sample_timer_count = READ_SAMPLE_TIMER_COUNT();
+	sync_in_timer_count = (uint16_t)READ_SYNC_IN_TIMER_COUNT();
+	phase_accumulator = output.phase_accumulator;
+	if(IS_OUTPUT_UPDATE_TIMER_ISR_PENDING() && (output.burst_samples_remaining != 0))
+	{
+		phase_accumulator += output.phase_increment;
+	}
+	UNMASK_INTERRUPTS();
+	
+	counts_since_edge = (int32_t)sample_timer_count - ((int32_t)(uint16_t)(sync_in_timer_count - capture_count) * SYNC_IN_CAPTURE_PRESCALER);     //MCK counts, edge relative to the last sample
+	phase_at_edge = phase_accumulator + (unsigned int)(((int64_t)counts_since_edge * output.phase_increment) / (int64_t)READ_SAMPLE_TIMER_PERIOD());
+	phase_error = (int32_t)((phase_at_edge - (sync_in.lock_phase + output.phase_offset)) << (32 - (SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS))) >> (32 - (SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS));  //+/- half a cycle
+	
+	sync_in.phase_error = phase_error;
+	
+	if((phase_error < SYNC_IN_LOCK_WINDOW) && (phase_error > -SYNC_IN_LOCK_WINDOW))
+	{
+		if(sync_in.edges_in_lock_window < SYNC_IN_LOCK_EDGES)
 		{
-			IO_line_state = HV_OUTPUT_SHUNT_DISABLE;
-			IO_line_mask = HV_OUTPUT_SHUNT_MASK;
+			sync_in.edges_in_lock_window++;
 		}
-		
-		set_HW_configuration_lines(IO_PORT, IO_line_mask, IO_line_state);
 	}
-}
-
-void connect_output_stage_to_output_terminals(output_stage_selection_type output_stage)
-{
-	uint32_t IO_line_state = 0xFFFFFFFF;                            //init to safe state for IO lines in case of "output_stage" being corrupt
+	else
+	{
+		sync_in.edges_in_lock_window = 0;
+	}
 	
-	if(output_stage != OUTSTG_SEL_BOTH)
+	if(frequency_sweep.is_running || (output.burst_sample_decrement != 0))
 	{
-		if(output_stage == OUTSTG_SEL_LOW_VOLTAGE)
+		PROFILE_END(PROFILE_PROBE_SYNC_IN_ISR);
+		return;                                                     //sweeps and bursts own the phase. Just measure.
+	}
+	
+	if(sync_in.mode == SYNC_IN_RESET)
+	{
+		MASK_ALL_INTERRUPTS();
+		output.phase_accumulator -= (unsigned int)phase_error;                         //relative, so samples taken since the edge aren't lost
+		UNMASK_INTERRUPTS();
+	}
+	else
+	{
+		sync_in.integral += sync_in.integral_gain * (float)phase_error;
+		if(sync_in.integral > sync_in.integral_limit)
 		{
-			IO_line_state = OUTSTG_SEL_LV;
+			sync_in.integral = sync_in.integral_limit;
 		}
-		else if(output_stage == OUTSTG_SEL_HIGH_VOLTAGE)
+		else if(sync_in.integral < -sync_in.integral_limit)
 		{
-			IO_line_state = OUTSTG_SEL_HV;
+			sync_in.integral = -sync_in.integral_limit;
 		}
 		
-		set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, OUTSTG_SEL_MASK, IO_line_state);
+		trim = sync_in.integral + (sync_in.proportional_gain * (float)phase_error);
+		if(trim > sync_in.integral_limit)
+		{
+			trim = sync_in.integral_limit;
+		}
+		else if(trim < -sync_in.integral_limit)
+		{
+			trim = -sync_in.integral_limit;
+		}
+		
+		output.phase_increment = (unsigned int)((int32_t)sync_in.nominal_phase_increment - (int32_t)trim);   //running ahead of the reference slows the output down
+	}
+	
+	if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+	{
+		arm_DAC_table_swap();                                       //the accumulator or increment just moved
 	}
 	
+	PROFILE_END(PROFILE_PROBE_SYNC_IN_ISR);
 }
 
-void disable_output_terminals(void)
+#pragma endregion "Sync Functions"
+
+#pragma region "Sample Overrun Detection Functions"
+void set_sample_overrun_notify_enabled(bool notify_enabled)
 {
-	set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, OUTSTG_SEL_MASK, OUTSTG_SEL_OPEN);
+	MASK_ALL_INTERRUPTS();
+	output.sample_overrun.late_samples = 0;
+	output.sample_overrun.overlapped_samples = 0;
+	output.sample_overrun.worst_latency_counts = 0;
+	output.sample_overrun.is_report_pending = false;
+	output.sample_overrun.is_notify_armed = notify_enabled;
+	UNMASK_INTERRUPTS();
 }
 
-void select_front_or_rear_output_terminals(terminal_selection_type terminal_selection)
+void get_sample_overrun_status(sample_overrun_status_type *status)
 {
-	uint32_t IO_line_state = 0XFFFFFFFF;                            //init to safe state for IO lines in case of "terminal_selection" being corrupt
+	uint32_t worst_latency_counts;
+	uint32_t late_threshold_counts;
 	
-	if(terminal_selection == TERMINALS_FRONT)
+	MASK_ALL_INTERRUPTS();
+	status->late_samples = output.sample_overrun.late_samples;
+	status->overlapped_samples = output.sample_overrun.overlapped_samples;
+	worst_latency_counts = output.sample_overrun.worst_latency_counts;
+	late_threshold_counts = output.sample_overrun.late_threshold_counts;
+	UNMASK_INTERRUPTS();
+	
+	status->worst_latency = (float)worst_latency_counts / SystemCoreClock;
+	status->latency_budget = (float)late_threshold_counts / SystemCoreClock;
+#if DAC_BLOCK_STREAMING_ENABLED
+	status->stream_frame_error = (float)output.sample_overrun.stream_frame_error_counts / SystemCoreClock;
+#else
+	status->stream_frame_error = 0;
+#endif
+}
+
+void service_sample_overrun(void)
+{
+	//The report goes out over LSCP, which mallocs, so it can't be sent from the ISR
+	if(output.sample_overrun.is_report_pending)
 	{
-		IO_line_state = FRONT_REAR_TERM_FRONT_SEL;
+		output.sample_overrun.is_report_pending = false;
+		execute_sample_overrun_sequence();
 	}
-	else if(terminal_selection == TERMINALS_REAR)
+}
+
+/**
+ * @brief Works out the latest sample timer count the ISR can start at and still have its frame shifted into the
+ * AD5791 before RA drops LDAC. Any later and the DAC latches the previous frame again.
+ * 
+ * @param sample_timer_RA RA at the sample rate the threshold is for
+ * 
+ * @return uint32_t sample timer counts after the RC compare, 0 if the frame can't make it at all
+ */
+static uint32_t get_sample_late_threshold_counts(uint32_t sample_timer_RA)
+{
+	uint32_t frame_busy_counts = get_DAC_SPI_frame_busy_clocks();
+	
+	return((sample_timer_RA > frame_busy_counts) ? (sample_timer_RA - frame_busy_counts) : 0);
+}
+#pragma endregion "Sample Overrun Detection Functions"
+
+#pragma region "Frequency Sweep Functions"
+
+void start_frequency_sweep(float start_frequency, float stop_frequency, float duration, sweep_law_type law, uint32_t number_of_steps)
+{
+	uint32_t number_of_ticks = (uint32_t)(duration * WAVEFORM_CONTROL_TIMER_FREQUENCY);
+	uint32_t sample_rate_shift;
+	float sampling_frequency;
+	rational_phase_increment_type start_phase_increment;
+	
+	stop_frequency_sweep();
+	
+	if(number_of_ticks == 0)
 	{
-		IO_line_state = FRONT_REAR_TERM_REAR_SEL;
+		number_of_ticks = 1;
 	}
 	
-	set_HW_configuration_lines(OUT_TERMINAL_SEL_IO_PORT, FRONT_REAR_TERM_MASK, IO_line_state);
+	if((number_of_steps == 0) || (number_of_steps > number_of_ticks))
+	{
+		number_of_steps = number_of_ticks;                                              //continuous chirp, a new frequency every tick
+	}
 	
+	//the whole sweep runs at the sample rate of its highest frequency, so the ISR only ever has to step the increment
+	sample_rate_shift = get_sample_rate_shift((start_frequency > stop_frequency) ? start_frequency : stop_frequency);
+	sampling_frequency = OUTPUT_SAMPLING_FREQUENCY / (float)(1u << sample_rate_shift);
+	
+	frequency_sweep.law = law;
+	frequency_sweep.start_phase_increment = ((float)PERIOD_COUNTS * start_frequency) / sampling_frequency;
+	frequency_sweep.stop_phase_increment = ((float)PERIOD_COUNTS * stop_frequency) / sampling_frequency;
+	frequency_sweep.exact_stop_phase_increment = get_rational_phase_increment(stop_frequency, sampling_frequency);
+	frequency_sweep.log_ratio_per_step = logf(stop_frequency / start_frequency) / (float)number_of_steps;
+	frequency_sweep.number_of_steps = number_of_steps;
+	frequency_sweep.ticks_per_step = number_of_ticks / number_of_steps;
+	frequency_sweep.ticks_per_step_remainder = number_of_ticks % number_of_steps;
+	frequency_sweep.step_tick_fraction = 0;
+	frequency_sweep.ticks_in_step = get_frequency_sweep_step_ticks();
+	frequency_sweep.step = 0;
+	frequency_sweep.tick_in_step = 0;
+	frequency_sweep.ticks_since_progress_report = 0;
+	frequency_sweep.is_progress_report_pending = false;
+	frequency_sweep.is_completion_report_pending = false;
+	
+	start_phase_increment.integer = get_frequency_sweep_step_phase_increment(0);
+	start_phase_increment.remainder = 0;                                                //sweep steps are whole counts
+	start_phase_increment.modulus = 1;
+	request_output_phase_increment(start_phase_increment, sample_rate_shift, false);
+	frequency_sweep.is_running = true;
+	START_WAVEFORM_CONTROL_TIMER();
 }
 
-#pragma endregion "Output Stage Hardware Manipulation Functions"
+void stop_frequency_sweep(void)
+{
+	STOP_WAVEFORM_CONTROL_TIMER();
+	frequency_sweep.is_running = false;
+}
 
-#pragma region "Output Waveform Functions"
+bool is_frequency_sweep_running(void)
+{
+	return(frequency_sweep.is_running);
+}
 
-void set_output_frequency(float desired_output_frequency)
+float get_frequency_sweep_progress(void)
 {
-    output.phase_increment = get_phase_increment(desired_output_frequency, OUTPUT_SAMPLING_FREQUENCY);
+	return((float)frequency_sweep.step / (float)frequency_sweep.number_of_steps);
 }
 
-void set_output_shape(output_shape_type desired_output_shape, float amplitude, float offset, float full_scale_divisor)
+float get_frequency_sweep_present_frequency(void)
 {
-    if(presently_selected_output_stage == OUTSTG_SEL_LOW_VOLTAGE)
-    {
-        amplitude = -amplitude;
-        offset = -offset;        
-    }
-    
-    if(desired_output_shape == SHAPE_DC)
-    {
-        //HAS_RC_COMPARED_SINCE_LAST_STAUS_REG_READ();
-        //while(!HAS_RC_COMPARED_SINCE_LAST_STAUS_REG_READ());   //this assumes the timer is actively firing, probably won't work on power up and transition to enabled output
-        DISABLE_TIMER_CLOCK();
-        DISABLE_TIMER_INTERRUPT();        
-        update_DAC_output_while_in_DC_mode(amplitude, full_scale_divisor);        
-    }
-    else if(desired_output_shape == SHAPE_SINE)
-    {
-        generate_DAC_code_table(amplitude, offset, full_scale_divisor);
-        DISABLE_TIMER_CLOCK_DISABLE_ON_RC_COMPARE();
-        ENABLE_TIMER_INTERRUPT();
-        ENABLE_TIMER_CLOCK();
-        ISSUE_TIMER_SW_TRIGGER();       
-    }    
-}    
+	return(((float)output.phase_increment * get_output_sampling_frequency()) / (float)PERIOD_COUNTS);
+}
+
+void service_frequency_sweep(void)
+{
+	//The reports go out over LSCP, which mallocs, so they can't be sent from the ISR
+	if(frequency_sweep.is_completion_report_pending)
+	{
+		frequency_sweep.is_completion_report_pending = false;
+		frequency_sweep.is_progress_report_pending = false;
+		execute_frequency_sweep_complete_sequence();
+	}
+	else if(frequency_sweep.is_progress_report_pending)
+	{
+		frequency_sweep.is_progress_report_pending = false;
+		execute_frequency_sweep_progress_sequence();
+	}
+	
+	//Track the droop as the sweep moves. Waiting for each table to be adopted before starting the next keeps a fast chirp from restarting the fill forever.
+	if(frequency_sweep.is_running && !is_DAC_code_table_generation_pending())
+	{
+		update_amplitude_frequency_compensation(get_frequency_sweep_present_frequency(), get_output_sampling_frequency());
+	}
+}
+
+/**
+ * @brief Works out the phase increment of one sweep step. Each step is computed from the start, rather than accumulated
+ * from the step before, so float rounding can't build up over a long sweep.
+ * 
+ * @param step sweep step, 0 to number_of_steps - 1. The last step uses exact_stop_phase_increment instead.
+ * 
+ * @return unsigned int phase increment for that step
+ */
+static unsigned int get_frequency_sweep_step_phase_increment(uint32_t step)
+{
+	float phase_increment;
+	
+	if(frequency_sweep.law == SWEEP_LAW_LOGARITHMIC)
+	{
+		phase_increment = frequency_sweep.start_phase_increment * expf(frequency_sweep.log_ratio_per_step * (float)step);
+	}
+	else
+	{
+		phase_increment = frequency_sweep.start_phase_increment + (((frequency_sweep.stop_phase_increment - frequency_sweep.start_phase_increment) * (float)step) / (float)frequency_sweep.number_of_steps);
+	}
+	
+	return((unsigned int)phase_increment);
+}
+
+/**
+ * @brief Works out how many ticks the next sweep step lasts. The remainder of number_of_ticks / number_of_steps is carried
+ * Bresenham style, so some steps get an extra tick and all of them add up to exactly the sweep's duration.
+ * 
+ * @return uint32_t ticks, ticks_per_step or one more
+ */
+static inline uint32_t get_frequency_sweep_step_ticks(void)
+{
+	frequency_sweep.step_tick_fraction += frequency_sweep.ticks_per_step_remainder;
+	
+	if(frequency_sweep.step_tick_fraction >= frequency_sweep.number_of_steps)
+	{
+		frequency_sweep.step_tick_fraction -= frequency_sweep.number_of_steps;
+		return(frequency_sweep.ticks_per_step + 1);
+	}
+	
+	return(frequency_sweep.ticks_per_step);
+}
+
+/**
+ * @brief Waveform control timer ISR
+ * 
+ * Fires at WAVEFORM_CONTROL_TIMER_FREQUENCY while a sweep is running and steps the phase increment on a deterministic tick.
+ * Changing only the increment keeps the output phase continuous. This runs at a lower priority than the sample ISR.
+ * Ticks don't count until any sample rate change the sweep started with has been taken up by the sample ISR, or that
+ * would overwrite the first steps. The last step leaves the output as request_output_phase_increment() would, burst
+ * length and sync in loop gains included, so neither snaps back to the start frequency's.
+ * 
+ * @param none
+ * 
+ * @return void
+ */
+void WAVEFORM_CONTROL_TIMER_ISR()
+{
+	PROFILE_BEGIN(PROFILE_PROBE_SWEEP_ISR);
+	
+	CLEAR_WAVEFORM_CONTROL_TIMER_FLAG();
+	
+	if(frequency_sweep.is_running && !output.is_sample_rate_change_pending)      //the sweep's first increment waits on its sample rate, so the steps do too
+	{
+		frequency_sweep.ticks_since_progress_report++;
+		frequency_sweep.tick_in_step++;
+		
+		if(frequency_sweep.tick_in_step >= frequency_sweep.ticks_in_step)
+		{
+			frequency_sweep.tick_in_step = 0;
+			frequency_sweep.ticks_in_step = get_frequency_sweep_step_ticks();
+			frequency_sweep.step++;
+			
+			if(frequency_sweep.step >= frequency_sweep.number_of_steps)
+			{
+				MASK_ALL_INTERRUPTS();
+				output.phase_modulus = frequency_sweep.exact_stop_phase_increment.modulus;
+				output.phase_increment_remainder = frequency_sweep.exact_stop_phase_increment.remainder;
+				output.phase_increment = frequency_sweep.exact_stop_phase_increment.integer;
+				output.phase_fraction = 0;
+				UNMASK_INTERRUPTS();
+				output.requested_phase_increment = frequency_sweep.exact_stop_phase_increment;
+				output.burst_samples = get_burst_samples(output.requested_phase_increment, output.burst_cycles);
+				update_sync_in_loop_gains();                        //before is_running drops, which lets the sync in loop steer the increment again
+			}
+			else
+			{
+				output.phase_increment = get_frequency_sweep_step_phase_increment(frequency_sweep.step);
+			}
+			
+			if(output.DAC_table_generation.state == DAC_TABLE_GENERATION_SWAP_PENDING)
+			{
+				arm_DAC_table_swap();                               //the armed accumulator value won't be hit at the new increment
+			}
+			
+			if(frequency_sweep.step >= frequency_sweep.number_of_steps)
+			{
+				frequency_sweep.is_running = false;
+				frequency_sweep.is_completion_report_pending = true;
+				STOP_WAVEFORM_CONTROL_TIMER();
+			}
+		}
+		
+		if(frequency_sweep.ticks_since_progress_report >= FREQUENCY_SWEEP_PROGRESS_REPORT_TICKS)
+		{
+			frequency_sweep.ticks_since_progress_report = 0;
+			frequency_sweep.is_progress_report_pending = true;
+		}
+	}
+	
+	PROFILE_END(PROFILE_PROBE_SWEEP_ISR);
+}
 
-#pragma endregion "Output Waveform Functions"
\ No newline at end of file
+#pragma endregion "Frequency Sweep Functions"
\ No newline at end of file
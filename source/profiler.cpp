@@ -0,0 +1,133 @@
+/** @file profiler.cpp
+ *  @brief Implementation file for the prototypes declared in the profiler.h interface module.
+ *
+ *  @author Adam Porsch & Houston Fortney
+ *  @bug No known bugs.
+ */
+
+#include "HAL.h"
+#include "profiler.h"
+#include <string.h>
+
+#pragma region "defintions and variables restricted to the scope of this module"
+
+const char *profile_probe_names[NUMBER_OF_PROFILE_PROBES] =
+{
+	"SampleIsr",
+	"StreamBlockIsr",
+	"SyncInIsr",
+	"SweepIsr",
+	"DacTableGeneration",
+	"LscpProcessing",
+	"RangeChange",
+	"OutputEnable"
+};
+
+struct profiler_data
+{
+	profile_probe_data_type probes[NUMBER_OF_PROFILE_PROBES];
+	uint32_t overhead_cycles;                               //what an empty PROFILE_BEGIN()/PROFILE_END() pair measures
+};
+
+struct profiler_data profiler;
+
+static void reset_profile_probe(profile_probe_type probe);
+
+#pragma endregion "defintions and variables restricted to the scope of this module"
+
+#pragma region "Profiler Functions"
+
+void init_profiler(void)
+{
+	uint32_t i;
+	uint32_t start_cycles;
+
+	ENABLE_CYCLE_COUNTER();
+
+	for(i = 0; i < NUMBER_OF_PROFILE_PROBES; i++)
+	{
+		reset_profile_probe((profile_probe_type)i);
+	}
+
+	start_cycles = get_profile_cycle_count();
+	profiler.overhead_cycles = get_profile_cycle_count() - start_cycles;
+}
+
+__attribute__ ((section(".ramfunc")))
+uint32_t get_profile_cycle_count(void)
+{
+	return(READ_CYCLE_COUNT());
+}
+
+__attribute__ ((section(".ramfunc")))
+void record_profile_sample(profile_probe_type probe, uint32_t cycles)
+{
+	profile_probe_data_type *probe_data = &profiler.probes[probe];
+	uint32_t bin;
+
+	cycles = (cycles > profiler.overhead_cycles) ? (cycles - profiler.overhead_cycles) : 0;
+	bin = 31 - __CLZ(cycles | 1);                           //log2, with 0 cycles landing in bin 0
+
+	if(bin >= PROFILE_HISTOGRAM_BINS)
+	{
+		bin = PROFILE_HISTOGRAM_BINS - 1;
+	}
+
+	if(cycles < probe_data->minimum_cycles)
+	{
+		probe_data->minimum_cycles = cycles;
+	}
+
+	if(cycles > probe_data->maximum_cycles)
+	{
+		probe_data->maximum_cycles = cycles;
+	}
+
+	probe_data->total_cycles += cycles;
+	probe_data->histogram[bin]++;
+	probe_data->count++;
+}
+
+void get_profile_probe_data(profile_probe_type probe, profile_probe_data_type *probe_data, bool reset)
+{
+	if(probe >= NUMBER_OF_PROFILE_PROBES)
+	{
+		memset(probe_data, 0, sizeof(profile_probe_data_type));
+		return;
+	}
+
+	//The ISR probes can land part way through a copy, so hold them off for it
+	MASK_ALL_INTERRUPTS();
+	*probe_data = profiler.probes[probe];
+
+	if(reset)
+	{
+		reset_profile_probe(probe);
+	}
+	UNMASK_INTERRUPTS();
+}
+
+const char *get_profile_probe_name(profile_probe_type probe)
+{
+	if(probe >= NUMBER_OF_PROFILE_PROBES)
+	{
+		return("");
+	}
+
+	return(profile_probe_names[probe]);
+}
+
+/**
+ * @brief Clears a probe's counters. Callers hold off interrupts if the probe could be recorded meanwhile.
+ *
+ * @param probe which probe
+ *
+ * @return void
+ */
+static void reset_profile_probe(profile_probe_type probe)
+{
+	memset(&profiler.probes[probe], 0, sizeof(profile_probe_data_type));
+	profiler.probes[probe].minimum_cycles = UINT32_MAX;
+}
+
+#pragma endregion "Profiler Functions"
@@ -20,16 +20,19 @@
  *  @bug No known bugs.
  */
 
-#include "hal.h"
+#include "HAL.h"
 #include "settings_manager.h"
 #include "output_control.h"
 #include "sources_settings_callbacks.h"
 #include "android_comm_interface_manager.h"
+#include "profiler.h"
 
 settings_type settings;
 settings_type *settings_ptr;                    //TODO: REMOVE. HERE TO GET MEM ADDR OF STUCT TO SHOW UP IN IDE WINDOW
 
 bool start_command_received = false;			//Used for power up. Don't apply any hardware settings until .NET code gives us the green light by sending the "start" command.
+const char *pending_output_level_notification = NULL;	//Level setting to notify the android of once its new DAC code table is live. NULL if none.
+uint32_t ARB_data_points_loaded = 0;					//ARB waveform points received so far. ARB_WAVEFORM_POINTS = complete.
 
 
 #pragma region "setting initialization functions"
@@ -40,6 +43,21 @@ void load_settings_struct_with_default_values(void)
     settings.output_state_enabled = false;                  //LV and HV OUTSTAGESEL = 1 (neither one is fed to terminals)
     settings.calibration_locked = true;                     //WP pin is high
     settings.output_frequency = 0;
+    settings.phase.phase = 0;
+    settings.phase.reset_on_frequency_change = false;
+    settings.frequency_sweep.start_frequency = MINIMUM_FREQUENCY_IN_HZ;
+    settings.frequency_sweep.stop_frequency = MAXIMUM_FREQUENCY_IN_HZ;
+    settings.frequency_sweep.duration = 1.0;
+    settings.frequency_sweep.law = SWEEP_LAW_LOGARITHMIC;
+    settings.frequency_sweep.steps = 0;
+    settings.frequency_sweep.enabled = false;
+    settings.burst.enabled = false;
+    settings.burst.cycles = 1;
+    settings.burst.start_phase = 0;
+    settings.burst.trigger_source = BURST_TRIGGER_SOFTWARE;
+    settings.sync.sync_in_mode = SYNC_IN_OFF;
+    settings.sync.lock_phase = 0;
+    settings.sync.sync_out_enabled = false;
     settings.output_shape = SHAPE_DC;
     settings.voltage_range = VRANGE_10mV;                   //b/c U24 inputs are 0b11
     settings.voltage_autorange_enabled = false;             //TODO: verify this is what .NET defaults to.
@@ -47,6 +65,10 @@ void load_settings_struct_with_default_values(void)
     settings.output_voltage_level.offset = 0;       
     settings.output_current_level.amplitude = 0;         
     settings.output_current_level.offset = 0;
+    settings.DC_slew_rate.voltage = 0;
+    settings.DC_slew_rate.current = 0;
+    settings.DC_high_resolution_enabled = false;
+    settings.sample_overrun_notify_enabled = false;
     settings.current_range = IRANGE_1uA;                    //Technically, I range is n/a since none of the relays are engaged
     settings.current_autorange_enabled = false;
     settings.current_compliance_range = I_COMPLIANCE_10V;   //No 1:1, both LV U29 and HV U14 are "disabled" (DAC in grounded)
@@ -128,6 +150,7 @@ void execute_enable_output_sequence(void)
 {
     void (*current_range_function_ptr)(current_range_type);
     output_stage_selection_type output_stage_selection = OUTSTG_SEL_LOW_VOLTAGE;
+    PROFILE_BEGIN(PROFILE_PROBE_OUTPUT_ENABLE);
     
     current_range_function_ptr = &set_low_voltage_current_range_HW;         //default to low voltage stage to be safe    
     
@@ -181,6 +204,7 @@ void execute_enable_output_sequence(void)
     unshunt_output_stage(output_stage_selection);
     execute_output_shape_change_sequence();             //will apply frequency, output levels, DC vs Sine shape, 
     
+    PROFILE_END(PROFILE_PROBE_OUTPUT_ENABLE);
 }
 
 float get_full_scale_voltage_range_value(voltage_range_type voltage_range)
@@ -249,6 +273,58 @@ float get_full_scale_current_range_value(current_range_type current_range)
     return(fs_range_value);
 }
 
+void execute_DAC_code_table_update_complete_sequence(void)
+{
+    //Output control calls this once a level change's DAC code table is live on the output. If the application asked for
+    //the android to be notified of that level change, it's done now rather than while the old level is still being output.
+    if(pending_output_level_notification != NULL)
+    {
+        generate_local_setting_message(pending_output_level_notification);
+        pending_output_level_notification = NULL;
+    }
+}
+
+void execute_DAC_calibration_selection_sequence(void)
+{
+    //Cal points are the 5 voltage ranges, then the current ranges: 1uA to 100mA on the low voltage stage, then 1uA to 10mA on the high voltage stage.
+    uint32_t calibration_point;
+    current_range_type calibration_range = settings.current_range;
+    current_range_type highest_stage_range = IRANGE_100mA;      //the low voltage stage's AC bypass is its 100mA relay setting
+    bool is_high_voltage_stage = (get_presently_selected_output_stage() == OUTSTG_SEL_HIGH_VOLTAGE);
+    
+    if(settings.output_mode == VOLTAGE_MODE)
+    {
+        calibration_point = settings.voltage_range - VRANGE_10mV;
+        select_DAC_calibration(calibration_point, get_full_scale_voltage_range_value(settings.voltage_range));
+    }
+    else
+    {
+        if(is_high_voltage_stage)
+        {
+            highest_stage_range = IRANGE_10mA;                  //no 100mA range, and no cal point for the AC bypass, on the high voltage stage
+        }
+        
+        if((calibration_range < IRANGE_1uA) || (calibration_range > highest_stage_range))
+        {
+            calibration_range = highest_stage_range;            //IRANGE_HV_AC_BYPASS, or a range the stage doesn't have, takes the stage's highest range's cal
+        }
+        
+        calibration_point = NUMBER_OF_VOLTAGE_CAL_POINTS + (calibration_range - IRANGE_1uA);
+        if(is_high_voltage_stage)
+        {
+            calibration_point += (IRANGE_100mA - IRANGE_1uA) + 1;
+        }
+        
+        select_DAC_calibration(calibration_point, get_full_scale_current_range_value(settings.current_range));     //scaled as the output is, for the range it's on
+    }
+}
+
+void execute_trigger_command(void)
+{
+    //Starts a burst. Ignored when not in burst mode, or while a burst is still playing.
+    trigger_burst();
+}
+
 #pragma endregion "general setting manager functionss"
 
 #pragma region "mode setting support functions"
@@ -256,6 +332,7 @@ float get_full_scale_current_range_value(current_range_type current_range)
 void set_mode_setting(output_mode_type validated_mode, setting_android_notify_type notify_android)
 {    
     settings.output_mode = validated_mode;
+    set_DC_slew_rate((validated_mode == CURRENT_MODE) ? settings.DC_slew_rate.current : settings.DC_slew_rate.voltage);
     
     if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
     {
@@ -338,11 +415,23 @@ bool validate_frequency_setting(float pending_frequency)
 
 void set_frequency_setting(float validated_frequency, setting_android_notify_type notify_android)
 {
+    //A fixed frequency overrides a sweep in progress
+    if(settings.frequency_sweep.enabled)
+    {
+        stop_frequency_sweep();
+        settings.frequency_sweep.enabled = false;
+        
+        if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+        {
+            generate_local_setting_message(SETTING_STRING_FREQUENCY_SWEEP);
+        }
+    }
+    
     //if(settings.output_state_enabled && (settings.output_shape == SHAPE_SINE))
     //The phase increment can be updated regardless of shape setting
     set_output_frequency(validated_frequency);
 
-    settings.output_frequency = validated_frequency;
+    settings.output_frequency = (float)get_achieved_output_frequency();        //reported back so the host knows exactly what it got
     
     if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
     {
@@ -356,8 +445,187 @@ float get_working_frequency_setting(void)
 }
 #pragma endregion "frequency setting support functions"
 
+#pragma region "frequency sweep setting support functions"
+bool validate_frequency_sweep_setting(frequency_sweep_type pending_frequency_sweep)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if(validate_frequency_setting(pending_frequency_sweep.start_frequency) && validate_frequency_setting(pending_frequency_sweep.stop_frequency) &&
+       (pending_frequency_sweep.duration >= MINIMUM_FREQUENCY_SWEEP_DURATION_IN_S) && (pending_frequency_sweep.duration <= MAXIMUM_FREQUENCY_SWEEP_DURATION_IN_S) &&
+       simple_validate_setting(pending_frequency_sweep.law, SWEEP_LAW_LINEAR, SWEEP_LAW_LOGARITHMIC))
+    {
+        valid_setting = true;
+    }
+    
+    return(valid_setting);
+}
+
+void set_frequency_sweep_setting(frequency_sweep_type validated_frequency_sweep, setting_android_notify_type notify_android)
+{
+    if(validated_frequency_sweep.enabled)
+    {
+        start_frequency_sweep(validated_frequency_sweep.start_frequency, validated_frequency_sweep.stop_frequency, validated_frequency_sweep.duration,
+                              validated_frequency_sweep.law, validated_frequency_sweep.steps);
+        settings.output_frequency = validated_frequency_sweep.start_frequency;
+    }
+    else if(settings.frequency_sweep.enabled)
+    {
+        stop_frequency_sweep();
+        settings.output_frequency = get_frequency_sweep_present_frequency();       //stays wherever the abort left it
+    }
+    
+    settings.frequency_sweep = validated_frequency_sweep;
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_FREQUENCY_SWEEP);
+    }
+}
+
+frequency_sweep_type get_working_frequency_sweep_setting(void)
+{
+    return(settings.frequency_sweep);
+}
+
+void execute_frequency_sweep_progress_sequence(void)
+{
+    //Output control calls this from the main loop every FREQUENCY_SWEEP_PROGRESS_REPORT_TICKS while a sweep runs
+    generate_local_setting_message(SETTING_STRING_FREQUENCY_SWEEP_STATUS);
+}
+
+void execute_frequency_sweep_complete_sequence(void)
+{
+    //Output control calls this from the main loop once the sweep has landed on its stop frequency
+    settings.frequency_sweep.enabled = false;
+    settings.output_frequency = (float)get_achieved_output_frequency();
+    
+    generate_local_setting_message(SETTING_STRING_FREQUENCY_SWEEP_STATUS);
+    generate_local_setting_message(SETTING_STRING_FREQUENCY_SWEEP);
+    generate_local_setting_message(SETTING_STRING_FREQUENCY);
+}
+#pragma endregion "frequency sweep setting support functions"
+
+#pragma region "phase setting support functions"
+bool validate_phase_setting(phase_type pending_phase)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if((pending_phase.phase >= 0.0f) && (pending_phase.phase < 360.0f))
+    {
+        valid_setting = true;
+    }
+    
+    return(valid_setting);
+}
+
+void set_phase_setting(phase_type validated_phase, setting_android_notify_type notify_android)
+{
+    //The phase steps on its own, whatever the shape or output state
+    set_output_phase(validated_phase.phase, validated_phase.reset_on_frequency_change);
+    
+    settings.phase = validated_phase;
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_PHASE);
+    }
+}
+
+phase_type get_working_phase_setting(void)
+{
+    return(settings.phase);
+}
+#pragma endregion "phase setting support functions"
+
+#pragma region "burst setting support functions"
+bool validate_burst_setting(burst_type pending_burst)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if((pending_burst.cycles >= 1) && (pending_burst.cycles <= MAXIMUM_BURST_CYCLES) &&
+       (pending_burst.start_phase >= 0.0f) && (pending_burst.start_phase < 360.0f) &&
+       simple_validate_setting(pending_burst.trigger_source, BURST_TRIGGER_SOFTWARE, BURST_TRIGGER_EXTERNAL))
+    {
+        valid_setting = true;
+    }
+    
+    return(valid_setting);
+}
+
+void set_burst_setting(burst_type validated_burst, setting_android_notify_type notify_android)
+{
+    //Relays stay as they are. The waveform engine parks and plays the bursts on its own.
+    set_burst_mode(validated_burst.enabled, validated_burst.cycles, validated_burst.start_phase, validated_burst.trigger_source);
+    
+    settings.burst = validated_burst;
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_BURST);
+    }
+}
+
+burst_type get_working_burst_setting(void)
+{
+    return(settings.burst);
+}
+#pragma endregion "burst setting support functions"
+
+#pragma region "sync setting support functions"
+bool validate_sync_setting(sync_type pending_sync)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if(simple_validate_setting(pending_sync.sync_in_mode, SYNC_IN_OFF, SYNC_IN_RESET) &&
+       (pending_sync.lock_phase >= 0.0f) && (pending_sync.lock_phase < 360.0f))
+    {
+        valid_setting = true;
+    }
+    
+    return(valid_setting);
+}
+
+void set_sync_setting(sync_type validated_sync, setting_android_notify_type notify_android)
+{
+    set_sync_in_mode(validated_sync.sync_in_mode, validated_sync.lock_phase);
+    set_sync_out_enabled(validated_sync.sync_out_enabled);
+    
+    settings.sync = validated_sync;
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_SYNC);
+    }
+}
+
+sync_type get_working_sync_setting(void)
+{
+    return(settings.sync);
+}
+
+void execute_sync_lock_change_sequence(void)
+{
+    generate_local_setting_message(SETTING_STRING_SYNC_STATUS);
+}
+#pragma endregion "sync setting support functions"
+
 #pragma region "shape setting support functions"
 
+bool validate_shape_setting(int32_t pending_shape)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if(simple_validate_setting(pending_shape, SHAPE_DC, SHAPE_ARB))
+    {
+        if((pending_shape != SHAPE_ARB) || is_ARB_data_loaded())          //nothing to play until a whole ARB waveform is loaded
+        {
+            valid_setting = true;
+        }
+    }
+    
+    return(valid_setting);
+}
+
 void execute_output_shape_change_sequence(void)
 {
     float amplitude, offset, full_scale_divisor;
@@ -375,6 +643,7 @@ void execute_output_shape_change_sequence(void)
         full_scale_divisor = get_full_scale_current_range_value(settings.current_range);
     }
     
+    execute_DAC_calibration_selection_sequence();          //only rebuilds the coefficients if the range or CalData changed
     set_output_shape(settings.output_shape, amplitude, offset, full_scale_divisor);
 }
 
@@ -400,11 +669,70 @@ output_shape_type get_working_shape_setting(void)
 
 #pragma endregion "shape setting support functions"
 
+#pragma region "ARB data setting support functions"
+
+bool validate_ARB_data_setting(uint32_t first_point, uint32_t number_of_points)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if((number_of_points > 0) && (number_of_points <= ARB_DATA_MAX_POINTS_PER_CHUNK) && ((first_point + number_of_points) <= ARB_WAVEFORM_POINTS))
+    {
+        if((first_point == 0) || (first_point == ARB_data_points_loaded))     //start over, or the next chunk in sequence
+        {
+            valid_setting = true;
+        }
+    }
+    
+    return(valid_setting);
+}
+
+void set_ARB_data_setting(uint32_t first_point, const int16_t *points, uint32_t number_of_points, setting_android_notify_type notify_android)
+{
+    //Chunks go into the ARB upload table, never the live ARB table or the DAC code table the ISR is playing. The upload only
+    //replaces the live waveform with its last chunk, so a level change made mid upload still regenerates the old waveform.
+    load_ARB_waveform_points(first_point, points, number_of_points);
+    ARB_data_points_loaded = first_point + number_of_points;
+    
+    if(is_ARB_data_loaded() && (settings.output_shape == SHAPE_ARB) && (settings.output_state_enabled == true))
+    {
+        //New waveform is complete, put it on the output. The ARB shape is already playing, so it goes in the way a level change
+        //does: filled into the pending table half and swapped in at the swap phase, without stopping and restarting the output.
+        if(settings.output_mode == VOLTAGE_MODE)
+        {
+            set_voltage_level_setting(settings.output_voltage_level, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+        }
+        else
+        {
+            set_current_level_setting(settings.output_current_level, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+        }
+    }
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_ARB_DATA);
+    }
+}
+
+uint32_t get_ARB_data_points_loaded(void)
+{
+    return(ARB_data_points_loaded);
+}
+
+bool is_ARB_data_loaded(void)
+{
+    return(ARB_data_points_loaded == ARB_WAVEFORM_POINTS);
+}
+
+#pragma endregion "ARB data setting support functions"
+
 #pragma region "voltage range setting support functions"
 
 void set_voltage_range_setting(voltage_range_type validated_voltage_range, setting_android_notify_type notify_android)
 {
     output_stage_selection_type desired_output_stage_selection = OUTSTG_SEL_LOW_VOLTAGE;
+    PROFILE_BEGIN(PROFILE_PROBE_RANGE_CHANGE);
+    
+    settings.voltage_range = validated_voltage_range;               //before execute_output_shape_change_sequence(), which scales and calibrates for it
     
     if(settings.output_state_enabled == true && settings.output_mode == VOLTAGE_MODE)
     {
@@ -425,8 +753,7 @@ void set_voltage_range_setting(voltage_range_type validated_voltage_range, setti
         execute_output_shape_change_sequence();											 //will apply frequency, output levels, DC vs Sine shape,          
         connect_output_stage_to_output_terminals(desired_output_stage_selection);        //call needed in case we're switching b/t HV and LV ranges      
     }                  
-	
-	settings.voltage_range = validated_voltage_range;	
+    PROFILE_END(PROFILE_PROBE_RANGE_CHANGE);
 	
 	if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
 	{
@@ -537,13 +864,20 @@ void set_voltage_level_setting(output_level_type validated_voltage_level, settin
         }
         else
         {
-            generate_DAC_code_table(validated_voltage_level.amplitude, validated_voltage_level.offset, get_full_scale_voltage_range_value(settings.voltage_range));
+            request_DAC_code_table_generation(validated_voltage_level.amplitude, validated_voltage_level.offset, get_full_scale_voltage_range_value(settings.voltage_range));
         }
     }    
     
     if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
     {
-        generate_local_setting_message(SETTING_STRING_VOLTAGE_OUTPUT_LEVEL);
+        if(is_DAC_code_table_generation_pending())
+        {
+            pending_output_level_notification = SETTING_STRING_VOLTAGE_OUTPUT_LEVEL;      //sent by execute_DAC_code_table_update_complete_sequence()
+        }
+        else
+        {
+            generate_local_setting_message(SETTING_STRING_VOLTAGE_OUTPUT_LEVEL);
+        }
     }
 }
 
@@ -630,13 +964,20 @@ void set_current_level_setting(output_level_type validated_current_level, settin
         }
         else
         {
-            generate_DAC_code_table(validated_current_level.amplitude, validated_current_level.offset, get_full_scale_current_range_value(settings.current_range));
+            request_DAC_code_table_generation(validated_current_level.amplitude, validated_current_level.offset, get_full_scale_current_range_value(settings.current_range));
         }   
     }   
     
     if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
     {
-        generate_local_setting_message(SETTING_STRING_CURRENT_OUTPUT_LEVEL);
+        if(is_DAC_code_table_generation_pending())
+        {
+            pending_output_level_notification = SETTING_STRING_CURRENT_OUTPUT_LEVEL;      //sent by execute_DAC_code_table_update_complete_sequence()
+        }
+        else
+        {
+            generate_local_setting_message(SETTING_STRING_CURRENT_OUTPUT_LEVEL);
+        }
     }
 }
 
@@ -647,6 +988,98 @@ output_level_type get_working_current_level_setting(void)
 
 #pragma endregion "current level setting support functions"
 
+#pragma region "DC slew rate setting support functions"
+bool validate_DC_slew_rate_setting(DC_slew_rate_type pending_DC_slew_rate)
+{
+    bool valid_setting = false;		//init to fail until proven otherwise
+    
+    if((pending_DC_slew_rate.voltage >= 0.0f) && (pending_DC_slew_rate.voltage <= MAXIMUM_DC_VOLTAGE_SLEW_RATE) &&
+       (pending_DC_slew_rate.current >= 0.0f) && (pending_DC_slew_rate.current <= MAXIMUM_DC_CURRENT_SLEW_RATE))
+    {
+        valid_setting = true;
+    }
+    
+    return(valid_setting);
+}
+
+void set_DC_slew_rate_setting(DC_slew_rate_type validated_DC_slew_rate, setting_android_notify_type notify_android)
+{
+    settings.DC_slew_rate = validated_DC_slew_rate;
+    
+    //Takes effect on the next DC level change. A ramp already running finishes at the old rate.
+    set_DC_slew_rate((settings.output_mode == CURRENT_MODE) ? validated_DC_slew_rate.current : validated_DC_slew_rate.voltage);
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_DC_SLEW_RATE);
+    }
+}
+
+DC_slew_rate_type get_working_DC_slew_rate_setting(void)
+{
+    return(settings.DC_slew_rate);
+}
+
+void execute_DC_ramp_complete_sequence(void)
+{
+    generate_local_setting_message(SETTING_STRING_DC_RAMP_STATUS);
+}
+#pragma endregion "DC slew rate setting support functions"
+
+#pragma region "DC high resolution enabled setting support functions"
+void set_DC_high_resolution_enabled_setting(bool DC_high_resolution_enabled, setting_android_notify_type notify_android)
+{
+    settings.DC_high_resolution_enabled = DC_high_resolution_enabled;
+    set_DC_dither_enabled(DC_high_resolution_enabled);
+    
+    //Put the present level back out so it switches over now rather than at the next level change
+    if(settings.output_state_enabled && (settings.output_shape == SHAPE_DC))
+    {
+        if(settings.output_mode == VOLTAGE_MODE)
+        {
+            set_voltage_level_setting(settings.output_voltage_level, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+        }
+        else
+        {
+            set_current_level_setting(settings.output_current_level, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
+        }
+    }
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_DC_HIGH_RESOLUTION_ENABLED);
+    }
+}
+
+bool is_DC_high_resolution_enabled(void)
+{
+    return(settings.DC_high_resolution_enabled);
+}
+#pragma endregion "DC high resolution enabled setting support functions"
+
+#pragma region "sample overrun setting support functions"
+void set_sample_overrun_notify_enabled_setting(bool sample_overrun_notify_enabled, setting_android_notify_type notify_android)
+{
+    settings.sample_overrun_notify_enabled = sample_overrun_notify_enabled;
+    set_sample_overrun_notify_enabled(sample_overrun_notify_enabled);        //also starts the counts over
+    
+    if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
+    {
+        generate_local_setting_message(SETTING_STRING_SAMPLE_OVERRUN_NOTIFY_ENABLED);
+    }
+}
+
+bool is_sample_overrun_notify_enabled(void)
+{
+    return(settings.sample_overrun_notify_enabled);
+}
+
+void execute_sample_overrun_sequence(void)
+{
+    generate_local_setting_message(SETTING_STRING_SAMPLE_OVERRUN_STATUS);
+}
+#pragma endregion "sample overrun setting support functions"
+
 #pragma region "current range setting support functions"
 bool validate_current_range_setting(int32_t pending_current_range)
 {
@@ -671,9 +1104,12 @@ void set_current_range_setting(current_range_type validated_current_range, setti
 {
     void (*current_range_function_ptr)(current_range_type);
     output_stage_selection_type presently_selected_output_stage;     
+    PROFILE_BEGIN(PROFILE_PROBE_RANGE_CHANGE);
          
     current_range_function_ptr = &set_low_voltage_current_range_HW;         //default to low voltage stage to be safe    
     
+    settings.current_range = validated_current_range;               //before execute_output_shape_change_sequence(), which scales and calibrates for it
+    
     if(settings.output_state_enabled == true && settings.output_mode == CURRENT_MODE)
     {
         bring_DAC_output_to_zero(settings.output_shape);
@@ -690,8 +1126,7 @@ void set_current_range_setting(current_range_type validated_current_range, setti
         unshunt_output_stage(presently_selected_output_stage);    
         execute_output_shape_change_sequence();										 //will apply frequency, output levels, DC vs Sine shape,   
     }        
-    
-	settings.current_range = validated_current_range;
+    PROFILE_END(PROFILE_PROBE_RANGE_CHANGE);
 	
 	if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
 	{
@@ -860,6 +1295,8 @@ calibration_data_type get_calibration_data(void)
 void set_calibraton_data(calibration_data_type incoming_calibration_data, setting_android_notify_type notify_android)
 {
     update_caldata_values_in_RAM(incoming_calibration_data);
+    invalidate_DAC_calibration();
+    execute_DAC_calibration_selection_sequence();          //new coefficients apply from the next level, shape or range change
     
     if(notify_android == NOTIFY_ANDROID_OF_SETTING_CHANGE)
     {
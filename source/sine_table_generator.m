@@ -4,15 +4,16 @@ clear; clc; close all;
 size = 2^12;
 %--------------------------------------------------------------------------
 
-% Generate graph
-x = 1:size;
+% Generate graph (first quadrant only, the firmware mirrors it for the rest of the period)
+quarter_size = size/4;
+x = 1:quarter_size;
 table = sin(2*pi*(x-0.5)/size);
 
 % Print in rows of eight
-for x = 1:(size - 1)
+for x = 1:(quarter_size - 1)
     fprintf('% f, ', table(x));
     if (mod(x,8) == 0)
         fprintf('\n');
     end
 end
-fprintf('% f\n', table(size));
+fprintf('% f\n', table(quarter_size));
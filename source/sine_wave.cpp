@@ -1,13 +1,72 @@
 #include "sine_wave.h"
+#include <math.h>
 
-unsigned int get_phase_increment(float frequency, float sampling_frequency) 
+/**
+ * @brief Splits a positive float into an odd integer mantissa and a power of 2
+ * 
+ * @param value the float, > 0
+ * @param exponent returns the power of 2
+ * 
+ * @return uint32_t odd mantissa, value = mantissa * 2^exponent
+ */
+static uint32_t get_odd_mantissa(float value, int32_t *exponent)
 {
-    return ((unsigned int)(((double)PERIOD_COUNTS*frequency)/sampling_frequency));
+    int binary_exponent;
+    uint32_t mantissa = (uint32_t)ldexpf(frexpf(value, &binary_exponent), 24);      //frexpf gives [0.5, 1), and a float has 24 bits of mantissa
+    
+    *exponent = binary_exponent - 24;
+    while((mantissa != 0) && !(mantissa & 1))
+    {
+        mantissa >>= 1;
+        (*exponent)++;
+    }
+    
+    return(mantissa);
+}
+
+rational_phase_increment_type get_rational_phase_increment(float frequency, float sampling_frequency)
+{
+    rational_phase_increment_type phase_increment;
+    int32_t frequency_exponent, sampling_frequency_exponent;
+    uint64_t frequency_mantissa = get_odd_mantissa(frequency, &frequency_exponent);
+    uint64_t modulus = get_odd_mantissa(sampling_frequency, &sampling_frequency_exponent);
+    int32_t shift = (SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS) + frequency_exponent - sampling_frequency_exponent;    //PERIOD_COUNTS = 2^(SINE_TABLE_BITS + SINE_TABLE_OVERSIZE_BITS)
+    uint64_t numerator;
+    
+    if(shift >= 0)
+    {
+        numerator = frequency_mantissa << shift;                                    //f < fs and the mantissas are 24 bits, so this stays below 2^52
+    }
+    else
+    {
+        while((shift < 0) && ((-shift >= 32) || ((modulus << -shift) > UINT32_MAX)))
+        {
+            frequency_mantissa = (frequency_mantissa + 1) >> 1;                     //only a far out ratio gets here, see the header
+            shift++;
+        }
+        numerator = frequency_mantissa;
+        modulus <<= -shift;
+    }
+    
+    phase_increment.integer = (unsigned int)(numerator / modulus);
+    phase_increment.remainder = (uint32_t)(numerator % modulus);
+    phase_increment.modulus = (uint32_t)modulus;
+    
+    return (phase_increment);
+}
+
+double get_rational_phase_increment_frequency(rational_phase_increment_type phase_increment, float sampling_frequency)
+{
+    return ((((double)phase_increment.integer + ((double)phase_increment.remainder / (double)phase_increment.modulus)) * sampling_frequency) / (double)PERIOD_COUNTS);
 }
 
 //this table was generated from the sine_table_generator.m Matlab script
-//The formula to generate this table is: sine_table[index] = (2 * PI * (index + 0.5) / 4096), where index is defined from 0 to 4095.
-const float sine_table[SINE_TABLE_SIZE] = {
+//The formula to generate this table is: quarter_sine_table[index] = sin(2 * PI * (index + 0.5) / 4096), where index is defined from 0 to 1023.
+//Only the first quadrant is stored; get_sine_table_value() mirrors and negates it to cover the full period.
+#if SINE_TABLE_BITS != 12
+#error "quarter_sine_table below is for SINE_TABLE_BITS 12. Regenerate it with sine_table_generator.m for other sizes."
+#endif
+const float quarter_sine_table[SINE_QUARTER_TABLE_SIZE] = {
     0.000767, 0.002301, 0.003835, 0.005369, 0.006903, 0.008437, 0.009971, 0.011505,
     0.013038, 0.014572, 0.016106, 0.017640, 0.019174, 0.020707, 0.022241, 0.023774,
     0.025308, 0.026841, 0.028375, 0.029908, 0.031441, 0.032975, 0.034508, 0.036041,
@@ -136,388 +195,4 @@ const float sine_table[SINE_TABLE_SIZE] = {
     0.999350, 0.999404, 0.999456, 0.999506, 0.999553, 0.999597, 0.999640, 0.999680,
     0.999717, 0.999753, 0.999786, 0.999816, 0.999844, 0.999870, 0.999894, 0.999915,
     0.999934, 0.999950, 0.999964, 0.999976, 0.999986, 0.999993, 0.999997, 1.000000,
-    1.000000, 0.999997, 0.999993, 0.999986, 0.999976, 0.999964, 0.999950, 0.999934,
-    0.999915, 0.999894, 0.999870, 0.999844, 0.999816, 0.999786, 0.999753, 0.999717,
-    0.999680, 0.999640, 0.999597, 0.999553, 0.999506, 0.999456, 0.999404, 0.999350,
-    0.999294, 0.999235, 0.999174, 0.999110, 0.999045, 0.998976, 0.998906, 0.998833,
-    0.998758, 0.998680, 0.998600, 0.998518, 0.998433, 0.998346, 0.998257, 0.998165,
-    0.998071, 0.997974, 0.997876, 0.997775, 0.997671, 0.997565, 0.997457, 0.997347,
-    0.997234, 0.997119, 0.997001, 0.996881, 0.996759, 0.996634, 0.996507, 0.996378,
-    0.996247, 0.996113, 0.995976, 0.995838, 0.995697, 0.995553, 0.995408, 0.995260,
-    0.995109, 0.994957, 0.994802, 0.994644, 0.994484, 0.994322, 0.994158, 0.993991,
-    0.993822, 0.993651, 0.993477, 0.993301, 0.993122, 0.992942, 0.992759, 0.992573,
-    0.992385, 0.992195, 0.992003, 0.991808, 0.991611, 0.991411, 0.991210, 0.991006,
-    0.990799, 0.990590, 0.990379, 0.990166, 0.989950, 0.989732, 0.989512, 0.989289,
-    0.989064, 0.988836, 0.988607, 0.988374, 0.988140, 0.987903, 0.987664, 0.987423,
-    0.987179, 0.986933, 0.986685, 0.986434, 0.986181, 0.985926, 0.985668, 0.985408,
-    0.985146, 0.984882, 0.984615, 0.984346, 0.984074, 0.983800, 0.983524, 0.983246,
-    0.982965, 0.982682, 0.982396, 0.982109, 0.981819, 0.981526, 0.981232, 0.980935,
-    0.980635, 0.980334, 0.980030, 0.979724, 0.979415, 0.979104, 0.978791, 0.978476,
-    0.978158, 0.977838, 0.977516, 0.977191, 0.976864, 0.976535, 0.976204, 0.975870,
-    0.975534, 0.975195, 0.974855, 0.974512, 0.974166, 0.973819, 0.973469, 0.973117,
-    0.972762, 0.972406, 0.972047, 0.971685, 0.971322, 0.970956, 0.970588, 0.970217,
-    0.969845, 0.969470, 0.969092, 0.968713, 0.968331, 0.967947, 0.967560, 0.967172,
-    0.966781, 0.966387, 0.965992, 0.965594, 0.965194, 0.964792, 0.964387, 0.963980,
-    0.963571, 0.963160, 0.962746, 0.962330, 0.961912, 0.961492, 0.961069, 0.960644,
-    0.960217, 0.959787, 0.959355, 0.958921, 0.958485, 0.958047, 0.957606, 0.957163,
-    0.956717, 0.956270, 0.955820, 0.955368, 0.954914, 0.954457, 0.953998, 0.953537,
-    0.953074, 0.952609, 0.952141, 0.951671, 0.951199, 0.950724, 0.950247, 0.949768,
-    0.949287, 0.948804, 0.948318, 0.947830, 0.947340, 0.946848, 0.946353, 0.945857,
-    0.945358, 0.944856, 0.944353, 0.943847, 0.943339, 0.942829, 0.942317, 0.941802,
-    0.941285, 0.940766, 0.940245, 0.939722, 0.939196, 0.938668, 0.938138, 0.937606,
-    0.937072, 0.936535, 0.935996, 0.935455, 0.934912, 0.934366, 0.933818, 0.933269,
-    0.932716, 0.932162, 0.931606, 0.931047, 0.930486, 0.929923, 0.929358, 0.928791,
-    0.928221, 0.927649, 0.927075, 0.926499, 0.925921, 0.925340, 0.924758, 0.924173,
-    0.923586, 0.922997, 0.922405, 0.921812, 0.921216, 0.920618, 0.920018, 0.919416,
-    0.918811, 0.918205, 0.917596, 0.916985, 0.916372, 0.915757, 0.915140, 0.914520,
-    0.913899, 0.913275, 0.912649, 0.912021, 0.911391, 0.910758, 0.910124, 0.909487,
-    0.908848, 0.908207, 0.907564, 0.906919, 0.906272, 0.905622, 0.904971, 0.904317,
-    0.903661, 0.903003, 0.902343, 0.901681, 0.901016, 0.900350, 0.899681, 0.899011,
-    0.898338, 0.897663, 0.896986, 0.896307, 0.895625, 0.894942, 0.894256, 0.893569,
-    0.892879, 0.892187, 0.891493, 0.890798, 0.890099, 0.889399, 0.888697, 0.887993,
-    0.887286, 0.886578, 0.885867, 0.885154, 0.884439, 0.883723, 0.883004, 0.882283,
-    0.881559, 0.880834, 0.880107, 0.879378, 0.878646, 0.877913, 0.877177, 0.876440,
-    0.875700, 0.874958, 0.874215, 0.873469, 0.872721, 0.871971, 0.871219, 0.870465,
-    0.869709, 0.868951, 0.868190, 0.867428, 0.866664, 0.865898, 0.865129, 0.864359,
-    0.863586, 0.862812, 0.862035, 0.861257, 0.860476, 0.859694, 0.858909, 0.858123,
-    0.857334, 0.856543, 0.855751, 0.854956, 0.854159, 0.853361, 0.852560, 0.851757,
-    0.850953, 0.850146, 0.849337, 0.848526, 0.847714, 0.846899, 0.846082, 0.845264,
-    0.844443, 0.843620, 0.842796, 0.841969, 0.841140, 0.840310, 0.839477, 0.838643,
-    0.837806, 0.836968, 0.836127, 0.835285, 0.834440, 0.833594, 0.832746, 0.831895,
-    0.831043, 0.830189, 0.829333, 0.828475, 0.827615, 0.826753, 0.825889, 0.825023,
-    0.824155, 0.823285, 0.822414, 0.821540, 0.820664, 0.819787, 0.818908, 0.818026,
-    0.817143, 0.816258, 0.815371, 0.814482, 0.813591, 0.812698, 0.811803, 0.810906,
-    0.810008, 0.809107, 0.808205, 0.807300, 0.806394, 0.805486, 0.804576, 0.803664,
-    0.802750, 0.801835, 0.800917, 0.799998, 0.799076, 0.798153, 0.797228, 0.796301,
-    0.795372, 0.794442, 0.793509, 0.792575, 0.791638, 0.790700, 0.789760, 0.788818,
-    0.787874, 0.786929, 0.785981, 0.785032, 0.784081, 0.783128, 0.782173, 0.781216,
-    0.780258, 0.779297, 0.778335, 0.777371, 0.776405, 0.775438, 0.774468, 0.773497,
-    0.772524, 0.771549, 0.770572, 0.769593, 0.768613, 0.767631, 0.766647, 0.765661,
-    0.764673, 0.763684, 0.762693, 0.761700, 0.760705, 0.759708, 0.758710, 0.757710,
-    0.756708, 0.755704, 0.754698, 0.753691, 0.752682, 0.751671, 0.750659, 0.749644,
-    0.748628, 0.747610, 0.746591, 0.745569, 0.744546, 0.743521, 0.742494, 0.741466,
-    0.740436, 0.739404, 0.738370, 0.737335, 0.736298, 0.735259, 0.734218, 0.733176,
-    0.732132, 0.731086, 0.730039, 0.728990, 0.727939, 0.726886, 0.725832, 0.724776,
-    0.723718, 0.722659, 0.721597, 0.720535, 0.719470, 0.718404, 0.717336, 0.716266,
-    0.715195, 0.714122, 0.713047, 0.711971, 0.710893, 0.709813, 0.708732, 0.707649,
-    0.706564, 0.705478, 0.704390, 0.703300, 0.702209, 0.701116, 0.700021, 0.698925,
-    0.697827, 0.696728, 0.695626, 0.694523, 0.693419, 0.692313, 0.691205, 0.690096,
-    0.688985, 0.687872, 0.686758, 0.685642, 0.684525, 0.683406, 0.682285, 0.681163,
-    0.680039, 0.678913, 0.677786, 0.676658, 0.675527, 0.674396, 0.673262, 0.672127,
-    0.670990, 0.669852, 0.668713, 0.667571, 0.666428, 0.665284, 0.664138, 0.662990,
-    0.661841, 0.660690, 0.659538, 0.658384, 0.657229, 0.656072, 0.654913, 0.653753,
-    0.652592, 0.651429, 0.650264, 0.649098, 0.647930, 0.646761, 0.645590, 0.644418,
-    0.643244, 0.642069, 0.640892, 0.639714, 0.638534, 0.637353, 0.636170, 0.634986,
-    0.633800, 0.632613, 0.631424, 0.630234, 0.629042, 0.627849, 0.626654, 0.625458,
-    0.624260, 0.623061, 0.621861, 0.620659, 0.619455, 0.618250, 0.617044, 0.615836,
-    0.614627, 0.613416, 0.612204, 0.610990, 0.609775, 0.608559, 0.607341, 0.606121,
-    0.604900, 0.603678, 0.602455, 0.601230, 0.600003, 0.598775, 0.597546, 0.596315,
-    0.595083, 0.593850, 0.592615, 0.591378, 0.590141, 0.588902, 0.587661, 0.586419,
-    0.585176, 0.583931, 0.582685, 0.581438, 0.580189, 0.578939, 0.577688, 0.576435,
-    0.575181, 0.573925, 0.572669, 0.571410, 0.570151, 0.568890, 0.567628, 0.566364,
-    0.565099, 0.563833, 0.562565, 0.561297, 0.560026, 0.558755, 0.557482, 0.556208,
-    0.554932, 0.553656, 0.552378, 0.551098, 0.549817, 0.548536, 0.547252, 0.545968,
-    0.544682, 0.543395, 0.542106, 0.540817, 0.539526, 0.538234, 0.536940, 0.535645,
-    0.534349, 0.533052, 0.531754, 0.530454, 0.529153, 0.527851, 0.526547, 0.525243,
-    0.523937, 0.522629, 0.521321, 0.520011, 0.518700, 0.517388, 0.516075, 0.514760,
-    0.513445, 0.512128, 0.510810, 0.509490, 0.508170, 0.506848, 0.505525, 0.504201,
-    0.502876, 0.501549, 0.500221, 0.498893, 0.497563, 0.496231, 0.494899, 0.493565,
-    0.492231, 0.490895, 0.489558, 0.488220, 0.486880, 0.485540, 0.484198, 0.482856,
-    0.481512, 0.480167, 0.478821, 0.477473, 0.476125, 0.474775, 0.473425, 0.472073,
-    0.470720, 0.469366, 0.468011, 0.466655, 0.465298, 0.463939, 0.462580, 0.461219,
-    0.459858, 0.458495, 0.457131, 0.455766, 0.454400, 0.453033, 0.451665, 0.450296,
-    0.448926, 0.447555, 0.446183, 0.444809, 0.443435, 0.442059, 0.440683, 0.439305,
-    0.437927, 0.436547, 0.435167, 0.433785, 0.432402, 0.431019, 0.429634, 0.428248,
-    0.426862, 0.425474, 0.424085, 0.422695, 0.421305, 0.419913, 0.418520, 0.417127,
-    0.415732, 0.414336, 0.412940, 0.411542, 0.410144, 0.408744, 0.407344, 0.405942,
-    0.404540, 0.403137, 0.401732, 0.400327, 0.398921, 0.397514, 0.396106, 0.394697,
-    0.393287, 0.391876, 0.390464, 0.389052, 0.387638, 0.386224, 0.384808, 0.383392,
-    0.381975, 0.380557, 0.379138, 0.377718, 0.376297, 0.374875, 0.373453, 0.372029,
-    0.370605, 0.369180, 0.367754, 0.366327, 0.364899, 0.363470, 0.362041, 0.360611,
-    0.359179, 0.357747, 0.356314, 0.354881, 0.353446, 0.352011, 0.350575, 0.349138,
-    0.347700, 0.346261, 0.344821, 0.343381, 0.341940, 0.340498, 0.339055, 0.337612,
-    0.336168, 0.334722, 0.333277, 0.331830, 0.330382, 0.328934, 0.327485, 0.326035,
-    0.324585, 0.323134, 0.321682, 0.320229, 0.318775, 0.317321, 0.315866, 0.314410,
-    0.312953, 0.311496, 0.310038, 0.308579, 0.307120, 0.305660, 0.304199, 0.302737,
-    0.301275, 0.299812, 0.298348, 0.296883, 0.295418, 0.293952, 0.292486, 0.291019,
-    0.289551, 0.288082, 0.286613, 0.285143, 0.283672, 0.282201, 0.280729, 0.279256,
-    0.277783, 0.276309, 0.274834, 0.273359, 0.271883, 0.270407, 0.268930, 0.267452,
-    0.265973, 0.264494, 0.263015, 0.261534, 0.260054, 0.258572, 0.257090, 0.255607,
-    0.254124, 0.252640, 0.251155, 0.249670, 0.248185, 0.246698, 0.245212, 0.243724,
-    0.242236, 0.240748, 0.239258, 0.237769, 0.236278, 0.234788, 0.233296, 0.231804,
-    0.230312, 0.228819, 0.227325, 0.225831, 0.224337, 0.222841, 0.221346, 0.219850,
-    0.218353, 0.216856, 0.215358, 0.213860, 0.212361, 0.210862, 0.209362, 0.207862,
-    0.206361, 0.204860, 0.203358, 0.201856, 0.200353, 0.198850, 0.197347, 0.195843,
-    0.194338, 0.192833, 0.191328, 0.189822, 0.188315, 0.186809, 0.185301, 0.183794,
-    0.182286, 0.180777, 0.179268, 0.177759, 0.176249, 0.174739, 0.173229, 0.171718,
-    0.170206, 0.168694, 0.167182, 0.165670, 0.164157, 0.162643, 0.161129, 0.159615,
-    0.158101, 0.156586, 0.155071, 0.153555, 0.152039, 0.150523, 0.149006, 0.147489,
-    0.145972, 0.144454, 0.142936, 0.141418, 0.139899, 0.138380, 0.136860, 0.135341,
-    0.133821, 0.132300, 0.130780, 0.129259, 0.127737, 0.126216, 0.124694, 0.123172,
-    0.121649, 0.120127, 0.118604, 0.117080, 0.115557, 0.114033, 0.112509, 0.110984,
-    0.109460, 0.107935, 0.106410, 0.104884, 0.103359, 0.101833, 0.100307, 0.098780,
-    0.097254, 0.095727, 0.094200, 0.092673, 0.091145, 0.089617, 0.088090, 0.086561,
-    0.085033, 0.083505, 0.081976, 0.080447, 0.078918, 0.077389, 0.075859, 0.074329,
-    0.072800, 0.071270, 0.069739, 0.068209, 0.066679, 0.065148, 0.063617, 0.062086,
-    0.060555, 0.059024, 0.057493, 0.055961, 0.054429, 0.052898, 0.051366, 0.049834,
-    0.048302, 0.046769, 0.045237, 0.043705, 0.042172, 0.040639, 0.039107, 0.037574,
-    0.036041, 0.034508, 0.032975, 0.031441, 0.029908, 0.028375, 0.026841, 0.025308,
-    0.023774, 0.022241, 0.020707, 0.019174, 0.017640, 0.016106, 0.014572, 0.013038,
-    0.011505, 0.009971, 0.008437, 0.006903, 0.005369, 0.003835, 0.002301, 0.000767,
-    -0.000767, -0.002301, -0.003835, -0.005369, -0.006903, -0.008437, -0.009971, -0.011505,
-    -0.013038, -0.014572, -0.016106, -0.017640, -0.019174, -0.020707, -0.022241, -0.023774,
-    -0.025308, -0.026841, -0.028375, -0.029908, -0.031441, -0.032975, -0.034508, -0.036041,
-    -0.037574, -0.039107, -0.040639, -0.042172, -0.043705, -0.045237, -0.046769, -0.048302,
-    -0.049834, -0.051366, -0.052898, -0.054429, -0.055961, -0.057493, -0.059024, -0.060555,
-    -0.062086, -0.063617, -0.065148, -0.066679, -0.068209, -0.069739, -0.071270, -0.072800,
-    -0.074329, -0.075859, -0.077389, -0.078918, -0.080447, -0.081976, -0.083505, -0.085033,
-    -0.086561, -0.088090, -0.089617, -0.091145, -0.092673, -0.094200, -0.095727, -0.097254,
-    -0.098780, -0.100307, -0.101833, -0.103359, -0.104884, -0.106410, -0.107935, -0.109460,
-    -0.110984, -0.112509, -0.114033, -0.115557, -0.117080, -0.118604, -0.120127, -0.121649,
-    -0.123172, -0.124694, -0.126216, -0.127737, -0.129259, -0.130780, -0.132300, -0.133821,
-    -0.135341, -0.136860, -0.138380, -0.139899, -0.141418, -0.142936, -0.144454, -0.145972,
-    -0.147489, -0.149006, -0.150523, -0.152039, -0.153555, -0.155071, -0.156586, -0.158101,
-    -0.159615, -0.161129, -0.162643, -0.164157, -0.165670, -0.167182, -0.168694, -0.170206,
-    -0.171718, -0.173229, -0.174739, -0.176249, -0.177759, -0.179268, -0.180777, -0.182286,
-    -0.183794, -0.185301, -0.186809, -0.188315, -0.189822, -0.191328, -0.192833, -0.194338,
-    -0.195843, -0.197347, -0.198850, -0.200353, -0.201856, -0.203358, -0.204860, -0.206361,
-    -0.207862, -0.209362, -0.210862, -0.212361, -0.213860, -0.215358, -0.216856, -0.218353,
-    -0.219850, -0.221346, -0.222841, -0.224337, -0.225831, -0.227325, -0.228819, -0.230312,
-    -0.231804, -0.233296, -0.234788, -0.236278, -0.237769, -0.239258, -0.240748, -0.242236,
-    -0.243724, -0.245212, -0.246698, -0.248185, -0.249670, -0.251155, -0.252640, -0.254124,
-    -0.255607, -0.257090, -0.258572, -0.260054, -0.261534, -0.263015, -0.264494, -0.265973,
-    -0.267452, -0.268930, -0.270407, -0.271883, -0.273359, -0.274834, -0.276309, -0.277783,
-    -0.279256, -0.280729, -0.282201, -0.283672, -0.285143, -0.286613, -0.288082, -0.289551,
-    -0.291019, -0.292486, -0.293952, -0.295418, -0.296883, -0.298348, -0.299812, -0.301275,
-    -0.302737, -0.304199, -0.305660, -0.307120, -0.308579, -0.310038, -0.311496, -0.312953,
-    -0.314410, -0.315866, -0.317321, -0.318775, -0.320229, -0.321682, -0.323134, -0.324585,
-    -0.326035, -0.327485, -0.328934, -0.330382, -0.331830, -0.333277, -0.334722, -0.336168,
-    -0.337612, -0.339055, -0.340498, -0.341940, -0.343381, -0.344821, -0.346261, -0.347700,
-    -0.349138, -0.350575, -0.352011, -0.353446, -0.354881, -0.356314, -0.357747, -0.359179,
-    -0.360611, -0.362041, -0.363470, -0.364899, -0.366327, -0.367754, -0.369180, -0.370605,
-    -0.372029, -0.373453, -0.374875, -0.376297, -0.377718, -0.379138, -0.380557, -0.381975,
-    -0.383392, -0.384808, -0.386224, -0.387638, -0.389052, -0.390464, -0.391876, -0.393287,
-    -0.394697, -0.396106, -0.397514, -0.398921, -0.400327, -0.401732, -0.403137, -0.404540,
-    -0.405942, -0.407344, -0.408744, -0.410144, -0.411542, -0.412940, -0.414336, -0.415732,
-    -0.417127, -0.418520, -0.419913, -0.421305, -0.422695, -0.424085, -0.425474, -0.426862,
-    -0.428248, -0.429634, -0.431019, -0.432402, -0.433785, -0.435167, -0.436547, -0.437927,
-    -0.439305, -0.440683, -0.442059, -0.443435, -0.444809, -0.446183, -0.447555, -0.448926,
-    -0.450296, -0.451665, -0.453033, -0.454400, -0.455766, -0.457131, -0.458495, -0.459858,
-    -0.461219, -0.462580, -0.463939, -0.465298, -0.466655, -0.468011, -0.469366, -0.470720,
-    -0.472073, -0.473425, -0.474775, -0.476125, -0.477473, -0.478821, -0.480167, -0.481512,
-    -0.482856, -0.484198, -0.485540, -0.486880, -0.488220, -0.489558, -0.490895, -0.492231,
-    -0.493565, -0.494899, -0.496231, -0.497563, -0.498893, -0.500221, -0.501549, -0.502876,
-    -0.504201, -0.505525, -0.506848, -0.508170, -0.509490, -0.510810, -0.512128, -0.513445,
-    -0.514760, -0.516075, -0.517388, -0.518700, -0.520011, -0.521321, -0.522629, -0.523937,
-    -0.525243, -0.526547, -0.527851, -0.529153, -0.530454, -0.531754, -0.533052, -0.534349,
-    -0.535645, -0.536940, -0.538234, -0.539526, -0.540817, -0.542106, -0.543395, -0.544682,
-    -0.545968, -0.547252, -0.548536, -0.549817, -0.551098, -0.552378, -0.553656, -0.554932,
-    -0.556208, -0.557482, -0.558755, -0.560026, -0.561297, -0.562565, -0.563833, -0.565099,
-    -0.566364, -0.567628, -0.568890, -0.570151, -0.571410, -0.572669, -0.573925, -0.575181,
-    -0.576435, -0.577688, -0.578939, -0.580189, -0.581438, -0.582685, -0.583931, -0.585176,
-    -0.586419, -0.587661, -0.588902, -0.590141, -0.591378, -0.592615, -0.593850, -0.595083,
-    -0.596315, -0.597546, -0.598775, -0.600003, -0.601230, -0.602455, -0.603678, -0.604900,
-    -0.606121, -0.607341, -0.608559, -0.609775, -0.610990, -0.612204, -0.613416, -0.614627,
-    -0.615836, -0.617044, -0.618250, -0.619455, -0.620659, -0.621861, -0.623061, -0.624260,
-    -0.625458, -0.626654, -0.627849, -0.629042, -0.630234, -0.631424, -0.632613, -0.633800,
-    -0.634986, -0.636170, -0.637353, -0.638534, -0.639714, -0.640892, -0.642069, -0.643244,
-    -0.644418, -0.645590, -0.646761, -0.647930, -0.649098, -0.650264, -0.651429, -0.652592,
-    -0.653753, -0.654913, -0.656072, -0.657229, -0.658384, -0.659538, -0.660690, -0.661841,
-    -0.662990, -0.664138, -0.665284, -0.666428, -0.667571, -0.668713, -0.669852, -0.670990,
-    -0.672127, -0.673262, -0.674396, -0.675527, -0.676658, -0.677786, -0.678913, -0.680039,
-    -0.681163, -0.682285, -0.683406, -0.684525, -0.685642, -0.686758, -0.687872, -0.688985,
-    -0.690096, -0.691205, -0.692313, -0.693419, -0.694523, -0.695626, -0.696728, -0.697827,
-    -0.698925, -0.700021, -0.701116, -0.702209, -0.703300, -0.704390, -0.705478, -0.706564,
-    -0.707649, -0.708732, -0.709813, -0.710893, -0.711971, -0.713047, -0.714122, -0.715195,
-    -0.716266, -0.717336, -0.718404, -0.719470, -0.720535, -0.721597, -0.722659, -0.723718,
-    -0.724776, -0.725832, -0.726886, -0.727939, -0.728990, -0.730039, -0.731086, -0.732132,
-    -0.733176, -0.734218, -0.735259, -0.736298, -0.737335, -0.738370, -0.739404, -0.740436,
-    -0.741466, -0.742494, -0.743521, -0.744546, -0.745569, -0.746591, -0.747610, -0.748628,
-    -0.749644, -0.750659, -0.751671, -0.752682, -0.753691, -0.754698, -0.755704, -0.756708,
-    -0.757710, -0.758710, -0.759708, -0.760705, -0.761700, -0.762693, -0.763684, -0.764673,
-    -0.765661, -0.766647, -0.767631, -0.768613, -0.769593, -0.770572, -0.771549, -0.772524,
-    -0.773497, -0.774468, -0.775438, -0.776405, -0.777371, -0.778335, -0.779297, -0.780258,
-    -0.781216, -0.782173, -0.783128, -0.784081, -0.785032, -0.785981, -0.786929, -0.787874,
-    -0.788818, -0.789760, -0.790700, -0.791638, -0.792575, -0.793509, -0.794442, -0.795372,
-    -0.796301, -0.797228, -0.798153, -0.799076, -0.799998, -0.800917, -0.801835, -0.802750,
-    -0.803664, -0.804576, -0.805486, -0.806394, -0.807300, -0.808205, -0.809107, -0.810008,
-    -0.810906, -0.811803, -0.812698, -0.813591, -0.814482, -0.815371, -0.816258, -0.817143,
-    -0.818026, -0.818908, -0.819787, -0.820664, -0.821540, -0.822414, -0.823285, -0.824155,
-    -0.825023, -0.825889, -0.826753, -0.827615, -0.828475, -0.829333, -0.830189, -0.831043,
-    -0.831895, -0.832746, -0.833594, -0.834440, -0.835285, -0.836127, -0.836968, -0.837806,
-    -0.838643, -0.839477, -0.840310, -0.841140, -0.841969, -0.842796, -0.843620, -0.844443,
-    -0.845264, -0.846082, -0.846899, -0.847714, -0.848526, -0.849337, -0.850146, -0.850953,
-    -0.851757, -0.852560, -0.853361, -0.854159, -0.854956, -0.855751, -0.856543, -0.857334,
-    -0.858123, -0.858909, -0.859694, -0.860476, -0.861257, -0.862035, -0.862812, -0.863586,
-    -0.864359, -0.865129, -0.865898, -0.866664, -0.867428, -0.868190, -0.868951, -0.869709,
-    -0.870465, -0.871219, -0.871971, -0.872721, -0.873469, -0.874215, -0.874958, -0.875700,
-    -0.876440, -0.877177, -0.877913, -0.878646, -0.879378, -0.880107, -0.880834, -0.881559,
-    -0.882283, -0.883004, -0.883723, -0.884439, -0.885154, -0.885867, -0.886578, -0.887286,
-    -0.887993, -0.888697, -0.889399, -0.890099, -0.890798, -0.891493, -0.892187, -0.892879,
-    -0.893569, -0.894256, -0.894942, -0.895625, -0.896307, -0.896986, -0.897663, -0.898338,
-    -0.899011, -0.899681, -0.900350, -0.901016, -0.901681, -0.902343, -0.903003, -0.903661,
-    -0.904317, -0.904971, -0.905622, -0.906272, -0.906919, -0.907564, -0.908207, -0.908848,
-    -0.909487, -0.910124, -0.910758, -0.911391, -0.912021, -0.912649, -0.913275, -0.913899,
-    -0.914520, -0.915140, -0.915757, -0.916372, -0.916985, -0.917596, -0.918205, -0.918811,
-    -0.919416, -0.920018, -0.920618, -0.921216, -0.921812, -0.922405, -0.922997, -0.923586,
-    -0.924173, -0.924758, -0.925340, -0.925921, -0.926499, -0.927075, -0.927649, -0.928221,
-    -0.928791, -0.929358, -0.929923, -0.930486, -0.931047, -0.931606, -0.932162, -0.932716,
-    -0.933269, -0.933818, -0.934366, -0.934912, -0.935455, -0.935996, -0.936535, -0.937072,
-    -0.937606, -0.938138, -0.938668, -0.939196, -0.939722, -0.940245, -0.940766, -0.941285,
-    -0.941802, -0.942317, -0.942829, -0.943339, -0.943847, -0.944353, -0.944856, -0.945358,
-    -0.945857, -0.946353, -0.946848, -0.947340, -0.947830, -0.948318, -0.948804, -0.949287,
-    -0.949768, -0.950247, -0.950724, -0.951199, -0.951671, -0.952141, -0.952609, -0.953074,
-    -0.953537, -0.953998, -0.954457, -0.954914, -0.955368, -0.955820, -0.956270, -0.956717,
-    -0.957163, -0.957606, -0.958047, -0.958485, -0.958921, -0.959355, -0.959787, -0.960217,
-    -0.960644, -0.961069, -0.961492, -0.961912, -0.962330, -0.962746, -0.963160, -0.963571,
-    -0.963980, -0.964387, -0.964792, -0.965194, -0.965594, -0.965992, -0.966387, -0.966781,
-    -0.967172, -0.967560, -0.967947, -0.968331, -0.968713, -0.969092, -0.969470, -0.969845,
-    -0.970217, -0.970588, -0.970956, -0.971322, -0.971685, -0.972047, -0.972406, -0.972762,
-    -0.973117, -0.973469, -0.973819, -0.974166, -0.974512, -0.974855, -0.975195, -0.975534,
-    -0.975870, -0.976204, -0.976535, -0.976864, -0.977191, -0.977516, -0.977838, -0.978158,
-    -0.978476, -0.978791, -0.979104, -0.979415, -0.979724, -0.980030, -0.980334, -0.980635,
-    -0.980935, -0.981232, -0.981526, -0.981819, -0.982109, -0.982396, -0.982682, -0.982965,
-    -0.983246, -0.983524, -0.983800, -0.984074, -0.984346, -0.984615, -0.984882, -0.985146,
-    -0.985408, -0.985668, -0.985926, -0.986181, -0.986434, -0.986685, -0.986933, -0.987179,
-    -0.987423, -0.987664, -0.987903, -0.988140, -0.988374, -0.988607, -0.988836, -0.989064,
-    -0.989289, -0.989512, -0.989732, -0.989950, -0.990166, -0.990379, -0.990590, -0.990799,
-    -0.991006, -0.991210, -0.991411, -0.991611, -0.991808, -0.992003, -0.992195, -0.992385,
-    -0.992573, -0.992759, -0.992942, -0.993122, -0.993301, -0.993477, -0.993651, -0.993822,
-    -0.993991, -0.994158, -0.994322, -0.994484, -0.994644, -0.994802, -0.994957, -0.995109,
-    -0.995260, -0.995408, -0.995553, -0.995697, -0.995838, -0.995976, -0.996113, -0.996247,
-    -0.996378, -0.996507, -0.996634, -0.996759, -0.996881, -0.997001, -0.997119, -0.997234,
-    -0.997347, -0.997457, -0.997565, -0.997671, -0.997775, -0.997876, -0.997974, -0.998071,
-    -0.998165, -0.998257, -0.998346, -0.998433, -0.998518, -0.998600, -0.998680, -0.998758,
-    -0.998833, -0.998906, -0.998976, -0.999045, -0.999110, -0.999174, -0.999235, -0.999294,
-    -0.999350, -0.999404, -0.999456, -0.999506, -0.999553, -0.999597, -0.999640, -0.999680,
-    -0.999717, -0.999753, -0.999786, -0.999816, -0.999844, -0.999870, -0.999894, -0.999915,
-    -0.999934, -0.999950, -0.999964, -0.999976, -0.999986, -0.999993, -0.999997, -1.000000,
-    -1.000000, -0.999997, -0.999993, -0.999986, -0.999976, -0.999964, -0.999950, -0.999934,
-    -0.999915, -0.999894, -0.999870, -0.999844, -0.999816, -0.999786, -0.999753, -0.999717,
-    -0.999680, -0.999640, -0.999597, -0.999553, -0.999506, -0.999456, -0.999404, -0.999350,
-    -0.999294, -0.999235, -0.999174, -0.999110, -0.999045, -0.998976, -0.998906, -0.998833,
-    -0.998758, -0.998680, -0.998600, -0.998518, -0.998433, -0.998346, -0.998257, -0.998165,
-    -0.998071, -0.997974, -0.997876, -0.997775, -0.997671, -0.997565, -0.997457, -0.997347,
-    -0.997234, -0.997119, -0.997001, -0.996881, -0.996759, -0.996634, -0.996507, -0.996378,
-    -0.996247, -0.996113, -0.995976, -0.995838, -0.995697, -0.995553, -0.995408, -0.995260,
-    -0.995109, -0.994957, -0.994802, -0.994644, -0.994484, -0.994322, -0.994158, -0.993991,
-    -0.993822, -0.993651, -0.993477, -0.993301, -0.993122, -0.992942, -0.992759, -0.992573,
-    -0.992385, -0.992195, -0.992003, -0.991808, -0.991611, -0.991411, -0.991210, -0.991006,
-    -0.990799, -0.990590, -0.990379, -0.990166, -0.989950, -0.989732, -0.989512, -0.989289,
-    -0.989064, -0.988836, -0.988607, -0.988374, -0.988140, -0.987903, -0.987664, -0.987423,
-    -0.987179, -0.986933, -0.986685, -0.986434, -0.986181, -0.985926, -0.985668, -0.985408,
-    -0.985146, -0.984882, -0.984615, -0.984346, -0.984074, -0.983800, -0.983524, -0.983246,
-    -0.982965, -0.982682, -0.982396, -0.982109, -0.981819, -0.981526, -0.981232, -0.980935,
-    -0.980635, -0.980334, -0.980030, -0.979724, -0.979415, -0.979104, -0.978791, -0.978476,
-    -0.978158, -0.977838, -0.977516, -0.977191, -0.976864, -0.976535, -0.976204, -0.975870,
-    -0.975534, -0.975195, -0.974855, -0.974512, -0.974166, -0.973819, -0.973469, -0.973117,
-    -0.972762, -0.972406, -0.972047, -0.971685, -0.971322, -0.970956, -0.970588, -0.970217,
-    -0.969845, -0.969470, -0.969092, -0.968713, -0.968331, -0.967947, -0.967560, -0.967172,
-    -0.966781, -0.966387, -0.965992, -0.965594, -0.965194, -0.964792, -0.964387, -0.963980,
-    -0.963571, -0.963160, -0.962746, -0.962330, -0.961912, -0.961492, -0.961069, -0.960644,
-    -0.960217, -0.959787, -0.959355, -0.958921, -0.958485, -0.958047, -0.957606, -0.957163,
-    -0.956717, -0.956270, -0.955820, -0.955368, -0.954914, -0.954457, -0.953998, -0.953537,
-    -0.953074, -0.952609, -0.952141, -0.951671, -0.951199, -0.950724, -0.950247, -0.949768,
-    -0.949287, -0.948804, -0.948318, -0.947830, -0.947340, -0.946848, -0.946353, -0.945857,
-    -0.945358, -0.944856, -0.944353, -0.943847, -0.943339, -0.942829, -0.942317, -0.941802,
-    -0.941285, -0.940766, -0.940245, -0.939722, -0.939196, -0.938668, -0.938138, -0.937606,
-    -0.937072, -0.936535, -0.935996, -0.935455, -0.934912, -0.934366, -0.933818, -0.933269,
-    -0.932716, -0.932162, -0.931606, -0.931047, -0.930486, -0.929923, -0.929358, -0.928791,
-    -0.928221, -0.927649, -0.927075, -0.926499, -0.925921, -0.925340, -0.924758, -0.924173,
-    -0.923586, -0.922997, -0.922405, -0.921812, -0.921216, -0.920618, -0.920018, -0.919416,
-    -0.918811, -0.918205, -0.917596, -0.916985, -0.916372, -0.915757, -0.915140, -0.914520,
-    -0.913899, -0.913275, -0.912649, -0.912021, -0.911391, -0.910758, -0.910124, -0.909487,
-    -0.908848, -0.908207, -0.907564, -0.906919, -0.906272, -0.905622, -0.904971, -0.904317,
-    -0.903661, -0.903003, -0.902343, -0.901681, -0.901016, -0.900350, -0.899681, -0.899011,
-    -0.898338, -0.897663, -0.896986, -0.896307, -0.895625, -0.894942, -0.894256, -0.893569,
-    -0.892879, -0.892187, -0.891493, -0.890798, -0.890099, -0.889399, -0.888697, -0.887993,
-    -0.887286, -0.886578, -0.885867, -0.885154, -0.884439, -0.883723, -0.883004, -0.882283,
-    -0.881559, -0.880834, -0.880107, -0.879378, -0.878646, -0.877913, -0.877177, -0.876440,
-    -0.875700, -0.874958, -0.874215, -0.873469, -0.872721, -0.871971, -0.871219, -0.870465,
-    -0.869709, -0.868951, -0.868190, -0.867428, -0.866664, -0.865898, -0.865129, -0.864359,
-    -0.863586, -0.862812, -0.862035, -0.861257, -0.860476, -0.859694, -0.858909, -0.858123,
-    -0.857334, -0.856543, -0.855751, -0.854956, -0.854159, -0.853361, -0.852560, -0.851757,
-    -0.850953, -0.850146, -0.849337, -0.848526, -0.847714, -0.846899, -0.846082, -0.845264,
-    -0.844443, -0.843620, -0.842796, -0.841969, -0.841140, -0.840310, -0.839477, -0.838643,
-    -0.837806, -0.836968, -0.836127, -0.835285, -0.834440, -0.833594, -0.832746, -0.831895,
-    -0.831043, -0.830189, -0.829333, -0.828475, -0.827615, -0.826753, -0.825889, -0.825023,
-    -0.824155, -0.823285, -0.822414, -0.821540, -0.820664, -0.819787, -0.818908, -0.818026,
-    -0.817143, -0.816258, -0.815371, -0.814482, -0.813591, -0.812698, -0.811803, -0.810906,
-    -0.810008, -0.809107, -0.808205, -0.807300, -0.806394, -0.805486, -0.804576, -0.803664,
-    -0.802750, -0.801835, -0.800917, -0.799998, -0.799076, -0.798153, -0.797228, -0.796301,
-    -0.795372, -0.794442, -0.793509, -0.792575, -0.791638, -0.790700, -0.789760, -0.788818,
-    -0.787874, -0.786929, -0.785981, -0.785032, -0.784081, -0.783128, -0.782173, -0.781216,
-    -0.780258, -0.779297, -0.778335, -0.777371, -0.776405, -0.775438, -0.774468, -0.773497,
-    -0.772524, -0.771549, -0.770572, -0.769593, -0.768613, -0.767631, -0.766647, -0.765661,
-    -0.764673, -0.763684, -0.762693, -0.761700, -0.760705, -0.759708, -0.758710, -0.757710,
-    -0.756708, -0.755704, -0.754698, -0.753691, -0.752682, -0.751671, -0.750659, -0.749644,
-    -0.748628, -0.747610, -0.746591, -0.745569, -0.744546, -0.743521, -0.742494, -0.741466,
-    -0.740436, -0.739404, -0.738370, -0.737335, -0.736298, -0.735259, -0.734218, -0.733176,
-    -0.732132, -0.731086, -0.730039, -0.728990, -0.727939, -0.726886, -0.725832, -0.724776,
-    -0.723718, -0.722659, -0.721597, -0.720535, -0.719470, -0.718404, -0.717336, -0.716266,
-    -0.715195, -0.714122, -0.713047, -0.711971, -0.710893, -0.709813, -0.708732, -0.707649,
-    -0.706564, -0.705478, -0.704390, -0.703300, -0.702209, -0.701116, -0.700021, -0.698925,
-    -0.697827, -0.696728, -0.695626, -0.694523, -0.693419, -0.692313, -0.691205, -0.690096,
-    -0.688985, -0.687872, -0.686758, -0.685642, -0.684525, -0.683406, -0.682285, -0.681163,
-    -0.680039, -0.678913, -0.677786, -0.676658, -0.675527, -0.674396, -0.673262, -0.672127,
-    -0.670990, -0.669852, -0.668713, -0.667571, -0.666428, -0.665284, -0.664138, -0.662990,
-    -0.661841, -0.660690, -0.659538, -0.658384, -0.657229, -0.656072, -0.654913, -0.653753,
-    -0.652592, -0.651429, -0.650264, -0.649098, -0.647930, -0.646761, -0.645590, -0.644418,
-    -0.643244, -0.642069, -0.640892, -0.639714, -0.638534, -0.637353, -0.636170, -0.634986,
-    -0.633800, -0.632613, -0.631424, -0.630234, -0.629042, -0.627849, -0.626654, -0.625458,
-    -0.624260, -0.623061, -0.621861, -0.620659, -0.619455, -0.618250, -0.617044, -0.615836,
-    -0.614627, -0.613416, -0.612204, -0.610990, -0.609775, -0.608559, -0.607341, -0.606121,
-    -0.604900, -0.603678, -0.602455, -0.601230, -0.600003, -0.598775, -0.597546, -0.596315,
-    -0.595083, -0.593850, -0.592615, -0.591378, -0.590141, -0.588902, -0.587661, -0.586419,
-    -0.585176, -0.583931, -0.582685, -0.581438, -0.580189, -0.578939, -0.577688, -0.576435,
-    -0.575181, -0.573925, -0.572669, -0.571410, -0.570151, -0.568890, -0.567628, -0.566364,
-    -0.565099, -0.563833, -0.562565, -0.561297, -0.560026, -0.558755, -0.557482, -0.556208,
-    -0.554932, -0.553656, -0.552378, -0.551098, -0.549817, -0.548536, -0.547252, -0.545968,
-    -0.544682, -0.543395, -0.542106, -0.540817, -0.539526, -0.538234, -0.536940, -0.535645,
-    -0.534349, -0.533052, -0.531754, -0.530454, -0.529153, -0.527851, -0.526547, -0.525243,
-    -0.523937, -0.522629, -0.521321, -0.520011, -0.518700, -0.517388, -0.516075, -0.514760,
-    -0.513445, -0.512128, -0.510810, -0.509490, -0.508170, -0.506848, -0.505525, -0.504201,
-    -0.502876, -0.501549, -0.500221, -0.498893, -0.497563, -0.496231, -0.494899, -0.493565,
-    -0.492231, -0.490895, -0.489558, -0.488220, -0.486880, -0.485540, -0.484198, -0.482856,
-    -0.481512, -0.480167, -0.478821, -0.477473, -0.476125, -0.474775, -0.473425, -0.472073,
-    -0.470720, -0.469366, -0.468011, -0.466655, -0.465298, -0.463939, -0.462580, -0.461219,
-    -0.459858, -0.458495, -0.457131, -0.455766, -0.454400, -0.453033, -0.451665, -0.450296,
-    -0.448926, -0.447555, -0.446183, -0.444809, -0.443435, -0.442059, -0.440683, -0.439305,
-    -0.437927, -0.436547, -0.435167, -0.433785, -0.432402, -0.431019, -0.429634, -0.428248,
-    -0.426862, -0.425474, -0.424085, -0.422695, -0.421305, -0.419913, -0.418520, -0.417127,
-    -0.415732, -0.414336, -0.412940, -0.411542, -0.410144, -0.408744, -0.407344, -0.405942,
-    -0.404540, -0.403137, -0.401732, -0.400327, -0.398921, -0.397514, -0.396106, -0.394697,
-    -0.393287, -0.391876, -0.390464, -0.389052, -0.387638, -0.386224, -0.384808, -0.383392,
-    -0.381975, -0.380557, -0.379138, -0.377718, -0.376297, -0.374875, -0.373453, -0.372029,
-    -0.370605, -0.369180, -0.367754, -0.366327, -0.364899, -0.363470, -0.362041, -0.360611,
-    -0.359179, -0.357747, -0.356314, -0.354881, -0.353446, -0.352011, -0.350575, -0.349138,
-    -0.347700, -0.346261, -0.344821, -0.343381, -0.341940, -0.340498, -0.339055, -0.337612,
-    -0.336168, -0.334722, -0.333277, -0.331830, -0.330382, -0.328934, -0.327485, -0.326035,
-    -0.324585, -0.323134, -0.321682, -0.320229, -0.318775, -0.317321, -0.315866, -0.314410,
-    -0.312953, -0.311496, -0.310038, -0.308579, -0.307120, -0.305660, -0.304199, -0.302737,
-    -0.301275, -0.299812, -0.298348, -0.296883, -0.295418, -0.293952, -0.292486, -0.291019,
-    -0.289551, -0.288082, -0.286613, -0.285143, -0.283672, -0.282201, -0.280729, -0.279256,
-    -0.277783, -0.276309, -0.274834, -0.273359, -0.271883, -0.270407, -0.268930, -0.267452,
-    -0.265973, -0.264494, -0.263015, -0.261534, -0.260054, -0.258572, -0.257090, -0.255607,
-    -0.254124, -0.252640, -0.251155, -0.249670, -0.248185, -0.246698, -0.245212, -0.243724,
-    -0.242236, -0.240748, -0.239258, -0.237769, -0.236278, -0.234788, -0.233296, -0.231804,
-    -0.230312, -0.228819, -0.227325, -0.225831, -0.224337, -0.222841, -0.221346, -0.219850,
-    -0.218353, -0.216856, -0.215358, -0.213860, -0.212361, -0.210862, -0.209362, -0.207862,
-    -0.206361, -0.204860, -0.203358, -0.201856, -0.200353, -0.198850, -0.197347, -0.195843,
-    -0.194338, -0.192833, -0.191328, -0.189822, -0.188315, -0.186809, -0.185301, -0.183794,
-    -0.182286, -0.180777, -0.179268, -0.177759, -0.176249, -0.174739, -0.173229, -0.171718,
-    -0.170206, -0.168694, -0.167182, -0.165670, -0.164157, -0.162643, -0.161129, -0.159615,
-    -0.158101, -0.156586, -0.155071, -0.153555, -0.152039, -0.150523, -0.149006, -0.147489,
-    -0.145972, -0.144454, -0.142936, -0.141418, -0.139899, -0.138380, -0.136860, -0.135341,
-    -0.133821, -0.132300, -0.130780, -0.129259, -0.127737, -0.126216, -0.124694, -0.123172,
-    -0.121649, -0.120127, -0.118604, -0.117080, -0.115557, -0.114033, -0.112509, -0.110984,
-    -0.109460, -0.107935, -0.106410, -0.104884, -0.103359, -0.101833, -0.100307, -0.098780,
-    -0.097254, -0.095727, -0.094200, -0.092673, -0.091145, -0.089617, -0.088090, -0.086561,
-    -0.085033, -0.083505, -0.081976, -0.080447, -0.078918, -0.077389, -0.075859, -0.074329,
-    -0.072800, -0.071270, -0.069739, -0.068209, -0.066679, -0.065148, -0.063617, -0.062086,
-    -0.060555, -0.059024, -0.057493, -0.055961, -0.054429, -0.052898, -0.051366, -0.049834,
-    -0.048302, -0.046769, -0.045237, -0.043705, -0.042172, -0.040639, -0.039107, -0.037574,
-    -0.036041, -0.034508, -0.032975, -0.031441, -0.029908, -0.028375, -0.026841, -0.025308,
-    -0.023774, -0.022241, -0.020707, -0.019174, -0.017640, -0.016106, -0.014572, -0.013038,
-    -0.011505, -0.009971, -0.008437, -0.006903, -0.005369, -0.003835, -0.002301, -0.0000767,
 };
@@ -67,6 +67,12 @@ cJSON* local_command_and_associated_response_msg_cb_settings_poweron(cJSON *sett
 //Query Version local command
 cJSON* local_command_and_associated_response_msg_cb_query_version_info(cJSON *settings_query_version_incoming_data_field);
 
+//Trigger command
+cJSON* local_command_and_associated_response_msg_cb_trigger(cJSON *trigger_incoming_data_field);
+
+//Profile command
+cJSON* local_command_and_associated_response_msg_cb_profile(cJSON *profile_incoming_data_field);
+
 #pragma endregion "prototypes for callback implementations that are restricted to the scope of this module"
 
 const command_message_callback_keys_type command_callback_keys[NUM_COMMAND_KEYS] =
@@ -80,7 +86,9 @@ const command_message_callback_keys_type command_callback_keys[NUM_COMMAND_KEYS]
 	{COMMAND_STRING_HEARTBEAT,			&local_command_and_associated_response_msg_cb_heartbeat,			NULL,										NULL},
     {COMMAND_STRING_READMEM,            &local_command_and_associated_response_msg_cb_readmem,				NULL,                                       NULL},
     {COMMAND_STRING_SETTINGS_POWERON,   &local_command_and_associated_response_msg_cb_settings_poweron,		NULL,                                       NULL},
-	{COMMAND_QUERY_INSTRUMENT_INFO,		&local_command_and_associated_response_msg_cb_query_version_info,	NULL,										NULL}
+	{COMMAND_QUERY_INSTRUMENT_INFO,		&local_command_and_associated_response_msg_cb_query_version_info,	NULL,										NULL},
+	{COMMAND_STRING_TRIGGER,			&local_command_and_associated_response_msg_cb_trigger,				NULL,										NULL},
+	{COMMAND_STRING_PROFILE,			&local_command_and_associated_response_msg_cb_profile,				NULL,										NULL}
 };
 
 /*TODO: Don't forget to consider the scenario where the ARM code functions without .NET board present.
@@ -385,3 +393,88 @@ cJSON* local_command_and_associated_response_msg_cb_query_version_info(cJSON *se
 }
 #pragma endregion "callback implementations related to the settings Query Version command"
 
+#pragma region "callback implementations related to the Trigger command"
+/**
+ * @brief callback to handle incoming local command message for Trigger command
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a Trigger command. In burst mode, 
+ * it starts a burst, the same as an edge on the external trigger input.
+ * 
+ * @param trigger_incoming_data_field   not used here, Trigger cmd doesn't have an input parameter
+ * 
+ * @return cJSON*   NULL. Trigger command response does not have a data field.
+ */
+cJSON* local_command_and_associated_response_msg_cb_trigger(cJSON *trigger_incoming_data_field)
+{
+    (void)trigger_incoming_data_field;		//here to silence -Wunused-parameter warning
+    
+    execute_trigger_command();
+    
+    return(NULL);
+}
+#pragma endregion "callback implementations related to the Trigger command"
+
+#pragma region "callback implementations related to the Profile command"
+/**
+ * @brief callback to handle incoming local command message for Profile command
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a Profile command. One probe is
+ * returned per command, since all of them together won't fit in an LSCP message. The host walks Probe from 0 up to
+ * NumberOfProbes - 1. Cycle counts are core clocks, at CoreClock Hz.
+ * 
+ * @param profile_incoming_data_field data field of LSCP Profile command message, encoded as a cJSON data struct
+ * 
+ * "Probe" is the probe number, 0 if absent. "Reset", if true, clears the probe once it's read.
+ * 
+ * @return cJSON* the probe's name, count, min/max/mean cycles and log2 histogram, encoded as a cJSON data struct
+ */
+cJSON* local_command_and_associated_response_msg_cb_profile(cJSON *profile_incoming_data_field)
+{
+	uint32_t probe = 0;
+	bool reset = false;
+	const char *probe_name;
+	int histogram[PROFILE_HISTOGRAM_BINS];
+	uint32_t counter;
+	profile_probe_data_type probe_data;
+	cJSON *probe_object;
+	cJSON *reset_object;
+	cJSON *LSCP_data_object;
+	
+	if(profile_incoming_data_field != NULL)
+	{
+		probe_object = cJSON_GetObjectItem(profile_incoming_data_field, "Probe");
+		reset_object = cJSON_GetObjectItem(profile_incoming_data_field, "Reset");
+		
+		if(probe_object != NULL)
+		{
+			probe = (uint32_t)(probe_object->valueint);
+		}
+		
+		if(reset_object != NULL)
+		{
+			reset = (reset_object->type == cJSON_True);
+		}
+	}
+	
+	probe_name = execute_Profile_command(probe, reset, &probe_data);
+	
+	for(counter = 0; counter < PROFILE_HISTOGRAM_BINS; counter++)
+	{
+		histogram[counter] = (int)probe_data.histogram[counter];
+	}
+	
+	LSCP_data_object = cJSON_CreateObject();
+	cJSON_AddBoolToObject(LSCP_data_object, "Enabled", PROFILER_ENABLED);
+	cJSON_AddNumberToObject(LSCP_data_object, "Probe", probe);
+	cJSON_AddNumberToObject(LSCP_data_object, "NumberOfProbes", NUMBER_OF_PROFILE_PROBES);
+	cJSON_AddStringToObject(LSCP_data_object, "Name", probe_name);
+	cJSON_AddNumberToObject(LSCP_data_object, "CoreClock", SystemCoreClock);
+	cJSON_AddNumberToObject(LSCP_data_object, "Count", probe_data.count);
+	cJSON_AddNumberToObject(LSCP_data_object, "MinCycles", (probe_data.count != 0) ? probe_data.minimum_cycles : 0);
+	cJSON_AddNumberToObject(LSCP_data_object, "MaxCycles", probe_data.maximum_cycles);
+	cJSON_AddNumberToObject(LSCP_data_object, "MeanCycles", (probe_data.count != 0) ? ((double)probe_data.total_cycles / probe_data.count) : 0);
+	cJSON_AddItemToObject(LSCP_data_object, "Histogram", cJSON_CreateIntArray(histogram, PROFILE_HISTOGRAM_BINS));
+	
+	return(LSCP_data_object);
+}
+#pragma endregion "callback implementations related to the Profile command"
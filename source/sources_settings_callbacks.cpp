@@ -20,6 +20,7 @@
 #include "sources_settings_callbacks.h"
 #include "settings_manager.h"
 #include "calibration.h"
+#include "output_control.h"
 
 
 #pragma region "prototypes for callback implementations that are restricted to the scope of this module"
@@ -40,6 +41,28 @@ cJSON* generate_data_field_for_callocked_setting_msg_cb(void);
 void local_setting_msg_cb_frequency(cJSON *frequency_data_object);
 cJSON* generate_data_field_for_frequency_setting_msg_cb(void);
 
+//phase setting
+void local_setting_msg_cb_phase(cJSON *phase_data_object);
+cJSON* generate_data_field_for_phase_setting_msg_cb(void);
+
+//frequency sweep setting
+void local_setting_msg_cb_frequency_sweep(cJSON *frequency_sweep_data_object);
+cJSON* generate_data_field_for_frequency_sweep_setting_msg_cb(void);
+
+//frequency sweep status setting
+cJSON* generate_data_field_for_frequency_sweep_status_setting_msg_cb(void);
+
+//burst setting
+void local_setting_msg_cb_burst(cJSON *burst_data_object);
+cJSON* generate_data_field_for_burst_setting_msg_cb(void);
+
+//sync setting
+void local_setting_msg_cb_sync(cJSON *sync_data_object);
+cJSON* generate_data_field_for_sync_setting_msg_cb(void);
+
+//sync status setting
+cJSON* generate_data_field_for_sync_status_setting_msg_cb(void);
+
 //shape setting
 void local_setting_msg_cb_shape(cJSON *shape_data_object);
 cJSON* generate_data_field_for_shape_setting_msg_cb(void);
@@ -60,6 +83,24 @@ cJSON* generate_data_field_for_voltage_level_setting_msg_cb(void);
 void local_setting_msg_cb_current_level(cJSON *current_level_data_object);
 cJSON* generate_data_field_for_current_level_setting_msg_cb(void);
 
+//DC slew rate setting
+void local_setting_msg_cb_DC_slew_rate(cJSON *DC_slew_rate_data_object);
+cJSON* generate_data_field_for_DC_slew_rate_setting_msg_cb(void);
+
+//DC ramp status setting
+cJSON* generate_data_field_for_DC_ramp_status_setting_msg_cb(void);
+
+//DC high resolution enabled setting
+void local_setting_msg_cb_DC_high_resolution_enabled(cJSON *DC_high_resolution_data_object);
+cJSON* generate_data_field_for_DC_high_resolution_enabled_setting_msg_cb(void);
+
+//sample overrun notify enabled setting
+void local_setting_msg_cb_sample_overrun_notify_enabled(cJSON *sample_overrun_notify_data_object);
+cJSON* generate_data_field_for_sample_overrun_notify_enabled_setting_msg_cb(void);
+
+//sample overrun status setting
+cJSON* generate_data_field_for_sample_overrun_status_setting_msg_cb(void);
+
 //current range setting
 void local_setting_msg_cb_current_range(cJSON *current_range_data_object);
 cJSON* generate_data_field_for_current_range_setting_msg_cb(void);
@@ -89,6 +130,10 @@ cJSON* generate_data_field_for_caldata_setting_msg_cb(void);
 //input reading
 cJSON* generate_data_field_for_input_reading_msg_cb(void);
 
+//ARB data setting
+void local_setting_msg_cb_arb_data(cJSON *arb_data_object);
+cJSON* generate_data_field_for_arb_data_setting_msg_cb(void);
+
 #pragma endregion "prototypes for callback implementations that are restricted to the scope of this module"
 
 
@@ -101,11 +146,22 @@ const setting_message_callback_keys_type setting_callback_keys[NUM_SETTING_KEYS]
     {SETTING_STRING_OUTPUT_STATE,               local_setting_msg_cb_output_state,              NULL, generate_data_field_for_output_state_setting_msg_cb}, 
     {SETTING_STRING_CALLOCKED,                  local_setting_msg_cb_callocked,                 NULL, generate_data_field_for_callocked_setting_msg_cb},
     {SETTING_STRING_FREQUENCY,                  local_setting_msg_cb_frequency,                 NULL, generate_data_field_for_frequency_setting_msg_cb},
+    {SETTING_STRING_PHASE,                      local_setting_msg_cb_phase,                     NULL, generate_data_field_for_phase_setting_msg_cb},
+    {SETTING_STRING_FREQUENCY_SWEEP,            local_setting_msg_cb_frequency_sweep,           NULL, generate_data_field_for_frequency_sweep_setting_msg_cb},
+    {SETTING_STRING_FREQUENCY_SWEEP_STATUS,     NULL,                                           NULL, generate_data_field_for_frequency_sweep_status_setting_msg_cb},
+    {SETTING_STRING_BURST,                      local_setting_msg_cb_burst,                     NULL, generate_data_field_for_burst_setting_msg_cb},
+    {SETTING_STRING_SYNC,                       local_setting_msg_cb_sync,                      NULL, generate_data_field_for_sync_setting_msg_cb},
+    {SETTING_STRING_SYNC_STATUS,                NULL,                                           NULL, generate_data_field_for_sync_status_setting_msg_cb},
     {SETTING_STRING_SHAPE,                      local_setting_msg_cb_shape,                     NULL, generate_data_field_for_shape_setting_msg_cb},
 	{SETTING_STRING_VOLTAGE_RANGE,              local_setting_msg_cb_voltage_range,             NULL, generate_data_field_for_voltage_range_setting_msg_cb},
     {SETTING_STRING_VOLTAGE_AUTORANGE_ENABLED,  local_setting_msg_cb_voltage_autorange_enabled, NULL, generate_data_field_for_voltage_autorange_enabled_setting_msg_cb},
     {SETTING_STRING_VOLTAGE_OUTPUT_LEVEL,       local_setting_msg_cb_voltage_level,             NULL, generate_data_field_for_voltage_level_setting_msg_cb},
     {SETTING_STRING_CURRENT_OUTPUT_LEVEL,       local_setting_msg_cb_current_level,             NULL, generate_data_field_for_current_level_setting_msg_cb},
+    {SETTING_STRING_DC_SLEW_RATE,               local_setting_msg_cb_DC_slew_rate,              NULL, generate_data_field_for_DC_slew_rate_setting_msg_cb},
+    {SETTING_STRING_DC_RAMP_STATUS,             NULL,                                           NULL, generate_data_field_for_DC_ramp_status_setting_msg_cb},
+    {SETTING_STRING_DC_HIGH_RESOLUTION_ENABLED, local_setting_msg_cb_DC_high_resolution_enabled, NULL, generate_data_field_for_DC_high_resolution_enabled_setting_msg_cb},
+    {SETTING_STRING_SAMPLE_OVERRUN_NOTIFY_ENABLED, local_setting_msg_cb_sample_overrun_notify_enabled, NULL, generate_data_field_for_sample_overrun_notify_enabled_setting_msg_cb},
+    {SETTING_STRING_SAMPLE_OVERRUN_STATUS,      NULL,                                           NULL, generate_data_field_for_sample_overrun_status_setting_msg_cb},
 	{SETTING_STRING_CURRENT_RANGE,              local_setting_msg_cb_current_range,             NULL, generate_data_field_for_current_range_setting_msg_cb}, 
     {SETTING_STRING_CURRENT_AUTORANGE_ENABLED,  local_setting_msg_cb_current_autorange_enabled, NULL, generate_data_field_for_current_autorange_enabled_setting_msg_cb},
     {SETTING_STRING_CURRENT_COMPLIANCE_RANGE,   local_setting_msg_cb_current_compliance_range,  NULL, generate_data_field_for_current_compliance_range_setting_msg_cb},
@@ -114,7 +170,8 @@ const setting_message_callback_keys_type setting_callback_keys[NUM_SETTING_KEYS]
     {SETTING_STRING_TERMINALS,                  local_setting_msg_cb_terminals,                 NULL, generate_data_field_for_terminals_setting_msg_cb},
     {SETTING_STRING_INFO,                       NULL,                                           NULL, generate_data_field_for_info_setting_msg_cb},
     {SETTING_STRING_CALDATA,                    local_setting_msg_cb_caldata,                   NULL, generate_data_field_for_caldata_setting_msg_cb},
-    {SETTING_INPUT_READINGS,                    NULL,                                           NULL, generate_data_field_for_input_reading_msg_cb}       	
+    {SETTING_INPUT_READINGS,                    NULL,                                           NULL, generate_data_field_for_input_reading_msg_cb},
+    {SETTING_STRING_ARB_DATA,                   local_setting_msg_cb_arb_data,                  NULL, generate_data_field_for_arb_data_setting_msg_cb}
 };
 
 
@@ -329,12 +386,290 @@ cJSON* generate_data_field_for_frequency_setting_msg_cb(void)
 }
 #pragma endregion "callback implementations related to the frequency setting"
 
+#pragma region "callback implementations related to the phase setting"
+/**
+ * @brief callback to handle incoming setting message for the phase setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a phase setting to apply. The data field is:
+ * {"Phase": degrees, "ResetOnFrequencyChange": false = frequency changes are phase continuous / true = they restart at Phase}
+ * 
+ * @param phase_data_object data field of LSCP phase setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_phase(cJSON *phase_data_object)
+{
+	phase_type dirty_phase;
+	
+	dirty_phase.phase = (float)(cJSON_GetObjectItem(phase_data_object, "Phase")->valuedouble);
+	dirty_phase.reset_on_frequency_change = (cJSON_GetObjectItem(phase_data_object, "ResetOnFrequencyChange")->type == cJSON_True);
+	
+	if(validate_phase_setting(dirty_phase))
+	{
+		set_phase_setting(dirty_phase, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP phase setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to the phase setting message the android board just sent down.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP phase setting message data field
+ */
+cJSON* generate_data_field_for_phase_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	phase_type phase;
+	
+	phase = get_working_phase_setting();
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddNumberToObject(LSCP_data_field, "Phase", phase.phase);
+	cJSON_AddBoolToObject(LSCP_data_field, "ResetOnFrequencyChange", phase.reset_on_frequency_change);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the phase setting"
+
+#pragma region "callback implementations related to the frequency sweep setting"
+/**
+ * @brief callback to handle incoming setting message for the frequency sweep setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a frequency sweep to run (or abort). The data field is:
+ * {"StartFrequency": Hz, "StopFrequency": Hz, "Duration": s, "Law": 0 = linear / 1 = logarithmic, "Steps": n (0 = continuous), "Enabled": bool}
+ * Once started, the sweep is stepped on the instrument's own timer, so its timing doesn't depend on the LSCP link.
+ * 
+ * @param frequency_sweep_data_object data field of LSCP frequency sweep setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_frequency_sweep(cJSON *frequency_sweep_data_object)
+{
+	frequency_sweep_type dirty_frequency_sweep;
+	int32_t dirty_steps;
+	
+	dirty_frequency_sweep.start_frequency = (float)(cJSON_GetObjectItem(frequency_sweep_data_object, "StartFrequency")->valuedouble);
+	dirty_frequency_sweep.stop_frequency = (float)(cJSON_GetObjectItem(frequency_sweep_data_object, "StopFrequency")->valuedouble);
+	dirty_frequency_sweep.duration = (float)(cJSON_GetObjectItem(frequency_sweep_data_object, "Duration")->valuedouble);
+	dirty_frequency_sweep.law = (sweep_law_type)(cJSON_GetObjectItem(frequency_sweep_data_object, "Law")->valueint);
+	dirty_steps = cJSON_GetObjectItem(frequency_sweep_data_object, "Steps")->valueint;
+	dirty_frequency_sweep.enabled = (cJSON_GetObjectItem(frequency_sweep_data_object, "Enabled")->type == cJSON_True);
+	
+	if(dirty_steps >= 0)
+	{
+		dirty_frequency_sweep.steps = (uint32_t)dirty_steps;
+		
+		if(validate_frequency_sweep_setting(dirty_frequency_sweep))
+		{
+			set_frequency_sweep_setting(dirty_frequency_sweep, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+		}
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP frequency sweep setting message
+ * 
+ * The LSCP library will invoke this callback for the following scenarios:
+ * 1) The application needs to generate a setting response message to the android board, per its request, in response to the frequency sweep setting message
+ *    the android board just sent down.
+ * 2) The sweep finished or was overridden by a Frequency setting, and Enabled went false without the android asking.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP frequency sweep setting message data field
+ */
+cJSON* generate_data_field_for_frequency_sweep_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	frequency_sweep_type frequency_sweep;
+	
+	frequency_sweep = get_working_frequency_sweep_setting();
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddNumberToObject(LSCP_data_field, "StartFrequency", frequency_sweep.start_frequency);
+	cJSON_AddNumberToObject(LSCP_data_field, "StopFrequency", frequency_sweep.stop_frequency);
+	cJSON_AddNumberToObject(LSCP_data_field, "Duration", frequency_sweep.duration);
+	cJSON_AddNumberToObject(LSCP_data_field, "Law", frequency_sweep.law);
+	cJSON_AddNumberToObject(LSCP_data_field, "Steps", frequency_sweep.steps);
+	cJSON_AddBoolToObject(LSCP_data_field, "Enabled", frequency_sweep.enabled);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the frequency sweep setting"
+
+#pragma region "callback implementations related to the frequency sweep status setting"
+/**
+ * @brief callback to generate data field for an outgoing LSCP frequency sweep status setting message
+ * 
+ * The LSCP library will invoke this callback when the application sends the android an unsolicited progress report while a sweep runs,
+ * and once more when it completes. The data field is {"Running": bool, "Progress": 0 to 100 %, "Frequency": present output frequency in Hz}
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP frequency sweep status setting message data field
+ */
+cJSON* generate_data_field_for_frequency_sweep_status_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddBoolToObject(LSCP_data_field, "Running", is_frequency_sweep_running());
+	cJSON_AddNumberToObject(LSCP_data_field, "Progress", 100.0 * get_frequency_sweep_progress());
+	cJSON_AddNumberToObject(LSCP_data_field, "Frequency", get_frequency_sweep_present_frequency());
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the frequency sweep status setting"
+
+#pragma region "callback implementations related to the burst setting"
+/**
+ * @brief callback to handle incoming setting message for the burst setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a burst setting to apply. The data field is:
+ * {"Enabled": bool, "Cycles": n, "StartPhase": degrees, "TriggerSource": 0 = Trigger command only / 1 = external trigger input too}
+ * 
+ * @param burst_data_object data field of LSCP burst setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_burst(cJSON *burst_data_object)
+{
+	burst_type dirty_burst;
+	int32_t dirty_cycles;
+	
+	dirty_burst.enabled = (cJSON_GetObjectItem(burst_data_object, "Enabled")->type == cJSON_True);
+	dirty_cycles = cJSON_GetObjectItem(burst_data_object, "Cycles")->valueint;
+	dirty_burst.start_phase = (float)(cJSON_GetObjectItem(burst_data_object, "StartPhase")->valuedouble);
+	dirty_burst.trigger_source = (burst_trigger_source_type)(cJSON_GetObjectItem(burst_data_object, "TriggerSource")->valueint);
+	
+	if(dirty_cycles > 0)
+	{
+		dirty_burst.cycles = (uint32_t)dirty_cycles;
+		
+		if(validate_burst_setting(dirty_burst))
+		{
+			set_burst_setting(dirty_burst, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+		}
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP burst setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to the burst setting message the android board just sent down.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP burst setting message data field
+ */
+cJSON* generate_data_field_for_burst_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	burst_type burst;
+	
+	burst = get_working_burst_setting();
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddBoolToObject(LSCP_data_field, "Enabled", burst.enabled);
+	cJSON_AddNumberToObject(LSCP_data_field, "Cycles", burst.cycles);
+	cJSON_AddNumberToObject(LSCP_data_field, "StartPhase", burst.start_phase);
+	cJSON_AddNumberToObject(LSCP_data_field, "TriggerSource", burst.trigger_source);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the burst setting"
+
+#pragma region "callback implementations related to the sync setting"
+/**
+ * @brief callback to handle incoming setting message for the sync setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a sync setting to apply. The data field is:
+ * {"SyncInMode": 0 = off / 1 = phase lock / 2 = reset at each edge, "LockPhase": degrees, "SyncOutEnabled": bool}
+ * 
+ * @param sync_data_object data field of LSCP sync setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_sync(cJSON *sync_data_object)
+{
+	sync_type dirty_sync;
+	
+	dirty_sync.sync_in_mode = (sync_in_mode_type)(cJSON_GetObjectItem(sync_data_object, "SyncInMode")->valueint);
+	dirty_sync.lock_phase = (float)(cJSON_GetObjectItem(sync_data_object, "LockPhase")->valuedouble);
+	dirty_sync.sync_out_enabled = (cJSON_GetObjectItem(sync_data_object, "SyncOutEnabled")->type == cJSON_True);
+	
+	if(validate_sync_setting(dirty_sync))
+	{
+		set_sync_setting(dirty_sync, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP sync setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to the sync setting message the android board just sent down.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP sync setting message data field
+ */
+cJSON* generate_data_field_for_sync_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	sync_type sync;
+	
+	sync = get_working_sync_setting();
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddNumberToObject(LSCP_data_field, "SyncInMode", sync.sync_in_mode);
+	cJSON_AddNumberToObject(LSCP_data_field, "LockPhase", sync.lock_phase);
+	cJSON_AddBoolToObject(LSCP_data_field, "SyncOutEnabled", sync.sync_out_enabled);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the sync setting"
+
+#pragma region "callback implementations related to the sync status setting"
+/**
+ * @brief callback to generate data field for an outgoing LSCP sync status setting message
+ * 
+ * The LSCP library will invoke this callback when the application sends the android an unsolicited message as the phase lock
+ * is gained or lost. The data field is {"Locked": bool, "PhaseError": degrees at the last reference edge}
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP sync status setting message data field
+ */
+cJSON* generate_data_field_for_sync_status_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddBoolToObject(LSCP_data_field, "Locked", is_sync_in_locked());
+	cJSON_AddNumberToObject(LSCP_data_field, "PhaseError", get_sync_in_phase_error());
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the sync status setting"
+
 #pragma region "callback implementations related to the shape setting"
 /**
  * @brief callback to handle incoming setting message for local shape setting
  * 
  *  The LSCP library will invoke this callback when the android board has sent down a shape
- *  setting that we need to apply. Integer enum that for now represents DC or sine wave output.
+ *  setting that we need to apply. Integer enum representing DC, sine, square, triangle, ramp or ARB output.
  *  
  * @param shape_data_object data field of LSCP shape setting message, encoded as a cJSON data struct
  * 
@@ -346,7 +681,7 @@ void local_setting_msg_cb_shape(cJSON *shape_data_object)
     
     dirty_shape = shape_data_object->valueint;
     
-    if(simple_validate_setting(dirty_shape, SHAPE_DC, SHAPE_SINE))
+    if(validate_shape_setting(dirty_shape))
     {
         set_shape_setting((output_shape_type)dirty_shape, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
     }
@@ -586,6 +921,178 @@ cJSON* generate_data_field_for_current_level_setting_msg_cb(void)
 }
 #pragma endregion "callback implementations related to the current level setting"
 
+#pragma region "callback implementations related to the DC slew rate setting"
+/**
+ * @brief callback to handle incoming setting message for the DC slew rate setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a DC slew rate setting to apply. The data field is:
+ * {"Voltage": V/s, "Current": A/s}, 0 = DC level changes step straight to the new level
+ * 
+ * @param DC_slew_rate_data_object data field of LSCP DC slew rate setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_DC_slew_rate(cJSON *DC_slew_rate_data_object)
+{
+	DC_slew_rate_type dirty_DC_slew_rate;
+	
+	dirty_DC_slew_rate.voltage = (float)(cJSON_GetObjectItem(DC_slew_rate_data_object, "Voltage")->valuedouble);
+	dirty_DC_slew_rate.current = (float)(cJSON_GetObjectItem(DC_slew_rate_data_object, "Current")->valuedouble);
+	
+	if(validate_DC_slew_rate_setting(dirty_DC_slew_rate))
+	{
+		set_DC_slew_rate_setting(dirty_DC_slew_rate, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP DC slew rate setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to the DC slew rate setting message the android board just sent down.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP DC slew rate setting message data field
+ */
+cJSON* generate_data_field_for_DC_slew_rate_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	DC_slew_rate_type DC_slew_rate;
+	
+	DC_slew_rate = get_working_DC_slew_rate_setting();
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddNumberToObject(LSCP_data_field, "Voltage", DC_slew_rate.voltage);
+	cJSON_AddNumberToObject(LSCP_data_field, "Current", DC_slew_rate.current);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the DC slew rate setting"
+
+#pragma region "callback implementations related to the DC ramp status setting"
+/**
+ * @brief callback to generate data field for an outgoing LSCP DC ramp status setting message
+ * 
+ * The LSCP library will invoke this callback when the application sends the android an unsolicited message as a slew limited
+ * DC level change reaches its target. The data field is {"Ramping": bool}
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP DC ramp status setting message data field
+ */
+cJSON* generate_data_field_for_DC_ramp_status_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddBoolToObject(LSCP_data_field, "Ramping", is_DC_ramp_running());
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the DC ramp status setting"
+
+#pragma region "callback implementations related to the DC high resolution enabled setting"
+/**
+ * @brief callback to handle incoming setting message for the DC high resolution enabled setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down the DC high resolution enabled setting
+ * that we need to apply. It's a boolean stating whether DC levels are dithered between DAC codes.
+ * 
+ * @param DC_high_resolution_data_object data field of LSCP DC high resolution enabled setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_DC_high_resolution_enabled(cJSON *DC_high_resolution_data_object)
+{
+	if((DC_high_resolution_data_object->type >= cJSON_False) && (DC_high_resolution_data_object->type < cJSON_NULL)) //check to make sure cJSON type value isn't corrupt
+	{
+		set_DC_high_resolution_enabled_setting((DC_high_resolution_data_object->type == cJSON_True), DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP DC high resolution enabled setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to the DC high resolution enabled setting message the android board just sent down.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP DC high resolution enabled setting message data field
+ */
+cJSON* generate_data_field_for_DC_high_resolution_enabled_setting_msg_cb(void)
+{
+	return(cJSON_CreateBool(is_DC_high_resolution_enabled()));
+}
+#pragma endregion "callback implementations related to the DC high resolution enabled setting"
+
+#pragma region "callback implementations related to the sample overrun notify enabled setting"
+/**
+ * @brief callback to handle incoming setting message for the sample overrun notify enabled setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down the sample overrun notify enabled setting.
+ * It's a boolean stating whether the first missed sample raises a SampleOverrunStatus message. Either way, sending it
+ * starts the overrun counts over.
+ * 
+ * @param sample_overrun_notify_data_object data field of LSCP sample overrun notify enabled setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_sample_overrun_notify_enabled(cJSON *sample_overrun_notify_data_object)
+{
+	if((sample_overrun_notify_data_object->type >= cJSON_False) && (sample_overrun_notify_data_object->type < cJSON_NULL)) //check to make sure cJSON type value isn't corrupt
+	{
+		set_sample_overrun_notify_enabled_setting((sample_overrun_notify_data_object->type == cJSON_True), DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+	}
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP sample overrun notify enabled setting message
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP sample overrun notify enabled setting message data field
+ */
+cJSON* generate_data_field_for_sample_overrun_notify_enabled_setting_msg_cb(void)
+{
+	return(cJSON_CreateBool(is_sample_overrun_notify_enabled()));
+}
+#pragma endregion "callback implementations related to the sample overrun notify enabled setting"
+
+#pragma region "callback implementations related to the sample overrun status setting"
+/**
+ * @brief callback to generate data field for an outgoing LSCP sample overrun status setting message
+ * 
+ * The LSCP library will invoke this callback when the android asks for the status, or when the application sends it
+ * unsolicited on the first missed sample, or when a DAC stream's frames don't match the sample period. The data field is
+ * {"LateSamples": count, "OverlappedSamples": count, "WorstLatencyNs": ns, "LatencyBudgetNs": ns, "StreamFrameErrorNs": ns}
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP sample overrun status setting message data field
+ */
+cJSON* generate_data_field_for_sample_overrun_status_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	sample_overrun_status_type sample_overrun_status;
+	
+	get_sample_overrun_status(&sample_overrun_status);
+	
+	LSCP_data_field = cJSON_CreateObject();
+	
+	cJSON_AddNumberToObject(LSCP_data_field, "LateSamples", sample_overrun_status.late_samples);
+	cJSON_AddNumberToObject(LSCP_data_field, "OverlappedSamples", sample_overrun_status.overlapped_samples);
+	cJSON_AddNumberToObject(LSCP_data_field, "WorstLatencyNs", sample_overrun_status.worst_latency * 1e9f);
+	cJSON_AddNumberToObject(LSCP_data_field, "LatencyBudgetNs", sample_overrun_status.latency_budget * 1e9f);
+	cJSON_AddNumberToObject(LSCP_data_field, "StreamFrameErrorNs", sample_overrun_status.stream_frame_error * 1e9f);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the sample overrun status setting"
+
 #pragma region "callback implementations related to the current range setting"
 /**
  * @brief callback to handle incoming setting message for local current range setting
@@ -892,6 +1399,8 @@ cJSON* generate_data_field_for_info_setting_msg_cb(void)
  * Calibration Next Due         
  * Current Gains and Offsets
  * Voltage Gains and Offsets
+ * DAC INL Correction (optional, the loaded curve is kept when absent)
+ * Frequency Response (optional, the loaded points are kept when absent)
  * 
  * @param caldata_data_object data field of LSCP CalData setting message, encoded as a cJSON data struct
  * 
@@ -908,6 +1417,8 @@ void local_setting_msg_cb_caldata(cJSON *caldata_data_object)
     cJSON *voltage_cal_object;
     cJSON *voltage_offsets;
     cJSON *voltage_gains;
+    cJSON *INL_corrections;
+    cJSON *frequency_response;
     
     //get serial number
     //strcpy(dirty_calibration_data.serial_number, cJSON_GetObjectItem(caldata_data_object, "SerialNumber")->valuestring);
@@ -945,6 +1456,36 @@ void local_setting_msg_cb_caldata(cJSON *caldata_data_object)
         dirty_calibration_data.voltage.gains[counter] = (float)(cJSON_GetArrayItem(voltage_gains, counter)->valuedouble);
     }
     
+    //get DAC INL correction
+    INL_corrections = cJSON_GetObjectItem(caldata_data_object, "InlCorrection");
+    
+    for(counter = 0; counter < NUMBER_OF_INL_CORRECTION_POINTS; counter++)
+    {
+        if((INL_corrections != NULL) && (cJSON_GetArraySize(INL_corrections) == NUMBER_OF_INL_CORRECTION_POINTS))
+        {
+            dirty_calibration_data.INL_corrections[counter] = (float)(cJSON_GetArrayItem(INL_corrections, counter)->valuedouble);
+        }
+        else
+        {
+            dirty_calibration_data.INL_corrections[counter] = calibration_data.INL_corrections[counter];
+        }
+    }
+    
+    //get frequency response
+    frequency_response = cJSON_GetObjectItem(caldata_data_object, "FrequencyResponse");
+    
+    for(counter = 0; counter < NUMBER_OF_FREQUENCY_RESPONSE_POINTS; counter++)
+    {
+        if((frequency_response != NULL) && (cJSON_GetArraySize(frequency_response) == NUMBER_OF_FREQUENCY_RESPONSE_POINTS))
+        {
+            dirty_calibration_data.frequency_response[counter] = (float)(cJSON_GetArrayItem(frequency_response, counter)->valuedouble);
+        }
+        else
+        {
+            dirty_calibration_data.frequency_response[counter] = calibration_data.frequency_response[counter];
+        }
+    }
+    
     set_calibraton_data(dirty_calibration_data, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);
     
 	//if(simple_validate_setting(dirty_terminals_setting, TERMINALS_FRONT, TERMINALS_REAR))
@@ -971,6 +1512,7 @@ cJSON* generate_data_field_for_caldata_setting_msg_cb(void)
 	cJSON *LSCP_data_field;
     cJSON *current_cal_object, *current_offsets, *current_gains;
     cJSON *voltage_cal_object, *voltage_offsets, *voltage_gains;    
+    cJSON *INL_corrections, *frequency_response;
     //calibration_data_type calibration_data;
     
     //calibration_data = get_calibration_data();
@@ -987,6 +1529,9 @@ cJSON* generate_data_field_for_caldata_setting_msg_cb(void)
     cJSON_AddItemToObject(current_cal_object, "Offsets", current_offsets);
     cJSON_AddItemToObject(current_cal_object, "Gains", current_gains);
     
+    INL_corrections = cJSON_CreateFloatArray((const float*)(&calibration_data.INL_corrections), NUMBER_OF_INL_CORRECTION_POINTS);
+    frequency_response = cJSON_CreateFloatArray((const float*)(&calibration_data.frequency_response), NUMBER_OF_FREQUENCY_RESPONSE_POINTS);
+    
     LSCP_data_field = cJSON_CreateObject();
     cJSON_AddStringToObject(LSCP_data_field, "SerialNumber", calibration_data.serial_number);
     cJSON_AddBoolToObject(LSCP_data_field, "AcFunctionalityEnabled", calibration_data.ac_enabled);
@@ -994,6 +1539,8 @@ cJSON* generate_data_field_for_caldata_setting_msg_cb(void)
     cJSON_AddStringToObject(LSCP_data_field, "DueDate", calibration_data.due_date);
     cJSON_AddItemToObject(LSCP_data_field, "Current", current_cal_object);
     cJSON_AddItemToObject(LSCP_data_field, "Voltage", voltage_cal_object);
+    cJSON_AddItemToObject(LSCP_data_field, "InlCorrection", INL_corrections);
+    cJSON_AddItemToObject(LSCP_data_field, "FrequencyResponse", frequency_response);
     
     //voltage_offsets = cJSON_CreateFloatArray((const float*)(&calibration_data.voltage.offsets),NUMBER_OF_VOLTAGE_CAL_POINTS);
     //voltage_gains = cJSON_CreateFloatArray((const float*)(&calibration_data.voltage.gains),NUMBER_OF_VOLTAGE_CAL_POINTS);
@@ -1051,4 +1598,79 @@ cJSON* generate_data_field_for_input_reading_msg_cb(void)
     
     return(json_data_obj);    
 }
-#pragma endregion "callback implementations related to the reading update setting message"
\ No newline at end of file
+#pragma endregion "callback implementations related to the reading update setting message"
+
+#pragma region "callback implementations related to the ArbData setting"
+/**
+ * @brief callback to handle incoming setting message for the ArbData setting
+ * 
+ * The LSCP library will invoke this callback when the android board has sent down a chunk of a user ARB waveform.
+ * A whole waveform is ARB_WAVEFORM_POINTS points, which is far too big for one LSCP packet, so it's sent in
+ * chunks of up to ARB_DATA_MAX_POINTS_PER_CHUNK points, in order, starting at point 0. The data field is:
+ * {"FirstPoint": n, "Points": [p0, p1, ...]} where each point is an integer from -32767 to 32767 representing -1 to +1
+ * of the amplitude setting. Integers keep the chunks compact compared to floats.
+ * 
+ * @param arb_data_object data field of LSCP ArbData setting message, encoded as a cJSON data struct
+ * 
+ * @return void
+ */
+void local_setting_msg_cb_arb_data(cJSON *arb_data_object)
+{
+    uint32_t counter = 0;
+    int32_t dirty_point;
+    int32_t dirty_first_point;
+    int16_t dirty_points[ARB_DATA_MAX_POINTS_PER_CHUNK];
+    cJSON *points_array;
+    cJSON *point_object;
+    
+    dirty_first_point = cJSON_GetObjectItem(arb_data_object, "FirstPoint")->valueint;
+    points_array = cJSON_GetObjectItem(arb_data_object, "Points");
+    
+    if((dirty_first_point >= 0) && (points_array != NULL) && (cJSON_GetArraySize(points_array) <= ARB_DATA_MAX_POINTS_PER_CHUNK))
+    {
+        //walk the array rather than cJSON_GetArrayItem(), which starts from the head every call
+        for(point_object = points_array->child; point_object != NULL; point_object = point_object->next)
+        {
+            dirty_point = point_object->valueint;
+            
+            if(dirty_point > INT16_MAX)
+            {
+                dirty_point = INT16_MAX;
+            }
+            else if(dirty_point < -INT16_MAX)
+            {
+                dirty_point = -INT16_MAX;
+            }
+            
+            dirty_points[counter++] = (int16_t)dirty_point;
+        }
+        
+        if(validate_ARB_data_setting((uint32_t)dirty_first_point, counter))
+        {
+            set_ARB_data_setting((uint32_t)dirty_first_point, dirty_points, counter, DO_NOT_NOTIFY_ANDROID_OF_SETTING_CHANGE);	//LSCP library will take care of the response
+        }
+    }
+}
+
+/**
+ * @brief callback to generate data field for an outgoing LSCP ArbData setting message
+ * 
+ * The LSCP library will invoke this callback when the application needs to generate a setting response message to the android board,
+ * per its request, in response to an ArbData chunk the android board just sent down. Rather than echo the points back, the response
+ * reports upload progress: {"PointsLoaded": n, "TotalPoints": ARB_WAVEFORM_POINTS}. PointsLoaded is also the FirstPoint the next chunk must use.
+ * 
+ * @param none
+ * 
+ * @return cJSON* a dynamically allocated cJSON struct containing the LSCP ArbData setting message data field
+ */
+cJSON* generate_data_field_for_arb_data_setting_msg_cb(void)
+{
+	cJSON *LSCP_data_field;
+	
+	LSCP_data_field = cJSON_CreateObject();
+	cJSON_AddNumberToObject(LSCP_data_field, "PointsLoaded", get_ARB_data_points_loaded());
+	cJSON_AddNumberToObject(LSCP_data_field, "TotalPoints", ARB_WAVEFORM_POINTS);
+	
+	return(LSCP_data_field);
+}
+#pragma endregion "callback implementations related to the ArbData setting"
@@ -5,7 +5,7 @@
  *  Author: Adam.Porsch
  */ 
 
- #include "hal.h"
+ #include "HAL.h"
 
 void jump_into_bootloader_mode(void)
 {